@@ -0,0 +1,239 @@
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "agent.h"
+#include "utils.h"
+
+#define LOST() do { _err(name, "lost connection to agent"); goto error; } while (0)
+
+static int send_all(int fd, const uint8_t *buf, size_t size)
+{
+    while (size > 0) {
+        // a client gone away is an error, not a SIGPIPE
+        ssize_t n = send(fd, buf, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return -1;
+        buf  += n;
+        size -= (size_t) n;
+    }
+    return 0;
+}
+
+// 1 if the stream ended before the first byte
+static int recv_all(int fd, uint8_t *buf, size_t size)
+{
+    size_t got = 0;
+    while (got < size) {
+        ssize_t n = recv(fd, buf + got, size - got, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n == 0 && got == 0)
+            return 1;
+        if (n <= 0)
+            return -1;
+        got += (size_t) n;
+    }
+    return 0;
+}
+
+int ag_send(int fd, uint8_t type, const uint8_t *buf, size_t size)
+{
+    uint8_t head[5] = {
+        type,
+        (size)       & 0xFF,
+        (size >>  8) & 0xFF,
+        (size >> 16) & 0xFF,
+        (size >> 24) & 0xFF,
+    };
+    if (size > AG_FRAME_MAX || send_all(fd, head, 5) != 0)
+        return -1;
+    return size == 0 ? 0 : send_all(fd, buf, size);
+}
+
+int ag_send_data(int fd, const uint8_t *buf, size_t size)
+{
+    while (size > 0) {
+        size_t n = size < AG_FRAME_MAX ? size : AG_FRAME_MAX;
+        if (ag_send(fd, AG_DATA, buf, n) != 0)
+            return -1;
+        buf  += n;
+        size -= n;
+    }
+    return 0;
+}
+
+int ag_recv(int fd, uint8_t *type, uint8_t *buf, size_t *size)
+{
+    uint8_t head[5];
+    int rv = recv_all(fd, head, 5);
+    if (rv != 0)
+        return rv;
+    *type = head[0];
+    *size = (size_t) head[1]
+          | (size_t) head[2] <<  8
+          | (size_t) head[3] << 16
+          | (size_t) head[4] << 24;
+    if (*size > AG_FRAME_MAX)
+        return -1;
+    return recv_all(fd, buf, *size) < 0 ? -1 : 0;
+}
+
+static int ag_socket(const char *path, struct sockaddr_un *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    strcpy(addr->sun_path, path);
+    return socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+int ag_connect(const char *path)
+{
+    struct sockaddr_un addr;
+    int fd = ag_socket(path, &addr);
+    if (fd < 0)
+        return -1;
+    if (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Only the owner may talk to the agent.  A socket left at path is
+// replaced, anything else there is an error.
+int ag_listen(const char *path)
+{
+    struct sockaddr_un addr;
+    struct stat st;
+    int fd = ag_socket(path, &addr);
+    if (fd < 0)
+        return -1;
+    if (lstat(path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            close(fd);
+            errno = EEXIST;
+            return -1;
+        }
+        unlink(path);
+    }
+    mode_t mask = umask(077);
+    errno = 0;
+    int err = bind(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0
+           || listen(fd, 64) != 0;
+    umask(mask);
+    if (err) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+struct pump {
+    pthread_t thread;
+    int       fd;
+    FILE     *in;
+    int       err;
+};
+
+// Streams the input while the agent's answer is read on the caller's
+// thread, so that neither side waits on a full socket buffer.
+static void *pump_input(void *arg)
+{
+    struct pump *p = arg;
+    struct input in;
+    const uint8_t *data;
+    size_t n;
+    p->err = in_open(&in, p->in);
+    while (p->err == 0) {
+        p->err = in_next(&in, &data, &n, AG_FRAME_MAX) != 0
+              || ag_send(p->fd, AG_DATA, data, n) != 0;
+        // n is not set when in_next() fails
+        if (p->err || n == 0)
+            break;
+    }
+    // the agent drops a request cut short
+    if (p->err)
+        shutdown(p->fd, SHUT_WR);
+    in_close(&in);
+    return NULL;
+}
+
+int ag_call(const char *name, const char *path,
+            uint8_t op, const uint8_t *param, size_t param_size,
+            FILE *in, FILE *out,
+            uint8_t *result, size_t *result_size)
+{
+    int rv = 1;
+    uint8_t type;
+    size_t size;
+    int has_pump = 0;
+    struct pump pump;
+    uint8_t *buf = malloc(AG_FRAME_MAX + 1);
+    int fd = ag_connect(path);
+    if (buf == NULL || fd < 0) {
+        _err(name, "cannot reach agent at '%s'", path);
+        goto error;
+    }
+    if (ag_send(fd, op, param, param_size) != 0)
+        LOST();
+
+    pump.fd = fd;
+    pump.in = in;
+    if (pthread_create(&pump.thread, NULL, pump_input, &pump) != 0)
+        goto error;
+    has_pump = 1;
+
+    while (1) {
+        if (ag_recv(fd, &type, buf, &size) != 0)
+            LOST();
+        if (type == AG_DATA) {
+            if (out != NULL && fwrite(buf, 1, size, out) != size) {
+                _err(name, "cannot write to output stream");
+                goto error;
+            }
+            continue;
+        }
+        if (type == AG_OK) {
+            if (result != NULL) {
+                if (size > *result_size)
+                    LOST();
+                memcpy(result, buf, size);
+                *result_size = size;
+            }
+            rv = 0;
+        } else if (type == AG_FAIL) {
+            buf[size] = '\0';
+            errno = 0;
+            _err(name, "agent: %s", (char *) buf);
+        } else {
+            LOST();
+        }
+        break;
+    }
+
+error:
+    if (fd >= 0) {
+        // unblocks the pump if the agent went away
+        shutdown(fd, SHUT_RDWR);
+    }
+    if (has_pump) {
+        pthread_join(pump.thread, NULL);
+        if (pump.err && rv == 0) {
+            _err(name, "cannot read input");
+            rv = 1;
+        }
+    }
+    if (fd >= 0) close(fd);
+    free(buf);
+    return rv;
+}
@@ -0,0 +1,52 @@
+#ifndef KURV_AGENT
+#define KURV_AGENT
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Framing between ichi-agent and its clients, over a Unix socket.
+//
+// Every frame is type (1) || size (4, little endian) || size bytes,
+// with size <= AG_FRAME_MAX.  A request is an op frame, then its input
+// as AG_DATA frames, ended by an empty one.  The agent answers with
+// AG_DATA frames as it goes, and a final AG_OK (with the op's result)
+// or AG_FAIL (with a message).  The agent reads the whole input before
+// it answers AG_FAIL, and then serves the next request on the same
+// connection.
+//
+//   op         op payload      AG_OK payload
+//   AG_SIGN    -               signature (64) || public key (32)
+//   AG_VERIFY  signature (64)  -
+//   AG_LOCK    -               -   (lock stream sent as AG_DATA)
+//   AG_UNLOCK  -               -   (plaintext sent as AG_DATA)
+#define AG_FRAME_MAX (64 * 1024)
+
+#define AG_SIGN   'S'
+#define AG_VERIFY 'V'
+#define AG_LOCK   'E'
+#define AG_UNLOCK 'D'
+#define AG_DATA   'd'
+#define AG_OK     'k'
+#define AG_FAIL   'x'
+
+int ag_send(int fd, uint8_t type, const uint8_t *buf, size_t size);
+// Sends size bytes as many AG_DATA frames as needed
+int ag_send_data(int fd, const uint8_t *buf, size_t size);
+// Reads one frame into buf, which holds AG_FRAME_MAX bytes.
+// Returns 1 on a clean end of stream.
+int ag_recv(int fd, uint8_t *type, uint8_t *buf, size_t *size);
+
+int ag_connect(const char *path);
+int ag_listen(const char *path);
+
+// Runs one request on the agent at path: in is streamed to the agent,
+// and what it sends back to out (if not NULL).  result, if not NULL,
+// receives the AG_OK payload: *result_size is its capacity on the way
+// in, the payload size on the way out.  Returns 0 on AG_OK; failures
+// are reported on stderr under name.
+int ag_call(const char *name, const char *path,
+            uint8_t op, const uint8_t *param, size_t param_size,
+            FILE *in, FILE *out,
+            uint8_t *result, size_t *result_size);
+#endif
@@ -3,8 +3,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <getopt.h>
 #include "monocypher/monocypher.h"
 #include "base64/base64.h"
+#include "stats.h"
 #include "utils.h"
 
 #define ERR(...)       _err("b64", __VA_ARGS__)
@@ -20,6 +22,8 @@ static const char* HELP =
     "  -e         encode (default) stdin\n"
     "  -w LENGTH  set line wrap length (>=0, default: 76)\n"
     "  -d         decode stdin\n"
+    "  --stats    print time and counters to stderr, as JSON\n"
+    "             (also with $ICHI_STATS=1)\n"
     ;
 
 int encode(FILE* fp, size_t wrap);
@@ -64,11 +68,11 @@ uint8_t *unwraplines(uint8_t *head, const uint8_t *buf, size_t bufsize)
 int encode(FILE* fp, size_t wrap)
 {
     int rv = 1;
-    size_t bufsize = 1024,
+    size_t bufsize = 64 * 1024,
            encsize = b64_encode_update_size(bufsize);
-    uint8_t *buf = malloc(1024),
-            *enc = malloc(encsize);
-    if (buf == NULL || enc == NULL)
+    uint8_t *enc = malloc(encsize);
+    struct input in = { .map = NULL, .buf = NULL };
+    if (enc == NULL || in_open(&in, fp) != 0)
         XERR("malloc");
 
     size_t so_far = 0; // state for wraplines
@@ -76,13 +80,14 @@ int encode(FILE* fp, size_t wrap)
     b64_encode_init(&ctx);
 
     for (;;) {
-        size_t n = fread(buf, 1, bufsize, fp);
-        if (ferror(fp))
+        const uint8_t *buf;
+        size_t n;
+        if (in_next(&in, &buf, &n, bufsize) != 0)
             XERR("fread");
         size_t m = b64_encode_update(&ctx, enc, buf, n);
         if (wraplines(&so_far, wrap, enc, m, 0) != 0)
             XERR("fwrite");
-        if (feof(fp)) {
+        if (n == 0) {
             m = b64_encode_final(&ctx, enc);
             if (wraplines(&so_far, wrap, enc, m, 1) != 0)
                 XERR("fwrite");
@@ -93,7 +98,7 @@ int encode(FILE* fp, size_t wrap)
     rv = 0;
 error:
     WIPE_CTX(&ctx);
-    _free(buf, bufsize);
+    in_close(&in);
     _free(enc, encsize);
     return rv;
 }
@@ -101,33 +106,39 @@ error:
 int decode(FILE* fp)
 {
     int rv = 1;
-    size_t bufsize = 1024,
+    size_t bufsize = 64 * 1024,
            decsize = b64_decode_update_size(bufsize);
-    uint8_t *buf = malloc(1024),
+    uint8_t *buf = malloc(bufsize),
             *dec = malloc(decsize);
-    if (buf == NULL || dec == NULL)
+    struct input in = { .map = NULL, .buf = NULL };
+    if (buf == NULL || dec == NULL || in_open(&in, fp) != 0)
         XERR("malloc");
 
     b64_decode_ctx ctx;
     b64_decode_init(&ctx);
 
+    // copied out of the input, line breaks are dropped in place
     for (;;) {
-        size_t n = fread(buf, 1, bufsize, fp);
-        if (ferror(fp))
+        size_t n;
+        if (in_read(&in, buf, &n, bufsize) != 0)
             XERR("fread");
 
+        // drop the line breaks, then decode the whole buffer at once
         uint8_t *head = buf;
         uint8_t *tail;
+        size_t m = 0;
         while ((tail = unwraplines(head, buf, n)) != NULL) {
-            size_t m = b64_decode_update(&ctx, dec, head, tail - head);
-            if (b64_decode_err(&ctx))
-                XERR("invalid base64");
-            if (_write(stdout, dec, m) != 0)
-                XERR("fwrite");
+            memmove(buf + m, head, tail - head);
+            m += tail - head;
             head = tail + 1;
         }
+        m = b64_decode_update(&ctx, dec, buf, m);
+        if (b64_decode_err(&ctx))
+            XERR("invalid base64");
+        if (_write(stdout, dec, m) != 0)
+            XERR("fwrite");
 
-        if (feof(fp)) {
+        if (n < bufsize) {
             b64_decode_final(&ctx);
             if (b64_decode_err(&ctx))
                 XERR("invalid base64");
@@ -138,6 +149,7 @@ int decode(FILE* fp)
     rv = 0;
 error:
     WIPE_CTX(&ctx);
+    in_close(&in);
     _free(buf, bufsize);
     _free(dec, decsize);
     return rv;
@@ -150,7 +162,12 @@ int main(int argc, char **argv)
     int rv = 1;
     int c;
     char action = 'e';
-    while ((c = getopt(argc, argv, "hedw:")) != -1)
+    static const struct option long_options[] = {
+        { "stats", no_argument, NULL, 'S' },
+        { NULL,    0,           NULL, 0   },
+    };
+    st_enable_from_env();
+    while ((c = getopt_long(argc, argv, "hedw:", long_options, NULL)) != -1)
         switch (c) {
             default:
                 XERR("invalid usage: see b64 -h");
@@ -166,11 +183,16 @@ int main(int argc, char **argv)
                 break;
             case 'e': action = 'e'; break;
             case 'd': action = 'd'; break;
+            case 'S': st_enable(); break;
         }
+    struct st_timer t;
+    st_start(ST_STREAM, &t);
     switch (action) {
         case 'e': rv = encode(stdin, wrap); break;
         case 'd': rv = decode(stdin); break;
     }
+    st_stop(ST_STREAM, &t);
 error:
+    st_report(stderr, "b64");
     return rv;
 }
@@ -13,6 +13,261 @@ static const int b64invs[] = { 62, -1, -1, -1, 63, 52, 53, 54, 55, 56, 57, 58,
     29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42,
     43, 44, 45, 46, 47, 48, 49, 50, 51 };
 
+// SIMD kernels
+// ------------
+// Bulk encoders consume whole triplets, and bulk decoders whole quads
+// of alphabet characters.  Decoders validate as they go, and stop at
+// the first quad containing anything else (including padding), which
+// is then left to the scalar code.  Define B64_NO_SIMD to disable.
+#if !defined(B64_NO_SIMD) && defined(__GNUC__) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define B64_X86
+#include <immintrin.h>
+
+// 12 bytes -> 16 characters, per 128-bit lane (Muła's method)
+__attribute__((target("sse4.1"))) static inline
+__m128i b64_enc_sse(__m128i in)
+{
+    const __m128i shuf = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4,
+                                       7, 6, 8, 7, 10, 9, 11, 10);
+    const __m128i lut  = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4,
+                                       -4, -4, -4, -4, -19, -16, 0, 0);
+    // spread 3 bytes over 4, then move each 6-bit group in place
+    in = _mm_shuffle_epi8(in, shuf);
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)),
+                                 _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)),
+                                 _mm_set1_epi32(0x01000010));
+    __m128i v  = _mm_or_si128(t0, t1);
+    // 0..25 -> 'A', 26..51 -> 'a', 52..61 -> '0', 62 -> '+', 63 -> '/'
+    __m128i idx = _mm_subs_epu8(v, _mm_set1_epi8(51));
+    idx = _mm_sub_epi8(idx, _mm_cmpgt_epi8(v, _mm_set1_epi8(25)));
+    return _mm_add_epi8(v, _mm_shuffle_epi8(lut, idx));
+}
+
+__attribute__((target("avx2"))) static inline
+__m256i b64_enc_avx2(__m256i in)
+{
+    const __m256i shuf = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i lut  = _mm256_setr_epi8(
+        65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+        65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    in = _mm256_shuffle_epi8(in, shuf);
+    __m256i t0 = _mm256_mulhi_epu16(
+        _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)),
+        _mm256_set1_epi32(0x04000040));
+    __m256i t1 = _mm256_mullo_epi16(
+        _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)),
+        _mm256_set1_epi32(0x01000010));
+    __m256i v  = _mm256_or_si256(t0, t1);
+    __m256i idx = _mm256_subs_epu8(v, _mm256_set1_epi8(51));
+    idx = _mm256_sub_epi8(idx, _mm256_cmpgt_epi8(v, _mm256_set1_epi8(25)));
+    return _mm256_add_epi8(v, _mm256_shuffle_epi8(lut, idx));
+}
+
+__attribute__((target("avx2")))
+static size_t b64_encode_avx2(uint8_t *out, const uint8_t *in, size_t n)
+{
+    size_t i = 0, j = 0;
+    for (; n - i >= 28; i += 24, j += 32) {
+        __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(in + i))),
+            _mm_loadu_si128((const __m128i*)(in + i + 12)), 1);
+        _mm256_storeu_si256((__m256i*)(out + j), b64_enc_avx2(v));
+    }
+    return i;
+}
+
+__attribute__((target("sse4.1")))
+static size_t b64_encode_sse(uint8_t *out, const uint8_t *in, size_t n)
+{
+    size_t i = 0, j = 0;
+    for (; n - i >= 16; i += 12, j += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        _mm_storeu_si128((__m128i*)(out + j), b64_enc_sse(v));
+    }
+    return i;
+}
+
+// Validation and translation tables (Muła & Lemire): a character is in
+// the alphabet iff its low and high nibble classes do not intersect.
+#define B64_DEC_LUTS()                                                      \
+    const __m128i lut_lo_ = _mm_setr_epi8(                                  \
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,                     \
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);                    \
+    const __m128i lut_hi_ = _mm_setr_epi8(                                  \
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,                     \
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);                    \
+    const __m128i lut_roll_ = _mm_setr_epi8(                                \
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);          \
+    (void)lut_lo_; (void)lut_hi_; (void)lut_roll_
+
+__attribute__((target("sse4.1")))
+static size_t b64_decode_sse(uint8_t *out, const uint8_t *in, size_t n)
+{
+    B64_DEC_LUTS();
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i slash  = _mm_set1_epi8('/');
+    size_t i = 0, j = 0;
+    for (; n - i >= 24; i += 16, j += 12) {
+        __m128i str = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), nibble);
+        __m128i lo_nibbles = _mm_and_si128(str, nibble);
+        __m128i hi = _mm_shuffle_epi8(lut_hi_, hi_nibbles);
+        __m128i lo = _mm_shuffle_epi8(lut_lo_, lo_nibbles);
+        if (!_mm_testz_si128(lo, hi))
+            break;
+        __m128i roll = _mm_shuffle_epi8(lut_roll_,
+            _mm_add_epi8(_mm_cmpeq_epi8(str, slash), hi_nibbles));
+        str = _mm_add_epi8(str, roll);
+        // pack 4 x 6 bits into 3 bytes
+        str = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+        str = _mm_madd_epi16(str, _mm_set1_epi32(0x00011000));
+        str = _mm_shuffle_epi8(str, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9,
+                                                  8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128((__m128i*)(out + j), str); // 4 bytes too many
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t b64_decode_avx2(uint8_t *out, const uint8_t *in, size_t n)
+{
+    B64_DEC_LUTS();
+    const __m256i lut_lo   = _mm256_broadcastsi128_si256(lut_lo_);
+    const __m256i lut_hi   = _mm256_broadcastsi128_si256(lut_hi_);
+    const __m256i lut_roll = _mm256_broadcastsi128_si256(lut_roll_);
+    const __m256i nibble   = _mm256_set1_epi8(0x0f);
+    const __m256i slash    = _mm256_set1_epi8('/');
+    const __m256i pack     = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i lanes    = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+    size_t i = 0, j = 0;
+    for (; n - i >= 48; i += 32, j += 24) {
+        __m256i str = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), nibble);
+        __m256i lo_nibbles = _mm256_and_si256(str, nibble);
+        __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+        if (!_mm256_testz_si256(lo, hi))
+            break;
+        __m256i roll = _mm256_shuffle_epi8(lut_roll,
+            _mm256_add_epi8(_mm256_cmpeq_epi8(str, slash), hi_nibbles));
+        str = _mm256_add_epi8(str, roll);
+        str = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+        str = _mm256_madd_epi16(str, _mm256_set1_epi32(0x00011000));
+        str = _mm256_shuffle_epi8(str, pack);
+        str = _mm256_permutevar8x32_epi32(str, lanes);
+        _mm256_storeu_si256((__m256i*)(out + j), str); // 8 bytes too many
+    }
+    return i;
+}
+
+#elif !defined(B64_NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+#define B64_NEON
+#include <arm_neon.h>
+
+static size_t b64_encode_neon(uint8_t *out, const uint8_t *in, size_t n)
+{
+    const uint8x16x4_t lut = vld1q_u8_x4(b64chars);
+    const uint8x16_t   m6  = vdupq_n_u8(0x3f);
+    size_t i = 0, j = 0;
+    for (; n - i >= 48; i += 48, j += 64) {
+        uint8x16x3_t s = vld3q_u8(in + i);
+        uint8x16x4_t d;
+        d.val[0] = vshrq_n_u8(s.val[0], 2);
+        d.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(s.val[0], 4),
+                                     vshrq_n_u8(s.val[1], 4)), m6);
+        d.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(s.val[1], 2),
+                                     vshrq_n_u8(s.val[2], 6)), m6);
+        d.val[3] = vandq_u8(s.val[2], m6);
+        d.val[0] = vqtbl4q_u8(lut, d.val[0]);
+        d.val[1] = vqtbl4q_u8(lut, d.val[1]);
+        d.val[2] = vqtbl4q_u8(lut, d.val[2]);
+        d.val[3] = vqtbl4q_u8(lut, d.val[3]);
+        vst4q_u8(out + j, d);
+    }
+    return i;
+}
+
+// ASCII -> 6-bit value, 0xff if not in the alphabet
+static const uint8_t b64_neon_invs[128] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+     52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+    255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+    255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+     41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+};
+
+static size_t b64_decode_neon(uint8_t *out, const uint8_t *in, size_t n)
+{
+    const uint8x16x4_t lo = vld1q_u8_x4(b64_neon_invs);
+    const uint8x16x4_t hi = vld1q_u8_x4(b64_neon_invs + 64);
+    const uint8x16_t   k64 = vdupq_n_u8(64);
+    size_t i = 0, j = 0;
+    for (; n - i >= 64; i += 64, j += 48) {
+        uint8x16x4_t s = vld4q_u8(in + i);
+        uint8x16_t   bad = vdupq_n_u8(0);
+        for (int k = 0; k < 4; k++) {
+            uint8x16_t c = s.val[k];
+            uint8x16_t v = vqtbx4q_u8(vqtbl4q_u8(lo, c), hi, vsubq_u8(c, k64));
+            // bytes >= 128 read as 0 from both tables, catch them here
+            bad = vorrq_u8(bad, vorrq_u8(v, vandq_u8(c, vdupq_n_u8(0x80))));
+            s.val[k] = v;
+        }
+        if (vmaxvq_u8(vandq_u8(bad, vdupq_n_u8(0xc0))) != 0)
+            break;
+        uint8x16x3_t d;
+        d.val[0] = vorrq_u8(vshlq_n_u8(s.val[0], 2), vshrq_n_u8(s.val[1], 4));
+        d.val[1] = vorrq_u8(vshlq_n_u8(s.val[1], 4), vshrq_n_u8(s.val[2], 2));
+        d.val[2] = vorrq_u8(vshlq_n_u8(s.val[2], 6), s.val[3]);
+        vst3q_u8(out + j, d);
+    }
+    return i;
+}
+#endif
+
+// Returns the number of input bytes encoded (a multiple of 3).
+static size_t b64_encode_bulk(uint8_t *out, const uint8_t *in, size_t n)
+{
+    size_t i = 0;
+#if defined(B64_X86)
+    if (n >= 28 && __builtin_cpu_supports("avx2"))
+        i += b64_encode_avx2(out, in, n);
+    if (n - i >= 16 && __builtin_cpu_supports("sse4.1"))
+        i += b64_encode_sse(out + i / 3 * 4, in + i, n - i);
+#elif defined(B64_NEON)
+    i += b64_encode_neon(out, in, n);
+#else
+    (void)out; (void)in; (void)n;
+#endif
+    return i;
+}
+
+// Returns the number of characters decoded (a multiple of 4).  May write
+// up to 8 bytes past the decoded data, but not beyond n / 4 * 3 - 2.
+static size_t b64_decode_bulk(uint8_t *out, const uint8_t *in, size_t n)
+{
+    size_t i = 0;
+#if defined(B64_X86)
+    if (n >= 48 && __builtin_cpu_supports("avx2"))
+        i += b64_decode_avx2(out, in, n);
+    if (n - i >= 24 && __builtin_cpu_supports("sse4.1"))
+        i += b64_decode_sse(out + i / 4 * 3, in + i, n - i);
+#elif defined(B64_NEON)
+    i += b64_decode_neon(out, in, n);
+#else
+    (void)out; (void)in; (void)n;
+#endif
+    return i;
+}
+
 
 size_t b64_encoded_size(size_t length) {
     size_t ret = length;
@@ -29,7 +284,8 @@ void b64_encode(uint8_t output[], const uint8_t input[], const size_t input_size
 {
     size_t v;
     size_t i, j;
-    for (i = 0, j = 0; i < input_size; i+=3, j+=4) {
+    i = b64_encode_bulk(output, input, input_size);
+    for (j = i / 3 * 4; i < input_size; i+=3, j+=4) {
         v = input[i];
         v = i + 1 < input_size ? v << 8 | input[i+1] : v << 8;
         v = i + 2 < input_size ? v << 8 | input[i+2] : v << 8;
@@ -84,7 +340,8 @@ int b64_validate(const uint8_t input[], const size_t input_size) {
 void b64_decode(uint8_t output[], const uint8_t input[], const size_t input_size) {
     size_t v;
     size_t i, j;
-    for (i=0, j=0; i < input_size; i+=4, j+=3) {
+    i = b64_decode_bulk(output, input, input_size);
+    for (j = i / 4 * 3; i < input_size; i+=4, j+=3) {
         v = b64invs[input[i]-43];
         v = (v << 6) | b64invs[input[i+1]-43];
         v = input[i+2] == '=' ? v << 6 : (v << 6) | b64invs[input[i+2]-43];
@@ -98,6 +355,18 @@ void b64_decode(uint8_t output[], const uint8_t input[], const size_t input_size
     }
 }
 
+int b64_decode_checked(uint8_t output[], const uint8_t input[], const size_t input_size)
+{
+    if (input_size % 4 != 0)
+        return -1;
+    // the bulk decoder validates what it decodes
+    size_t i = b64_decode_bulk(output, input, input_size);
+    if (b64_validate(input + i, input_size - i) != 0)
+        return -1;
+    b64_decode(output + i / 4 * 3, input + i, input_size - i);
+    return 0;
+}
+
 void b64_encode_init(b64_encode_ctx *ctx)
 {
     ctx->bufsize = 0;
@@ -124,8 +393,13 @@ size_t b64_encode_update(b64_encode_ctx *ctx,
         ctx->bufsize = 0;
         j += 4;
     }
-    for (; i + 3 < bufsize; i += 3, j += 4)
-        b64_encode(out + j, buf + i, 3);
+    // whole triplets, keeping the last 1-3 bytes buffered
+    if (i < bufsize) {
+        size_t n = (bufsize - i - 1) / 3 * 3;
+        b64_encode(out + j, buf + i, n);
+        i += n;
+        j += n / 3 * 4;
+    }
     for (; i < bufsize; i++, ctx->bufsize++)
         ctx->buf[ctx->bufsize] = buf[i];
     return j;
@@ -159,6 +433,13 @@ size_t b64_decode_update(b64_decode_ctx *ctx,
     size_t i = 0, // where in buf
            j = 0; // where in out
     while (i < bufsize && !ctx->eos && !ctx->err) {
+        if (ctx->bufsize == 0) {
+            size_t n = b64_decode_bulk(out + j, buf + i, bufsize - i);
+            i += n;
+            j += n / 4 * 3;
+            if (i == bufsize)
+                break;
+        }
         for (; (ctx->bufsize < 4) && (i < bufsize); i++, ctx->bufsize++)
             ctx->buf[ctx->bufsize] = buf[i];
         if (ctx->bufsize < 4)
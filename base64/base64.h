@@ -15,6 +15,9 @@ void b64_encode(uint8_t output[],
 
 void b64_decode(uint8_t output[],
                 const uint8_t input[], const size_t input_size);
+// b64_validate and b64_decode in a single pass. 0 on success
+int b64_decode_checked(uint8_t output[],
+                       const uint8_t input[], const size_t input_size);
 
 // Incremental interface
 typedef struct {
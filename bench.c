@@ -0,0 +1,611 @@
+// Throughput benchmarks, for `make bench`: one JSON object per line,
+//
+//   {"bench": NAME, "param": PARAM, "ops": N, "ns_op": T,
+//    "mb_s": R, "rss_kb": M}
+//
+// mb_s is null when a run has no natural byte count.  rss_kb is the
+// peak RSS of the bench so far, or of the child for end to end runs,
+// which spawn the tools in this directory on files under bench/.  The
+// first line describes the machine.
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "base64/base64.h"
+#include "lock_stream.h"
+#include "monocypher/monocypher.h"
+#include "utils.h"
+
+#define ERR(...)  _err("ichi_bench", __VA_ARGS__)
+#define XERR(...) do { ERR(__VA_ARGS__); goto error; } while (0)
+#define WORK_DIR  "bench"
+
+static const char *HELP =
+    "usage: ichi_bench [-t SECONDS] [FILTER]\n"
+    "\n"
+    "Runs the benchmarks whose name contains FILTER, each for at least\n"
+    "SECONDS (default: 0.5).\n";
+
+static double min_time = 0.5;
+
+static double now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double) t.tv_sec + (double) t.tv_nsec * 1e-9;
+}
+
+static long self_rss_kb(void)
+{
+    struct rusage ru;
+    return getrusage(RUSAGE_SELF, &ru) == 0 ? ru.ru_maxrss : -1;
+}
+
+static void report(const char *name, const char *param, size_t ops,
+                   double secs, size_t bytes, long rss_kb)
+{
+    printf("{\"bench\": \"%s\", \"param\": \"%s\", \"ops\": %zu, "
+           "\"ns_op\": %.0f, ", name, param, ops, secs * 1e9 / (double) ops);
+    if (bytes > 0)
+        printf("\"mb_s\": %.1f, ", (double) bytes * (double) ops / secs / 1e6);
+    else
+        printf("\"mb_s\": null, ");
+    printf("\"rss_kb\": %ld}\n", rss_kb);
+    fflush(stdout);
+}
+
+// Runs fn(arg) in growing batches until min_time has passed.
+// Returns the number of calls, and their time in *secs.
+typedef int (*bench_fn)(void *arg);
+
+static size_t measure(bench_fn fn, void *arg, double *secs)
+{
+    size_t ops = 0, batch = 1;
+    double start = now();
+    *secs = 0;
+    while (*secs < min_time) {
+        for (size_t i = 0; i < batch; i++)
+            if (fn(arg) != 0)
+                return 0;
+        ops   += batch;
+        *secs  = now() - start;
+        if (batch < 1 << 20)
+            batch *= 2;
+    }
+    return ops;
+}
+
+//
+// Primitives
+//
+#define PRIM_SIZE (64 * 1024)
+
+struct prim {
+    uint8_t key  [32];
+    uint8_t nonce[24];
+    uint8_t pk   [32];
+    uint8_t sk   [32];
+    uint8_t sig  [64];
+    uint8_t in   [PRIM_SIZE];
+    uint8_t out  [PRIM_SIZE * 4 / 3 + 4];
+};
+
+static int b_chacha20(void *arg)
+{
+    struct prim *p = arg;
+    crypto_xchacha20(p->out, p->in, PRIM_SIZE, p->key, p->nonce);
+    return 0;
+}
+
+static int b_poly1305(void *arg)
+{
+    struct prim *p = arg;
+    crypto_poly1305(p->out, p->in, PRIM_SIZE, p->key);
+    return 0;
+}
+
+static int b_blake2b(void *arg)
+{
+    struct prim *p = arg;
+    crypto_blake2b(p->out, p->in, PRIM_SIZE);
+    return 0;
+}
+
+static int b_x25519(void *arg)
+{
+    struct prim *p = arg;
+    crypto_x25519(p->out, p->sk, p->pk);
+    return 0;
+}
+
+static int b_x25519_public(void *arg)
+{
+    struct prim *p = arg;
+    crypto_x25519_public_key(p->out, p->sk);
+    return 0;
+}
+
+static int b_sign(void *arg)
+{
+    struct prim *p = arg;
+    crypto_sign(p->sig, p->sk, p->pk, p->in, 64);
+    return 0;
+}
+
+static int b_check(void *arg)
+{
+    struct prim *p = arg;
+    return crypto_check(p->sig, p->pk, p->in, 64);
+}
+
+static int b_b64_encode(void *arg)
+{
+    struct prim *p = arg;
+    b64_encode(p->out, p->in, PRIM_SIZE);
+    return 0;
+}
+
+static int b_b64_decode(void *arg)
+{
+    struct prim *p = arg;
+    return b64_decode_checked(p->in, p->out, b64_encoded_size(PRIM_SIZE));
+}
+
+struct argon {
+    struct ls_pdkf_params params;
+    uint8_t salt[32];
+    uint8_t key [32];
+};
+
+static int b_argon2i(void *arg)
+{
+    struct argon *a = arg;
+    return ls_pdkf_key(a->key, &a->params, a->salt, (const uint8_t *) "password", 8);
+}
+
+static int bench_primitives(const char *filter)
+{
+    struct prim *p = calloc(1, sizeof(*p));
+    if (p == NULL) {
+        ERR("malloc()");
+        return 1;
+    }
+    if (_random(p->in, PRIM_SIZE) != 0 || _random(p->sk, 32) != 0) {
+        free(p);
+        ERR("cannot get random bytes");
+        return 1;
+    }
+    crypto_x25519_public_key(p->pk, p->sk);
+    b_b64_encode(p);
+
+    static const struct {
+        const char *name;
+        bench_fn    fn;
+        size_t      bytes;
+        const char *param;
+    } prims[] = {
+        { "xchacha20",         b_chacha20,      PRIM_SIZE, "64KiB" },
+        { "poly1305",          b_poly1305,      PRIM_SIZE, "64KiB" },
+        { "blake2b",           b_blake2b,       PRIM_SIZE, "64KiB" },
+        { "base64_encode",     b_b64_encode,    PRIM_SIZE, "64KiB" },
+        { "base64_decode",     b_b64_decode,    PRIM_SIZE, "64KiB" },
+        { "x25519",            b_x25519,        0,         "-"     },
+        { "x25519_public_key", b_x25519_public, 0,         "-"     },
+        { "sign",              b_sign,          0,         "64B"   },
+        { "check",             b_check,         0,         "64B"   },
+    };
+    double secs;
+    for (size_t i = 0; i < sizeof(prims) / sizeof(prims[0]); i++) {
+        if (strstr(prims[i].name, filter) == NULL)
+            continue;
+        if (prims[i].fn == b_sign || prims[i].fn == b_check) {
+            crypto_sign_public_key(p->pk, p->sk);
+            crypto_sign(p->sig, p->sk, p->pk, p->in, 64);
+        }
+        size_t ops = measure(prims[i].fn, p, &secs);
+        if (ops == 0) {
+            free(p);
+            ERR("%s failed", prims[i].name);
+            return 1;
+        }
+        report(prims[i].name, prims[i].param, ops, secs, prims[i].bytes,
+               self_rss_kb());
+    }
+    free(p);
+
+    // same cost as ichi-lock -p
+    if (strstr("argon2i", filter) != NULL) {
+        struct argon a = {
+            .params = { .nb_blocks = 100000, .nb_iterations = 3,
+                        .nb_lanes = 4, .salt_size = 32 },
+        };
+        size_t ops = measure(b_argon2i, &a, &secs);
+        if (ops == 0) {
+            ERR("argon2i failed");
+            return 1;
+        }
+        report("argon2i", "100000x3x4", ops, secs, 0, self_rss_kb());
+    }
+    return 0;
+}
+
+//
+// Lock stream
+//
+struct chunk {
+    struct ls_fast_ctx fast;
+    uint8_t  key  [32];
+    uint8_t  nonce[24];
+    uint8_t *in;
+    uint8_t *out;
+    size_t   size;
+};
+
+static int b_lock(void *arg)
+{
+    struct chunk *c = arg;
+    uint8_t nonce[24];
+    memcpy(nonce, c->nonce, 24);
+    ls_lock(c->out, nonce, c->key, c->in, c->size);
+    return 0;
+}
+
+static int b_unlock(void *arg)
+{
+    struct chunk *c = arg;
+    uint8_t nonce[24];
+    memcpy(nonce, c->nonce, 24);
+    ls_increment_nonce(nonce);
+    return ls_unlock_payload(c->in, nonce, c->key, c->out + 18, c->size);
+}
+
+static int b_lock_at(void *arg)
+{
+    struct chunk *c = arg;
+    ls_lock_at(c->out, c->nonce, c->key, 7, c->in, c->size);
+    return 0;
+}
+
+static int b_unlock_at(void *arg)
+{
+    struct chunk *c = arg;
+    return ls_unlock_payload_at(c->in, c->nonce, c->key, 7, c->out + 20, c->size);
+}
+
+static int b_fast_lock(void *arg)
+{
+    struct chunk *c = arg;
+    ls_fast_lock(&c->fast, c->out, 7, c->in, c->size);
+    return 0;
+}
+
+static int b_fast_unlock(void *arg)
+{
+    struct chunk *c = arg;
+    return ls_fast_unlock(&c->fast, c->in, 7, c->out, c->size);
+}
+
+static int bench_lock_stream(const char *filter)
+{
+    static const struct {
+        const char *name;
+        bench_fn    lock;   // fills c->out for the matching unlock
+        bench_fn    fn;
+    } modes[] = {
+        { "ls_lock",              b_lock,      b_lock        },
+        { "ls_unlock_payload",    b_lock,      b_unlock      },
+        { "ls_lock_at",           b_lock_at,   b_lock_at     },
+        { "ls_unlock_payload_at", b_lock_at,   b_unlock_at   },
+        { "ls_fast_lock",         b_fast_lock, b_fast_lock   },
+        { "ls_fast_unlock",       b_fast_lock, b_fast_unlock },
+    };
+    static const size_t shifts[] = { 8, 12, 15, 18, 20, 24 };
+    struct chunk c;
+    size_t max = (size_t) 1 << LS_CHUNK_SHIFT_MAX;
+    c.in  = malloc(max);
+    c.out = malloc(max + 64);
+    int rv = 1;
+    if (c.in == NULL || c.out == NULL)
+        XERR("malloc()");
+    if (_random(c.in, max) != 0 || _random(c.key, 32) != 0
+            || _random(c.nonce, 24) != 0)
+        XERR("cannot get random bytes");
+    ls_fast_init(&c.fast, c.key, c.nonce);
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        if (strstr(modes[m].name, filter) == NULL)
+            continue;
+        for (size_t s = 0; s < sizeof(shifts) / sizeof(shifts[0]); s++) {
+            char param[32];
+            double secs;
+            c.size = (size_t) 1 << shifts[s];
+            // legacy chunks carry a 2-byte length
+            if (modes[m].lock == b_lock && c.size > 0xFFFF)
+                continue;
+            modes[m].lock(&c);
+            size_t ops = measure(modes[m].fn, &c, &secs);
+            if (ops == 0)
+                XERR("%s failed", modes[m].name);
+            snprintf(param, sizeof(param), "chunk=%zu", c.size);
+            report(modes[m].name, param, ops, secs, c.size, self_rss_kb());
+        }
+    }
+    rv = 0;
+
+error:
+    free(c.in);
+    free(c.out);
+    return rv;
+}
+
+//
+// End to end
+//
+// Runs argv with stdin and stdout redirected (if not NULL), and the
+// environment variable env set; *rss_kb is the peak RSS of the child.
+static int spawn(char *const argv[], const char *env,
+                 const char *in_fn, const char *out_fn, long *rss_kb)
+{
+    int status;
+    struct rusage ru;
+    pid_t pid = fork();
+    if (pid < 0)
+        return -1;
+    if (pid == 0) {
+        int in  = open(in_fn  ? in_fn  : "/dev/null", O_RDONLY);
+        int out = open(out_fn ? out_fn : "/dev/null", O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        int err = open("/dev/null", O_WRONLY);
+        if (in < 0 || out < 0 || err < 0
+                || dup2(in, 0) < 0 || dup2(out, 1) < 0 || dup2(err, 2) < 0
+                || (env != NULL && putenv((char *) env) != 0))
+            _exit(127);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    if (wait4(pid, &status, 0, &ru) != pid)
+        return -1;
+    if (ru.ru_maxrss > *rss_kb)
+        *rss_kb = ru.ru_maxrss;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : -1;
+}
+
+struct e2e {
+    char *const *argv;
+    const char  *env;
+    const char  *in_fn;
+    const char  *out_fn;
+    long         rss_kb;
+};
+
+static int b_spawn(void *arg)
+{
+    struct e2e *e = arg;
+    return spawn(e->argv, e->env, e->in_fn, e->out_fn, &e->rss_kb);
+}
+
+static int run_e2e(const char *name, const char *param, size_t bytes,
+                   struct e2e *e)
+{
+    double secs;
+    e->rss_kb = 0;
+    size_t ops = measure(b_spawn, e, &secs);
+    if (ops == 0) {
+        ERR("%s (%s) failed", name, param);
+        return 1;
+    }
+    report(name, param, ops, secs, bytes, e->rss_kb);
+    return 0;
+}
+
+static int keygen(const char *mode, const char *n, const char *base)
+{
+    long rss = 0;
+    char *argv[] = { "./ichi-keygen", (char *) mode, "-n", (char *) n,
+                     "-b", (char *) base, NULL };
+    if (spawn(argv, NULL, NULL, NULL, &rss) != 0) {
+        ERR("cannot run ichi-keygen");
+        return 1;
+    }
+    return 0;
+}
+
+#define E2E_SIZE       (16 * 1024 * 1024)
+#define RECIPIENTS_MAX 255
+
+// Existing directories are reused
+static void make_dir(const char *path)
+{
+    mkdir(path, 0700);
+    errno = 0;
+}
+
+static int write_input(const char *fn, size_t size)
+{
+    int rv = 1;
+    uint8_t buf[64 * 1024];
+    FILE *fp = fopen(fn, "w");
+    if (fp == NULL)
+        XERR("cannot write '%s'", fn);
+    for (size_t n; size > 0; size -= n) {
+        n = size < sizeof(buf) ? size : sizeof(buf);
+        if (_random(buf, n) != 0 || _write(fp, buf, n) != 0)
+            XERR("cannot write '%s'", fn);
+    }
+    if (_fclose(&fp) != 0)
+        XERR("cannot write '%s'", fn);
+    rv = 0;
+
+error:
+    if (fp != NULL) fclose(fp);
+    return rv;
+}
+
+// ichi-lock -E and -D of E2E_SIZE bytes, for n recipients; -D uses the
+// key of the last one, which is tried last.
+static int bench_lock_e2e(const char *filter)
+{
+    static const size_t counts[] = { 1, 16, 64, RECIPIENTS_MAX };
+    static char pk_fn[RECIPIENTS_MAX][64];
+    static char *argv[6 + 2 * RECIPIENTS_MAX];
+    char sk_fn[64], param[32];
+    int lock   = strstr("encrypt", filter) != NULL,
+        unlock = strstr("decrypt", filter) != NULL;
+    if (!lock && !unlock)
+        return 0;
+
+    make_dir(WORK_DIR "/lock");
+    if (keygen("-L", "255", WORK_DIR "/lock/r") != 0
+            || write_input(WORK_DIR "/lock/input", E2E_SIZE) != 0)
+        return 1;
+    for (size_t i = 0; i < RECIPIENTS_MAX; i++)
+        snprintf(pk_fn[i], sizeof(pk_fn[i]), WORK_DIR "/lock/r%03zu.lock.pub", i + 1);
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        size_t n = counts[c], argc = 0;
+        argv[argc++] = "./ichi-lock";
+        argv[argc++] = "-E";
+        argv[argc++] = "-o";
+        argv[argc++] = WORK_DIR "/lock/encrypted";
+        for (size_t i = 0; i < n; i++) {
+            argv[argc++] = "-r";
+            argv[argc++] = pk_fn[i];
+        }
+        argv[argc++] = WORK_DIR "/lock/input";
+        argv[argc]   = NULL;
+        struct e2e e = { .argv = argv };
+        snprintf(param, sizeof(param), "recipients=%zu", n);
+        // decryption needs the file either way
+        if (!lock && b_spawn(&e) != 0) {
+            ERR("cannot encrypt");
+            return 1;
+        }
+        if (lock && run_e2e("encrypt", param, E2E_SIZE, &e) != 0)
+            return 1;
+        if (!unlock)
+            continue;
+
+        snprintf(sk_fn, sizeof(sk_fn), WORK_DIR "/lock/r%03zu.lock.key", n);
+        char *dargv[] = { "./ichi-lock", "-D", "-k", sk_fn,
+                          WORK_DIR "/lock/encrypted", NULL };
+        struct e2e d = { .argv = dargv };
+        if (run_e2e("decrypt", param, E2E_SIZE, &d) != 0)
+            return 1;
+    }
+    return 0;
+}
+
+// ichi-sign -V against $ICHI_SIGN_KEYRING of n keys, as a directory
+// and as an index
+static int bench_keyring(const char *filter)
+{
+    static const size_t counts[] = { 1, 10, 100, 1000 };
+    char dir[64], base[80], sk_fn[96], n_arg[16], param[64];
+    static char env[128];
+    long rss = 0;
+    if (strstr("verify_keyring", filter) == NULL)
+        return 0;
+
+    make_dir(WORK_DIR "/keyring");
+    if (write_input(WORK_DIR "/keyring/input", 4096) != 0)
+        return 1;
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        size_t n = counts[c];
+        snprintf(dir,   sizeof(dir),   WORK_DIR "/keyring/%zu", n);
+        snprintf(base,  sizeof(base),  "%s/k", dir);
+        snprintf(n_arg, sizeof(n_arg), "%zu", n);
+        make_dir(dir);
+        if (keygen("-S", n_arg, base) != 0)
+            return 1;
+        // the last key signs
+        snprintf(sk_fn, sizeof(sk_fn), "%s/k%zu.sign.key", dir, n);
+        char *sargv[] = { "./ichi-sign", "-k", sk_fn,
+                          "-o", WORK_DIR "/keyring/signed",
+                          WORK_DIR "/keyring/input", NULL };
+        char *iargv[] = { "./ichi-sign", "-I", dir,
+                          "-o", WORK_DIR "/keyring/index", NULL };
+        if (spawn(sargv, NULL, NULL, NULL, &rss) != 0
+                || spawn(iargv, NULL, NULL, NULL, &rss) != 0) {
+            ERR("cannot sign");
+            return 1;
+        }
+
+        char *vargv[] = { "./ichi-sign", "-V", WORK_DIR "/keyring/signed", NULL };
+        struct e2e e = { .argv = vargv, .env = env };
+        snprintf(env, sizeof(env), "ICHI_SIGN_KEYRING=%s", dir);
+        snprintf(param, sizeof(param), "keys=%zu,dir", n);
+        if (run_e2e("verify_keyring", param, 0, &e) != 0)
+            return 1;
+        snprintf(env, sizeof(env), "ICHI_SIGN_KEYRING=" WORK_DIR "/keyring/index");
+        snprintf(param, sizeof(param), "keys=%zu,index", n);
+        if (run_e2e("verify_keyring", param, 0, &e) != 0)
+            return 1;
+    }
+    return 0;
+}
+
+static void machine_info(void)
+{
+    char line[256], model[256] = "unknown";
+    FILE *fp = fopen("/proc/cpuinfo", "r");
+    while (fp != NULL && fgets(line, sizeof(line), fp) != NULL) {
+        char *colon = strchr(line, ':');
+        if (strncmp(line, "model name", 10) == 0 && colon != NULL) {
+            snprintf(model, sizeof(model), "%s", colon + 2);
+            model[strcspn(model, "\n\"\\")] = '\0';
+            break;
+        }
+    }
+    if (fp != NULL) fclose(fp);
+    errno = 0;
+    printf("{\"bench\": \"machine\", \"cpu\": \"%s\", \"nproc\": %ld}\n",
+           model, sysconf(_SC_NPROCESSORS_ONLN));
+}
+
+int main(int argc, char **argv)
+{
+    int c;
+    char *end;
+    while ((c = getopt(argc, argv, "ht:")) != -1)
+        switch (c) {
+        default:
+            return 1;
+        case 'h':
+            printf("%s", HELP);
+            return 0;
+        case 't':
+            min_time = strtod(optarg, &end);
+            if (end == optarg || *end != '\0' || min_time < 0) {
+                ERR("invalid argument to -t");
+                return 1;
+            }
+            break;
+        }
+    const char *filter = optind < argc ? argv[optind] : "";
+
+    make_dir(WORK_DIR);
+    machine_info();
+    fflush(stdout);
+
+    // The tools spawned below inherit the peak RSS of this process
+    // (it survives fork and exec), so the in-process benches run in a
+    // child of their own.
+    int status;
+    pid_t pid = fork();
+    if (pid < 0) {
+        ERR("fork()");
+        return 1;
+    }
+    if (pid == 0)
+        _exit(bench_primitives(filter) || bench_lock_stream(filter));
+    if (waitpid(pid, &status, 0) != pid
+            || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return 1;
+    return bench_lock_e2e(filter)
+        || bench_keyring(filter);
+}
@@ -0,0 +1,451 @@
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#include "base64/base64.h"
+#include "monocypher/monocypher.h"
+#include "utils.h"
+#include "ichi.h"
+#include "agent.h"
+
+#define B64_KEY_SIZE 44
+#define SEE_USAGE    "invalid usage. see -h"
+
+static const char *HELP =
+    "usage:\n"
+    "  ichi-agent [-k KEY] [-v SENDER] [-r RECP]... [-S] [-t] [-f] [-c SHIFT]\n"
+    "             [-s SIGN_KEY] [-p SIGN_PUB] SOCKET\n"
+    "\n"
+    "Loads keys once and serves requests from `ichi-lock -A SOCKET`\n"
+    "and `ichi-sign -A SOCKET` on the Unix socket SOCKET.\n"
+    "\n"
+    "options:\n"
+    "  -k KEY      decrypt with secret key KEY.\n"
+    "  -v SENDER   only decrypt streams from SENDER.\n"
+    "  -r RECP     encrypt for recepient public key RECP, from a new key\n"
+    "              for every stream. can be repeated.\n"
+    "  -S          encrypt from KEY instead, so that recepients can check\n"
+    "              the sender with -v. the key wrapping nonce is fixed, so\n"
+    "              every stream reuses the keystream of its recepient slots:\n"
+    "              one leaked stream key lets slots be forged as from KEY.\n"
+    "  -t, -f, -c  as for `ichi-lock -E`.\n"
+    "  -s SIGN_KEY sign with secret key SIGN_KEY.\n"
+    "  -p SIGN_PUB verify signatures against public key SIGN_PUB.\n\n";
+
+#define WIPE_BUF(buf)    crypto_wipe((buf), sizeof(buf))
+#define WIPE_CTX(ctx)    crypto_wipe((ctx), sizeof(*(ctx)))
+#define ERR(...)         _err("ichi-agent", __VA_ARGS__)
+
+#define ENSURE(x, ...)   do { if (!(x)) { ERR(__VA_ARGS__); goto error; } } while (0)
+
+typedef uint8_t u8;
+
+// Everything loaded at startup, shared read only by the connections
+struct agent {
+    int              can_lock,
+                     can_unlock,
+                     can_sign,
+                     can_verify;
+    ichi_lock_ctx    lock;
+    ichi_unlock_ctx  unlock;
+    crypto_sign_ctx  sign;     // after the first pass init, see ichi-sign
+    u8               sign_pk  [32];
+    u8               verify_pk[32];
+};
+
+struct conn {
+    const struct agent *ag;
+    int                 fd;
+    u8                 *in;      // AG_FRAME_MAX
+    u8                 *out;
+    size_t              out_cap;
+    ichi_lock_ctx      *lock;    // cloned on first use
+    ichi_unlock_ctx    *unlock;
+};
+
+static int reserve(struct conn *c, size_t size)
+{
+    if (c->out_cap >= size)
+        return 0;
+    u8 *out = malloc(size);
+    if (out == NULL)
+        return -1;
+    _free(c->out, c->out_cap);
+    c->out     = out;
+    c->out_cap = size;
+    return 0;
+}
+
+// Next frame of a request's input: 1 at its end, -1 if the
+// connection broke.
+static int next_data(struct conn *c, size_t *size)
+{
+    u8 type;
+    if (ag_recv(c->fd, &type, c->in, size) != 0 || type != AG_DATA)
+        return -1;
+    return *size == 0 ? 1 : 0;
+}
+
+// Reads what is left of the request, then reports why it failed
+static int fail(struct conn *c, const char *msg)
+{
+    size_t size;
+    int rv;
+    while ((rv = next_data(c, &size)) == 0)
+        ;
+    if (rv < 0)
+        return -1;
+    return ag_send(c->fd, AG_FAIL, (const u8 *) msg, strlen(msg));
+}
+
+static int serve_lock(struct conn *c)
+{
+    const struct agent *ag = c->ag;
+    size_t size, n;
+    int rv;
+    if (!ag->can_lock)
+        return fail(c, "no recepients to encrypt for");
+    if (c->lock == NULL) {
+        c->lock = malloc(sizeof(*c->lock));
+        if (c->lock == NULL || ichi_lock_clone(c->lock, &ag->lock) != 0) {
+            free(c->lock);
+            c->lock = NULL;
+            return fail(c, "out of memory");
+        }
+    }
+    // the bounds allow for a chunk buffered across frames: a frame
+    // can complete a chunk of up to 2^24 bytes (-c)
+    if (reserve(c, ICHI_LOCK_HEADER_MAX
+                   + ichi_lock_update_size(c->lock, AG_FRAME_MAX)
+                   + ichi_lock_final_size(c->lock)) != 0)
+        return fail(c, "out of memory");
+
+    n = ichi_lock_init(c->lock, c->out);
+    if (ag_send_data(c->fd, c->out, n) != 0)
+        return -1;
+    while ((rv = next_data(c, &size)) == 0) {
+        n = ichi_lock_update(c->lock, c->out, c->in, size);
+        if (ag_send_data(c->fd, c->out, n) != 0)
+            return -1;
+    }
+    if (rv < 0)
+        return -1;
+    n = ichi_lock_final(c->lock, c->out);
+    if (ichi_lock_err(c->lock))
+        return ag_send(c->fd, AG_FAIL, (const u8 *) "cannot encrypt", 14);
+    if (ag_send_data(c->fd, c->out, n) != 0)
+        return -1;
+    return ag_send(c->fd, AG_OK, NULL, 0);
+}
+
+static int serve_unlock(struct conn *c)
+{
+    const struct agent *ag = c->ag;
+    size_t size, n;
+    int rv;
+    if (!ag->can_unlock)
+        return fail(c, "no key to decrypt with");
+    if (c->unlock == NULL) {
+        c->unlock = malloc(sizeof(*c->unlock));
+        if (c->unlock == NULL || ichi_unlock_clone(c->unlock, &ag->unlock) != 0) {
+            free(c->unlock);
+            c->unlock = NULL;
+            return fail(c, "out of memory");
+        }
+    }
+
+    ichi_unlock_init(c->unlock);
+    while ((rv = next_data(c, &size)) == 0) {
+        if (ichi_unlock_err(c->unlock))
+            continue; // drain the rest
+        if (reserve(c, ichi_unlock_update_size(c->unlock, size)) != 0)
+            return fail(c, "out of memory");
+        n = ichi_unlock_update(c->unlock, c->out, c->in, size);
+        if (ag_send_data(c->fd, c->out, n) != 0)
+            return -1;
+    }
+    if (rv < 0)
+        return -1;
+    if (ichi_unlock_final(c->unlock) != 0)
+        return ag_send(c->fd, AG_FAIL, (const u8 *) "cannot decrypt", 14);
+    return ag_send(c->fd, AG_OK, NULL, 0);
+}
+
+// EdDSA hashes the message twice: it is kept until the end
+static int serve_sign(struct conn *c)
+{
+    const struct agent *ag = c->ag;
+    size_t size, msg_size = 0, msg_cap = 0;
+    u8 *msg = NULL, result[64 + 32];
+    int rv;
+    if (!ag->can_sign)
+        return fail(c, "no key to sign with");
+
+    while ((rv = next_data(c, &size)) == 0) {
+        if (msg_size + size > msg_cap) {
+            size_t cap = msg_cap ? 2 * msg_cap : AG_FRAME_MAX;
+            while (cap < msg_size + size)
+                cap *= 2;
+            u8 *grown = realloc(msg, cap);
+            if (grown == NULL) {
+                free(msg);
+                return fail(c, "out of memory");
+            }
+            msg     = grown;
+            msg_cap = cap;
+        }
+        memcpy(msg + msg_size, c->in, size);
+        msg_size += size;
+    }
+    if (rv > 0) {
+        crypto_sign_ctx sctx = ag->sign;
+        crypto_sign_ctx_abstract *actx = (crypto_sign_ctx_abstract *) &sctx;
+        crypto_sign_update(actx, msg, msg_size);
+        crypto_sign_init_second_pass(actx);
+        crypto_sign_update(actx, msg, msg_size);
+        crypto_sign_final(actx, result);
+        memcpy(result + 64, ag->sign_pk, 32);
+        WIPE_CTX(&sctx);
+        rv = ag_send(c->fd, AG_OK, result, sizeof(result));
+    }
+    free(msg);
+    return rv;
+}
+
+static int serve_verify(struct conn *c, const u8 *sig, size_t sig_size)
+{
+    const struct agent *ag = c->ag;
+    crypto_check_ctx cctx;
+    crypto_check_ctx_abstract *actx = (crypto_check_ctx_abstract *) &cctx;
+    size_t size;
+    int rv;
+    if (!ag->can_verify)
+        return fail(c, "no public key to verify with");
+    if (sig_size != 64)
+        return fail(c, "malformed signature");
+
+    crypto_check_init(actx, sig, ag->verify_pk);
+    while ((rv = next_data(c, &size)) == 0)
+        crypto_check_update(actx, c->in, size);
+    if (rv < 0)
+        return -1;
+    if (crypto_check_final(actx) != 0)
+        return ag_send(c->fd, AG_FAIL, (const u8 *) "invalid signature", 17);
+    return ag_send(c->fd, AG_OK, NULL, 0);
+}
+
+static void *serve(void *arg)
+{
+    struct conn *c = arg;
+    u8 op, param[64];
+    size_t size;
+    c->in = malloc(AG_FRAME_MAX);
+
+    // one request after another, until the client hangs up
+    while (c->in != NULL && ag_recv(c->fd, &op, c->in, &size) == 0) {
+        int rv;
+        switch (op) {
+        case AG_LOCK:   rv = serve_lock(c);   break;
+        case AG_UNLOCK: rv = serve_unlock(c); break;
+        case AG_SIGN:   rv = serve_sign(c);   break;
+        case AG_VERIFY:
+            if (size > sizeof(param))
+                size = 0;
+            memcpy(param, c->in, size);
+            rv = serve_verify(c, param, size);
+            break;
+        default:
+            rv = -1;
+        }
+        if (rv != 0)
+            break;
+    }
+
+    close(c->fd);
+    free(c->in);
+    _free(c->out, c->out_cap);
+    if (c->lock != NULL) {
+        ichi_lock_free(c->lock);
+        free(c->lock);
+    }
+    if (c->unlock != NULL) {
+        ichi_unlock_free(c->unlock);
+        free(c->unlock);
+    }
+    free(c);
+    return NULL;
+}
+
+static const char *socket_path;
+
+static void on_exit_signal(int sig)
+{
+    (void) sig;
+    unlink(socket_path);
+    _exit(0);
+}
+
+static int read_key(char* fn, char* key_type, u8* key)
+{
+    int rv = 1;
+    u8 b64_buf[B64_KEY_SIZE];
+    FILE *fp = fopen(fn, "r");
+
+    ENSURE(fp != NULL, "cannot open %s key file '%s'", key_type, fn);
+    ENSURE(_read(fp, b64_buf, sizeof(b64_buf)) == 0,
+           "cannot read %s key '%s'", key_type, fn);
+    ENSURE(b64_decoded_size(b64_buf, sizeof(b64_buf)) == 32
+            && b64_decode_checked(key, b64_buf, sizeof(b64_buf)) == 0,
+           "invalid %s key '%s'", key_type, fn);
+    rv = 0;
+
+error:
+    if (fp != NULL) fclose(fp);
+    WIPE_BUF(b64_buf);
+    return rv;
+}
+
+int main(int argc, char** argv)
+{
+    int rv = 1;
+    int kflag = 0,
+        vflag = 0,
+        Sflag = 0,
+        tflag = 0;
+    u8 sk        [32],
+       sender    [32],
+       sign_sk   [32];
+    u8 (*recp)[32] = calloc(ICHI_RECEPIENTS_MAX, 32);
+    size_t nrecp = 0;
+    int fd = -1;
+    char *tmp;
+    struct ls_stream_params params = {
+        .version     = LS_VERSION_INDEXED,
+        .chunk_shift = LS_CHUNK_SHIFT_DEFAULT,
+    };
+    struct agent *ag = calloc(1, sizeof(*ag));
+    ENSURE(ag != NULL && recp != NULL, "malloc()");
+
+    int c;
+    while ((c = getopt(argc, argv, "hk:v:r:Stfc:s:p:")) != -1) {
+        switch (c) {
+        default: goto error;
+        case 'h':
+            printf("%s", HELP);
+            rv = 0;
+            goto error;
+        case 'k':
+            kflag = 1;
+            if (read_key(optarg, "secret", sk) != 0)
+                goto error;
+            break;
+        case 'v':
+            vflag = 1;
+            if (read_key(optarg, "public", sender) != 0)
+                goto error;
+            break;
+        case 'r':
+            ENSURE(nrecp < ICHI_RECEPIENTS_MAX,
+                   "cannot add more than 255 recepients");
+            if (read_key(optarg, "recepient", recp[nrecp]) != 0)
+                goto error;
+            nrecp++;
+            break;
+        case 's':
+            ag->can_sign = 1;
+            if (read_key(optarg, "signing", sign_sk) != 0)
+                goto error;
+            break;
+        case 'p':
+            ag->can_verify = 1;
+            if (read_key(optarg, "verifying", ag->verify_pk) != 0)
+                goto error;
+            break;
+        case 'c':
+            errno = 0;
+            params.chunk_shift = strtoul(optarg, &tmp, 10);
+            ENSURE(errno == 0 && tmp != optarg && *tmp == '\0'
+                    && ls_stream_verify(&params) == 0,
+                   "invalid argument to -c");
+            break;
+        case 'S': Sflag = 1; break;
+        case 't': tflag = 1; break;
+        case 'f': params.version = LS_VERSION_FAST; break;
+        }
+    }
+    ENSURE(argc == optind + 1, SEE_USAGE);
+    ENSURE(!Sflag || (kflag && nrecp > 0), "-S needs -k and -r");
+
+    if (nrecp > 0) {
+        ENSURE(ichi_lock_setup(&ag->lock, Sflag ? sk : NULL,
+                               recp, nrecp,
+                               tflag, &params) == 0,
+               "cannot set up encryption");
+        ag->can_lock = 1;
+    }
+    if (kflag) {
+        ENSURE(ichi_unlock_setup(&ag->unlock, sk, vflag ? sender : NULL) == 0,
+               "cannot set up decryption");
+        ag->can_unlock = 1;
+    }
+    if (ag->can_sign) {
+        crypto_sign_public_key(ag->sign_pk, sign_sk);
+        crypto_sign_init_first_pass((crypto_sign_ctx_abstract *) &ag->sign,
+                                    sign_sk, ag->sign_pk);
+    }
+    WIPE_BUF(sk);
+    WIPE_BUF(sign_sk);
+
+    fd = ag_listen(argv[optind]);
+    ENSURE(fd >= 0, "cannot listen on '%s'", argv[optind]);
+    socket_path = argv[optind];
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT,  on_exit_signal);
+    signal(SIGTERM, on_exit_signal);
+
+    while (1) {
+        int cfd = accept(fd, NULL, NULL);
+        if (cfd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                errno = 0;
+                continue;
+            }
+            ENSURE(0, "accept()");
+        }
+        pthread_t thread;
+        struct conn *conn = calloc(1, sizeof(*conn));
+        if (conn != NULL) {
+            conn->ag = ag;
+            conn->fd = cfd;
+        }
+        if (conn == NULL || pthread_create(&thread, NULL, serve, conn) != 0) {
+            ERR("cannot serve connection");
+            errno = 0;
+            close(cfd);
+            free(conn);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+
+error:
+    if (fd >= 0) {
+        close(fd);
+        unlink(argv[optind]);
+    }
+    WIPE_BUF(sk);
+    WIPE_BUF(sign_sk);
+    free(recp);
+    if (ag != NULL) {
+        if (ag->can_lock)   ichi_lock_free(&ag->lock);
+        if (ag->can_unlock) ichi_unlock_free(&ag->unlock);
+        WIPE_CTX(ag);
+        free(ag);
+    }
+    return rv;
+}
@@ -6,6 +6,7 @@
 #include "monocypher/monocypher.h"
 #include "base64/base64.h"
 #include "utils.h"
+#include "pipeline.h"
 
 
 #define B64_KEY_SIZE 44
@@ -14,23 +15,31 @@
 #define ERR(...)      _err("ichi-keygen", __VA_ARGS__)
 #define WIPE_BUF(buf) crypto_wipe(buf, sizeof(buf))
 #define MAX(a, b)     ((a) > (b) ? (a) : (b))
+#define BATCH_MAX     (1 << 24)
 
 static const char* HELP =
     "usage: ichi-keygen -h\n"
-    "       ichi-keygen {-S | -L} [-p PK] [-s SK] [-b BASE]\n\n"
+    "       ichi-keygen {-S | -L} [-p PK] [-s SK] [-b BASE]\n"
+    "       ichi-keygen {-S | -L} -n N [-j JOBS] {-b BASE | [-b BASE] -p PKS -s SKS}\n\n"
     "options:\n"
     "  -h       show help.\n"
     "  -S       generate a keypair for ichi-sign.\n"
     "  -L       generate a keypair for ichi-lock.\n"
     "  -p PK    specify public key file (default for -S: .sign.pub, -L: .lock.pub)\n"
     "  -s SK    specify secret key file (default for -S: .sign.key, -L: .lock.key)\n"
-    "  -b BASE  write public/secret keys in BASE.pub and BASE.key, respectively.\n\n";
+    "  -b BASE  write public/secret keys in BASE.pub and BASE.key, respectively.\n"
+    "  -n N     generate N keypairs, named BASE1 to BASEN (zero padded). They\n"
+    "           go to N pairs of files, or with -p and -s to two bundles of\n"
+    "           \"NAME KEY\" lines; ichi-sign -I PKS indexes a public bundle.\n"
+    "  -j JOBS  generate keys on JOBS threads (default: 1).\n\n";
 
 
 static int keygen_lock(uint8_t pk[32], uint8_t sk[32]);
 static int keygen_sign(uint8_t pk[32], uint8_t sk[32]);
 static int write_key(uint8_t pk[32],  uint8_t sk[32],
                      char* pk_fn,     char* sk_fn);
+static int keygen_batch(int mode, size_t n, size_t jobs, const char* base,
+                        const char* pk_fn, const char* sk_fn);
 
 
 int keygen_lock(uint8_t pk[32], uint8_t sk[32])
@@ -86,6 +95,115 @@ error:
 }
 
 
+// Keypairs of a -n run: the secret keys come from one _random() call,
+// the public keys (and the file pairs, without bundles) from the workers.
+struct batch {
+    int         mode;
+    size_t      size;
+    int         width;
+    const char* base;
+    int         files;
+    uint8_t   (*pk)[32];
+    uint8_t   (*sk)[32];
+};
+
+static int batch_name(const struct batch* b, size_t i,
+                      char* buf, size_t bufsize, const char* suffix)
+{
+    int n = snprintf(buf, bufsize, "%s%0*zu%s", b->base, b->width, i + 1, suffix);
+    return n < 0 || (size_t) n >= bufsize ? -1 : 0;
+}
+
+static int keygen_task(void* arg, size_t i)
+{
+    struct batch* b = arg;
+    if (b->mode == 'S')
+        crypto_sign_public_key(b->pk[i], b->sk[i]);
+    else
+        crypto_key_exchange_public_key(b->pk[i], b->sk[i]);
+    if (!b->files)
+        return 0;
+
+    char pk_fn[4096], sk_fn[4096];
+    if (batch_name(b, i, pk_fn, sizeof(pk_fn), b->mode == 'S' ? ".sign.pub" : ".lock.pub") != 0
+            || batch_name(b, i, sk_fn, sizeof(sk_fn), b->mode == 'S' ? ".sign.key" : ".lock.key") != 0) {
+        ERR("file name too long");
+        return -1;
+    }
+    return write_key(b->pk[i], b->sk[i], pk_fn, sk_fn);
+}
+
+static int write_bundle(const struct batch* b, uint8_t (*keys)[32], const char* fn)
+{
+    int rv = 1;
+    char name[4096];
+    uint8_t b64[B64_KEY_SIZE];
+    FILE* fp = fopen(fn, "w");
+    if (fp == NULL) {
+        ERR("cannot open '%s'", fn);
+        goto error;
+    }
+    for (size_t i = 0; i < b->size; i++) {
+        if (batch_name(b, i, name, sizeof(name), "") != 0) {
+            ERR("name too long");
+            goto error;
+        }
+        b64_encode(b64, keys[i], 32);
+        if (fprintf(fp, "%s ", name) < 0
+                || fwrite(b64, 1, sizeof(b64), fp) != sizeof(b64)
+                || fputc('\n', fp) == EOF) {
+            ERR("cannot write '%s'", fn);
+            goto error;
+        }
+    }
+    if (_fclose(&fp) != 0) {
+        ERR("cannot write '%s'", fn);
+        goto error;
+    }
+    rv = 0;
+
+error:
+    if (fp != NULL) fclose(fp);
+    WIPE_BUF(b64);
+    return rv;
+}
+
+int keygen_batch(int mode, size_t n, size_t jobs, const char* base,
+                 const char* pk_fn, const char* sk_fn)
+{
+    int rv = 1;
+    struct batch b = {
+        .mode  = mode,
+        .size  = n,
+        .base  = base != NULL ? base : "",
+        .files = pk_fn == NULL,
+        .pk    = malloc(n * 32),
+        .sk    = malloc(n * 32),
+    };
+    for (size_t m = n; m > 0; m /= 10)
+        b.width++;
+    if (b.pk == NULL || b.sk == NULL) {
+        ERR("malloc");
+        goto error;
+    }
+    if (_random(b.sk[0], n * 32) != 0) {
+        ERR("cannot generate keypairs");
+        goto error;
+    }
+    if (pl_for(jobs, n, keygen_task, &b) != 0)
+        goto error;
+    if (!b.files && (write_bundle(&b, b.pk, pk_fn) != 0
+                     || write_bundle(&b, b.sk, sk_fn) != 0))
+        goto error;
+    rv = 0;
+
+error:
+    _free(b.sk, b.sk != NULL ? (int) (n * 32) : 0);
+    free(b.pk);
+    return rv;
+}
+
+
 int main(int argc, char** argv)
 {
 #define __ERROR(m) { ERR(m); goto error; }
@@ -97,8 +215,11 @@ int main(int argc, char** argv)
     char* base  = NULL;
     char* pk_fn = NULL;
     char* sk_fn = NULL;
+    char* end;
+    size_t n    = 0;
+    size_t jobs = 1;
 
-    while ((c = getopt(argc, argv, "SLp:s:b:h")) != -1)
+    while ((c = getopt(argc, argv, "SLp:s:b:n:j:h")) != -1)
         switch (c) {
             default: __ERROR(SEE_USAGE); break;
             case 'S': mode = 'S'; break;
@@ -106,6 +227,20 @@ int main(int argc, char** argv)
             case 'p': pk_fn = optarg; break;
             case 's': sk_fn = optarg; break;
             case 'b': base = optarg; break;
+            case 'n':
+                errno = 0;
+                n = strtoul(optarg, &end, 10);
+                if (errno != 0 || end == optarg || *end != '\0'
+                        || n < 1 || n > BATCH_MAX)
+                    __ERROR("invalid argument to -n");
+                break;
+            case 'j':
+                errno = 0;
+                jobs = strtoul(optarg, &end, 10);
+                if (errno != 0 || end == optarg || *end != '\0'
+                        || jobs < 1 || jobs > 256)
+                    __ERROR("invalid argument to -j");
+                break;
             case 'h':
                 printf("%s", HELP);
                 rv = 0;
@@ -113,6 +248,15 @@ int main(int argc, char** argv)
                 break;
         }
 
+    if (n > 0) {
+        if ((mode != 'S' && mode != 'L')
+                || (pk_fn == NULL) != (sk_fn == NULL)
+                || (pk_fn == NULL && base == NULL))
+            __ERROR(SEE_USAGE);
+        rv = keygen_batch(mode, n, jobs, base, pk_fn, sk_fn);
+        goto error;
+    }
+
     if (base != NULL) {
         size_t len = strlen(base);
         pk_fn = malloc(len + 10);
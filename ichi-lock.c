@@ -3,40 +3,87 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sys/stat.h>
 
 #include "base64/base64.h"
 #include "monocypher/monocypher.h"
 #include "utils.h"
 #include "lock_stream.h"
+#include "lz.h"
+#include "pipeline.h"
+#include "stats.h"
+#include "agent.h"
 #include "readpassphrase.h"
 
-// +------------+-----------------------------+---------------------------+-------------------------------------+
-// | nonce (24) | @ + pubkey (32) + nrecp (1) | mac + enckey (48 * nrecp) | mac + length + mac + enc (34 + ...) |
-// +------------+-----------------------------+---------------------------+-------------------------------------+
-//              | # + mcost (4) + tcost (1) + salt_length (1) + salt      |
-//              +---------------------------------------------------------+
+// +------------+-----------------------+-----------------------------+---------------------------+-------------------------------------+
+// | nonce (24) | % + size (1) + params | @ + pubkey (32) + nrecp (1) | mac + enckey (48 * nrecp) | mac + length + mac + enc (36 + ...) |
+// +------------+-----------------------+-----------------------------+---------------------------+-------------------------------------+
+//                                      | # + mcost (4) + tcost (1) + lanes (1) + salt_length (1) + salt |
+//                                      +----------------------------------------------------------------+
 
 #define B64_KEY_SIZE 44
-#define READ_SIZE    32 * 1024 /* 32 KiB */
 #define SEE_USAGE    "invalid usage. see -h"
 
 static const char *HELP =
     "usage:\n"
-    "  ichi-lock -E [-k KEY] -r RECP [-o OUTPUT] [INPUT]\n"
-    "  ichi-lock -D -k KEY [-v SENDER] [-o OUTPUT] [INPUT]\n"
-    "  ichi-lock -E {-p PASS | -a} [-o OUTPUT] [INPUT]\n"
-    "  ichi-lock -D {-p PASS | -a} [-o OUTPUT] [INPUT]\n"
+    "  ichi-lock -E [-k KEY] -r RECP [-t] [-f] [-z] [-c SHIFT] [-j JOBS] [-o OUTPUT] [INPUT]\n"
+    "  ichi-lock -D -k KEY [-v SENDER] [-j JOBS] [-o OUTPUT] [INPUT]\n"
+    "  ichi-lock -E {-p PASS | -a} [-l LANES] [-f] [-z] [-c SHIFT] [-j JOBS] [-o OUTPUT] [INPUT]\n"
+    "  ichi-lock -D {-p PASS | -a} [-j JOBS] [-o OUTPUT] [INPUT]\n"
+    "  ichi-lock -D {-k KEY | -p PASS | -a} --range OFFSET:LEN [-o OUTPUT] INPUT\n"
+    "  ichi-lock -E {-r RECP... | -p PASS | -a} [...] -O DIR {INPUT... | --list LIST}\n"
+    "  ichi-lock -K -k KEY [-v SENDER] -r RECP... [-t] [-o OUTPUT] [INPUT]\n"
+    "  ichi-lock {-E | -D} -A SOCKET [-o OUTPUT] [INPUT]\n"
     "\n"
     "options:\n"
     "  -E        encrypt INPUT into OUTPUT.\n"
     "  -D        decrypt INPUT into OUTPUT.\n"
+    "  -K        rekey INPUT into OUTPUT: unwrap its key with KEY, and\n"
+    "            wrap it for the RECPs instead. the encrypted chunks are\n"
+    "            copied as they are. recepients left out may still have\n"
+    "            the key: to revoke them, decrypt and encrypt again.\n"
+    "            -v checks the sender of INPUT; OUTPUT is wrapped from a\n"
+    "            new key, so its recepients can no longer check a sender.\n"
     "  -k KEY    use secret key file at path KEY.\n"
     "  -r RECP   with -E, specify recepient public key at path RECP.\n"
     "            can be repeated.\n"
     "  -o OUTPUT set OUTPUT stream.\n"
     "  -p PASS   use password file at path PASS.\n"
     "  -a        specify password interactively.\n"
+    "  -l LANES  with -E and a password, derive the key with LANES\n"
+    "            parallel Argon2i lanes (1-16, default: 4).\n"
     "  -v SENDER with -D, verify that SENDER produced the encryption.\n"
+    "  -t        with -E and -r, tag recepient slots so that they can be\n"
+    "            found without trying every slot.\n"
+    "  -f        with -E, use the fast stream construction.\n"
+    "  -z        with -E, compress chunks (LZ4) before encrypting them.\n"
+    "            chunks that do not shrink are stored as is, and the\n"
+    "            stream cannot be decrypted with --range.\n"
+    "  -c SHIFT  with -E, use chunks of 2^SHIFT bytes (8-24, default: 15).\n"
+    "  --digest TYPE\n"
+    "            with -E, end the stream with a digest of TYPE: blake2b\n"
+    "            (default), the BLAKE2b of the plaintext, or tree, the\n"
+    "            BLAKE2b of the BLAKE2b of each chunk, hashed by JOBS\n"
+    "            threads.\n"
+    "  -j JOBS   encrypt or decrypt chunks and compute shared keys\n"
+    "            on JOBS threads (default: 1).\n"
+    "  --range OFFSET:LEN\n"
+    "            with -D, only decrypt LEN bytes of plaintext from OFFSET.\n"
+    "            only reads the chunks holding them: needs a seekable\n"
+    "            INPUT and an indexed or fast stream.\n"
+    "  -O DIR    with -E, encrypt every INPUT into DIR/INPUT, on JOBS\n"
+    "            threads, loading keys and deriving keys only once.\n"
+    "            with -k, all the files wrap their keys from KEY, and\n"
+    "            share the keystream of their recepient slots.\n"
+    "  --list LIST\n"
+    "            with -O, read the INPUTs from LIST, one per line\n"
+    "            (- for stdin).\n"
+    "  --stats   print time per phase and counters to stderr, as JSON\n"
+    "            (also with $ICHI_STATS=1).\n"
+    "  -A SOCKET have the `ichi-agent` listening on SOCKET do the work,\n"
+    "            with the keys and options it was started with.\n"
     "\n"
     "INPUT defaults to stdin, and OUTPUT defaults to stdout.\n"
     "\n"
@@ -52,62 +99,237 @@ static const char *HELP =
 
 typedef uint8_t u8;
 
-static const u8 HEAD_PUBKEY = '@',
+static const u8 HEAD_PARAMS = '%',
+                HEAD_PUBKEY = '@',
+                HEAD_TAGGED = '&',
                 HEAD_PDKF   = '#',
                 HEAD_BLOCK  = 'B',
+                HEAD_LZ4    = 'Z',
                 HEAD_DIGEST = '$';
 
 struct ls_pdkf_params pdkf_standard_params = {
     .nb_blocks = 100000,
     .nb_iterations = 3,
+    .nb_lanes = 4,
     .salt_size = 32,
 };
 
+struct ls_stream_params stream_params = {
+    .version     = LS_VERSION_INDEXED,
+    .chunk_shift = LS_CHUNK_SHIFT_DEFAULT,
+};
+
+// Chunk buffers, shared by every stream of the run (-O locks several
+// at once).  Big enough for a chunk with the room to lock it in place.
+static struct pl_arena *arena;
+static pthread_mutex_t  arena_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define CHUNK_BUF_SIZE(chunk_size) (LS_HEAD_INDEXED + 1 + (chunk_size))
+
+// NULL if there is no arena for chunk_size: pl_new() then mallocs
+static struct pl_arena *chunk_arena(size_t chunk_size)
+{
+    pthread_mutex_lock(&arena_lock);
+    if (arena == NULL)
+        arena = pl_arena_new(CHUNK_BUF_SIZE(chunk_size));
+    struct pl_arena *ar = arena;
+    if (ar != NULL && pl_arena_buf_size(ar) < CHUNK_BUF_SIZE(chunk_size))
+        ar = NULL;
+    pthread_mutex_unlock(&arena_lock);
+    return ar;
+}
+
 //
 // Encryption
 //
-// Write encrypted lock stream for fp
-static int encrypt_lockstream(FILE* fp, const u8 enc_key[32], u8 nonce[24])
+struct lock_ctx {
+    const u8                 *key;
+    const u8                 *nonce;
+    const struct ls_fast_ctx *fast; // NULL unless a fast stream
+    size_t                    head; // room before the plaintext, in place
+    int                       compress;
+    int                       tree; // LS_DIGEST_TREE
+    crypto_blake2b_ctx        hash;
+    struct output             out;
+};
+
+// Returns the size of the locked chunk
+static size_t lock_at(const struct lock_ctx *lc, u8 *output, uint64_t index,
+                      const u8 *input, size_t input_size)
 {
-    int rv = 1;
-    size_t buf_size = 16 + 2 + 16 + 1 + READ_SIZE;
-    u8 *buf = malloc(buf_size); // mac1 length mac2 head ...
+    if (lc->fast != NULL) {
+        ls_fast_lock(lc->fast, output, index, input, input_size);
+        return 20 + input_size;
+    }
+    ls_lock_at(output, lc->nonce, lc->key, index, input, input_size);
+    return 36 + input_size;
+}
 
-    ENSURE(buf != NULL, "malloc()");
+static int lock_chunk(void *arg, struct pl_slot *slot)
+{
+    struct lock_ctx *lc = arg;
+    if (!lc->compress) {
+        // the plaintext was read at slot->in + head, see encrypt_lockstream
+        u8 *pt = slot->in + lc->head;
+        if (lc->tree)
+            ls_chunk_digest(slot->digest, pt + 1, slot->in_size - 1);
+        slot->out      = slot->in;
+        slot->out_size = lc->fast != NULL
+            ? ls_fast_lock_inplace(lc->fast, slot->in, slot->index, slot->in_size)
+            : ls_lock_at_inplace(slot->in, lc->nonce, lc->key, slot->index,
+                                 slot->in_size);
+        return 0;
+    }
 
-    u8 *ct = buf,
-       *pt = buf + 34;
+    if (lc->tree)
+        ls_chunk_digest(slot->digest, slot->in + 1, slot->in_size - 1);
+    // compressed right where lock_at() puts the ciphertext, and
+    // encrypted in place
+    u8 *pt = slot->out + (lc->fast != NULL ? LS_HEAD_FAST : LS_HEAD_INDEXED);
+    size_t size = lz_compress(pt + 1, slot->in_size - 2,
+                              slot->in + 1, slot->in_size - 1);
+    if (size > 0) {
+        pt[0] = HEAD_LZ4;
+        slot->out_size = lock_at(lc, slot->out, slot->index, pt, 1 + size);
+        return 0;
+    }
+    slot->out_size = lock_at(lc, slot->out, slot->index,
+                             slot->in, slot->in_size);
+    return 0;
+}
 
-    crypto_blake2b_ctx ctx;
-    crypto_blake2b_init(&ctx);
+// Runs in order. For a tree digest the chunk digests are taken here;
+// otherwise chunks are hashed as they are read, before being locked
+// in place.  Chunks are queued and written in batches by flush_chunks().
+static int write_chunk(void *arg, struct pl_slot *slot)
+{
+    struct lock_ctx *lc = arg;
+    if (lc->tree) {
+        struct st_timer t;
+        st_start(ST_HASH, &t);
+        crypto_blake2b_update(&lc->hash, slot->digest, 64);
+        st_stop(ST_HASH, &t);
+    }
+    if (out_queue(&lc->out, slot->out, slot->out_size) != 0) {
+        ERR("cannot write to output stream");
+        return -1;
+    }
+    return 0;
+}
+
+static int flush_chunks(void *arg)
+{
+    struct lock_ctx *lc = arg;
+    if (out_flush(&lc->out) != 0) {
+        ERR("cannot write to output stream");
+        return -1;
+    }
+    return 0;
+}
+
+static int write_stream_params(FILE* out, const struct ls_stream_params *sp)
+{
+    int rv = 1;
+    u8 params[LS_STREAM_MAX];
+    size_t size = ls_stream_encode(params, sp);
+    XWRITE(out, &HEAD_PARAMS, 1);
+    XWRITE(out, params,       size);
+    rv = 0;
+error:
+    return rv;
+}
+
+// Write encrypted lock stream for fp to out
+static int encrypt_lockstream(FILE* fp, FILE* out, const u8 enc_key[32],
+                              const u8 nonce[24], size_t jobs)
+{
+    int rv = 1;
+    uint64_t index = 0;
+    size_t chunk_size = ls_chunk_size(&stream_params);
+    u8 buf[36 + 1 + 64]; // digest chunk
+    u8 *ct = buf,
+       *pt = buf + 36;
+
+    struct ls_fast_ctx fast;
+    struct lock_ctx lc;
+    lc.key   = enc_key;
+    lc.nonce = nonce;
+    lc.fast  = NULL;
+    lc.compress = stream_params.compression != LS_COMPRESSION_NONE;
+    lc.tree     = stream_params.digest == LS_DIGEST_TREE;
+    crypto_blake2b_init(&lc.hash);
+    if (stream_params.version == LS_VERSION_FAST) {
+        ls_fast_init(&fast, enc_key, nonce);
+        lc.fast = &fast;
+    }
+    // compressed chunks need a buffer to compress into; others are
+    // read with room for the header and locked in place
+    lc.head = lc.compress     ? 0
+            : lc.fast != NULL ? LS_HEAD_FAST
+            :                   LS_HEAD_INDEXED;
+
+    struct input in = { .map = NULL, .buf = NULL };
+    struct pipeline *pl = NULL;
+    struct st_timer t, hash_timer;
+    st_start(ST_STREAM, &t);
+    ENSURE(out_open(&lc.out, out) == 0, "cannot write to output stream");
+    pl = lc.compress
+        ? pl_new(jobs, 1 + chunk_size, CHUNK_BUF_SIZE(chunk_size),
+                 chunk_arena(chunk_size),
+                 lock_chunk, write_chunk, flush_chunks, &lc)
+        : pl_new(jobs, CHUNK_BUF_SIZE(chunk_size), 0,
+                 chunk_arena(chunk_size),
+                 lock_chunk, write_chunk, flush_chunks, &lc);
+    ENSURE(pl != NULL, "cannot start workers");
+    ENSURE(in_open(&in, fp) == 0, "malloc()");
 
     while (1) {
-        size_t n = fread(pt + 1, 1, READ_SIZE, fp);
-        ENSURE(!ferror(fp), "cannot read");
+        struct pl_slot *slot = pl_acquire(pl);
+        if (slot == NULL)
+            goto error;
+        u8 *chunk = slot->in + lc.head;
+        size_t n;
+        ENSURE(in_read(&in, chunk + 1, &n, chunk_size) == 0, "cannot read");
         if (n > 0) {
-            pt[0] = HEAD_BLOCK;
-            crypto_blake2b_update(&ctx, pt + 1, n);
-            ls_lock(ct, nonce, enc_key, pt, 1 + n);
-            XWRITE(stdout, ct, 34 + 1 + n);
+            if (!lc.tree) {
+                st_start(ST_HASH, &hash_timer);
+                crypto_blake2b_update(&lc.hash, chunk + 1, n);
+                st_stop(ST_HASH, &hash_timer);
+            }
+            chunk[0]      = HEAD_BLOCK;
+            slot->in_size = 1 + n;
+            slot->index   = index++;
+            if (pl_submit(pl, slot) != 0)
+                goto error;
         }
-        if (feof(fp)) {
-            pt[0] = HEAD_DIGEST;
-            crypto_blake2b_final(&ctx, pt + 1);
-            ls_lock(ct, nonce, enc_key, pt, 1 + 64);
-            XWRITE(stdout, ct, 34 + 1 + 64);
-            rv = 0;
+        if (n < chunk_size)
             break;
-        }
     }
 
+    int err = pl_finish(pl);
+    pl = NULL;
+    if (err != 0)
+        goto error;
+
+    pt[0] = HEAD_DIGEST;
+    crypto_blake2b_final(&lc.hash, pt + 1);
+    XWRITE(out, ct, lock_at(&lc, ct, index, pt, 1 + 64));
+    rv = 0;
+
 error:
-    _free(buf, buf_size);
-    WIPE_CTX(&ctx);
+    if (pl != NULL)
+        pl_finish(pl);
+    in_close(&in);
+    st_stop(ST_STREAM, &t);
+    WIPE_BUF(buf);
+    WIPE_CTX(&lc.hash);
+    WIPE_CTX(&fast);
     return rv;
 }
 
 struct recepients {
     u8*    recp;
+    u8*    shared; // shared keys with the sender, see kx_precompute
     size_t size;
 };
 
@@ -130,66 +352,281 @@ static int add_recepient(struct recepients *rs, const u8* rcp_key)
     return 0;
 }
 
-static int encrypt_pdkf(FILE* fp, const u8* password, size_t password_size)
+struct kx_task {
+    struct recepients *rs;
+    const u8          *sk;
+};
+
+static int kx_shared_task(void *arg, size_t i)
+{
+    struct kx_task *task = arg;
+    ls_kx_shared(task->rs->shared + 32 * i,
+                 task->sk,
+                 task->rs->recp + 32 * i);
+    return 0;
+}
+
+// Compute the shared key with every recepient (in parallel), once
+// per sender instead of once per stream.
+static int kx_precompute(struct recepients *rs, const u8 *sk, size_t jobs)
+{
+    struct kx_task task = { .rs = rs, .sk = sk };
+    struct st_timer t;
+    if (rs->shared == NULL)
+        rs->shared = malloc(32 * rs->size);
+    if (rs->shared == NULL) {
+        ERR("malloc()");
+        return -1;
+    }
+    st_start(ST_KX, &t);
+    int rv = pl_for(jobs, rs->size, kx_shared_task, &task);
+    st_stop(ST_KX, &t);
+    return rv;
+}
+
+// Derive the key for a password, with a new salt.  The key can be used
+// for any number of streams: each of them gets its own nonce.
+static int pdkf_setup(u8 enc_key[32], u8 pdkf_params[7 + 32],
+                      const u8* password, size_t password_size)
 {
     int rv = 1;
-    u8 nonce       [24],
-       salt        [32],
-       pdkf_params [6 + 32],
-       enc_key     [32];
+    u8 salt[32];
+    ENSURE(_random(salt, 32) == 0, "cannot generate salt");
+    ls_pdkf_challenge(pdkf_params, &pdkf_standard_params, salt);
+    ENSURE(ls_pdkf_key(enc_key,
+                       &pdkf_standard_params,
+                       salt,
+                       password, password_size) == 0, "cannot derive key");
+    rv = 0;
+error:
+    return rv;
+}
+
+static int encrypt_pdkf(FILE* fp, FILE* out, const u8 enc_key[32],
+                        const u8 pdkf_params[7 + 32], size_t jobs)
+{
+    int rv = 1;
+    u8 nonce[24];
 
     ENSURE(_random(nonce, 24) == 0, "cannot generate nonce");
-    ENSURE(_random(salt,  32) == 0, "cannot generate salt");
+    XWRITE(out, nonce,       24);
+    if (write_stream_params(out, &stream_params) != 0)
+        goto error;
+    XWRITE(out, &HEAD_PDKF,  1);
+    XWRITE(out, pdkf_params, 7 + 32);
 
-    ls_pdkf_challenge(pdkf_params, &pdkf_standard_params, salt);
-    ls_pdkf_key(enc_key,
-                &pdkf_standard_params,
-                salt,
-                password, password_size);
+    rv = encrypt_lockstream(fp, out, enc_key, nonce, jobs);
 
-    XWRITE(stdout, nonce,       24);
-    XWRITE(stdout, &HEAD_PDKF,  1);
-    XWRITE(stdout, pdkf_params, sizeof(pdkf_params));
+error:
+    return rv;
+}
 
-    rv = encrypt_lockstream(fp, enc_key, nonce);
+// Writes the KX block wrapping enc_key for every recepient of rs,
+// whose shared keys with the sender sk have been computed.
+static int write_pubkey_block(FILE* out, const u8* sk,
+                              const struct recepients *rs,
+                              const u8 enc_key[32], const u8 nonce[24],
+                              int tagged)
+{
+    int rv = 1;
+    u8 pk    [32],
+       kx_ct [8 + 16 + 32],
+       nrecp;
+
+    struct st_timer t;
+    st_start(ST_KX, &t);
+    crypto_key_exchange_public_key(pk, sk);
+    st_stop(ST_KX, &t);
+    nrecp = rs->size & 0xFF;
+
+    XWRITE(out, tagged ? &HEAD_TAGGED : &HEAD_PUBKEY, 1);
+    XWRITE(out, pk,           32);
+    XWRITE(out, &nrecp,       1);
+
+    for (size_t i = 0; i < rs->size; i++) {
+        if (tagged) {
+            ls_kx_wrap_tagged(kx_ct,
+                              rs->shared + (32 * i),
+                              enc_key,
+                              nonce);
+            XWRITE(out, kx_ct, 8 + 48);
+        } else {
+            ls_kx_wrap(kx_ct,
+                       rs->shared + (32 * i),
+                       enc_key);
+            XWRITE(out, kx_ct, 48);
+        }
+    }
+    rv = 0;
 
 error:
-    WIPE_BUF(enc_key);
+    WIPE_BUF(kx_ct);
     return rv;
 }
 
-static int encrypt_pubkey(FILE* fp, const u8* sk, struct recepients rs)
+static int encrypt_pubkey(FILE* fp, FILE* out, const u8* sk,
+                          struct recepients rs, int tagged, size_t jobs)
 {
     int rv = 1;
     u8 nonce   [24],
-       enc_key [32],
-       pk      [32],
-       kx_ct   [32 + 16],
-       nrecp;
+       enc_key [32];
 
     ENSURE(_random(nonce,   24) == 0, "cannot generate nonce");
     ENSURE(_random(enc_key, 32) == 0, "cannot generate encryption key");
 
-    crypto_key_exchange_public_key(pk, sk);
-    nrecp = rs.size & 0xFF;
+    XWRITE(out, nonce,        24);
+    if (write_stream_params(out, &stream_params) != 0
+            || write_pubkey_block(out, sk, &rs, enc_key, nonce, tagged) != 0)
+        goto error;
 
-    XWRITE(stdout, nonce,        24);
-    XWRITE(stdout, &HEAD_PUBKEY, 1);
-    XWRITE(stdout, pk,           32);
-    XWRITE(stdout, &nrecp,       1);
+    rv = encrypt_lockstream(fp, out, enc_key, nonce, jobs);
 
-    for (size_t i = 0; i < rs.size; i++) {
-        ls_kx_challenge(kx_ct,
-                        sk,
-                        rs.recp + (32 * i),
-                        enc_key);
-        XWRITE(stdout, kx_ct, sizeof(kx_ct));
+error:
+    WIPE_BUF(enc_key);
+    return rv;
+}
+
+//
+// Batch encryption
+//
+struct batch {
+    char              **inputs;
+    size_t              size;
+    const char         *dir;
+    const u8           *sk;        // NULL: a new sender key per file
+    struct recepients  *rs;        // shared keys precomputed if sk != NULL
+    int                 tagged;
+    const u8           *pdkf_key;  // password mode if not NULL
+    const u8           *pdkf_params;
+};
+
+// DIR/INPUT, with the leading slashes of INPUT dropped.  Paths that
+// could leave DIR are refused.
+static char* batch_output_path(const char *dir, const char *input)
+{
+    while (*input == '/')
+        input++;
+    size_t len = strlen(input);
+    if (len == 0
+            || strcmp(input, "..") == 0
+            || strncmp(input, "../", 3) == 0
+            || strstr(input, "/../") != NULL
+            || (len >= 3 && strcmp(input + len - 3, "/..") == 0))
+        return NULL;
+
+    char *path = malloc(strlen(dir) + 1 + len + 1);
+    if (path != NULL)
+        sprintf(path, "%s/%s", dir, input);
+    return path;
+}
+
+// mkdir -p for the directories leading to path
+static int make_parents(char *path)
+{
+    for (char *p = strchr(path + 1, '/'); p != NULL; p = strchr(p + 1, '/')) {
+        *p = '\0';
+        int err = mkdir(path, 0777) != 0 && errno != EEXIST;
+        *p = '/';
+        if (err)
+            return -1;
+        errno = 0;
     }
+    return 0;
+}
 
-    rv = encrypt_lockstream(fp, enc_key, nonce);
+static int batch_task(void *arg, size_t i)
+{
+    int rv = 1;
+    struct batch *b = arg;
+    const char *input = b->inputs[i];
+    FILE *fp = NULL, *out = NULL;
+    u8 sk[32];
+    struct recepients rs = *b->rs;
+    rs.shared = NULL;
+
+    errno = 0;
+    char *path = batch_output_path(b->dir, input);
+    ENSURE(path != NULL, "invalid input path '%s'", input);
+    fp = fopen(input, "r");
+    ENSURE(fp != NULL, "cannot open input file %s", input);
+    ENSURE(make_parents(path) == 0, "cannot create directories for %s", path);
+    out = fopen(path, "w");
+    ENSURE(out != NULL, "cannot open output file: %s", path);
+
+    if (b->pdkf_key != NULL) {
+        rv = encrypt_pdkf(fp, out, b->pdkf_key, b->pdkf_params, 1);
+    } else if (b->sk != NULL) {
+        rv = encrypt_pubkey(fp, out, b->sk, *b->rs, b->tagged, 1);
+    } else {
+        ENSURE(_random(sk, 32) == 0, "cannot generate ephemeral key");
+        ENSURE(kx_precompute(&rs, sk, 1) == 0, "cannot compute shared keys");
+        rv = encrypt_pubkey(fp, out, sk, rs, b->tagged, 1);
+    }
+    if (fclose(out) != 0 && rv == 0) {
+        ERR("cannot write to output file: %s", path);
+        rv = 1;
+    }
+    out = NULL;
+    if (rv != 0)
+        unlink(path);
 
 error:
-    WIPE_BUF(enc_key);
+    if (out != NULL) {
+        fclose(out);
+        unlink(path);
+    }
+    if (fp != NULL) fclose(fp);
+    free(path);
+    WIPE_BUF(sk);
+    _free(rs.shared, 32 * rs.size);
+    return rv;
+}
+
+// Encrypt every input into DIR, one file per job.  Keys are loaded once;
+// with a sender key the shared keys are computed once for the batch, and
+// with a password the key is derived once and each file gets its own
+// nonce.  The key wrapping nonce is fixed, so streams locked by one
+// key pair share the keystream of their recepient slots.  Ephemeral
+// senders get a new key pair per file to avoid it; with -k, every file
+// is knowingly locked from the same pair, as separate -E -k runs are.
+static int encrypt_batch(struct batch *b, size_t jobs)
+{
+    if (mkdir(b->dir, 0777) != 0 && errno != EEXIST) {
+        ERR("cannot create output directory %s", b->dir);
+        return 1;
+    }
+    errno = 0;
+    return pl_for(jobs, b->size, batch_task, b) == 0 ? 0 : 1;
+}
+
+// One path per line, empty lines ignored.
+static int read_list(const char *fn, char ***inputs, size_t *size)
+{
+    int rv = 1;
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    FILE *fp = strcmp(fn, "-") == 0 ? stdin : fopen(fn, "r");
+    ENSURE(fp != NULL, "cannot open list file %s", fn);
+
+    while ((n = getline(&line, &cap, fp)) > 0) {
+        if (line[n - 1] == '\n')
+            line[--n] = '\0';
+        if (n == 0)
+            continue;
+        char **grown = reallocarray(*inputs, *size + 1, sizeof(char*));
+        ENSURE(grown != NULL, "malloc()");
+        *inputs = grown;
+        ENSURE(((*inputs)[*size] = strdup(line)) != NULL, "malloc()");
+        (*size)++;
+    }
+    ENSURE(!ferror(fp), "cannot read list file %s", fn);
+    errno = 0;
+    rv = 0;
+
+error:
+    free(line);
+    if (fp != NULL && fp != stdin) fclose(fp);
     return rv;
 }
 
@@ -199,10 +636,13 @@ error:
 static int decrypt_pubkey_block(FILE* fp,
                                 u8* enc_key,
                                 const u8* recp_sk,
-                                const u8* sender_to_verify)
+                                const u8* sender_to_verify,
+                                const u8* nonce,
+                                int tagged)
 {
     int rv = 1;
-    u8 kx_ct      [16 + 32],
+    u8 kx_ct      [8 + 16 + 32],
+       tag        [8],
        shared_key [32],
        sender_pk  [32],
        nrecp;
@@ -215,9 +655,17 @@ static int decrypt_pubkey_block(FILE* fp,
                "sender verification failed");
 
     crypto_key_exchange(shared_key, recp_sk, sender_pk);
+    ls_kx_tag(tag, shared_key, nonce);
 
     int found = 0;
     for (; nrecp > 0; nrecp--) {
+        if (tagged) {
+            XREAD(fp, kx_ct, 8 + 48);
+            // only try slots carrying our tag
+            if (!found && memcmp(kx_ct, tag, 8) == 0)
+                found = (ls_kx_unwrap(kx_ct + 8, enc_key, shared_key) == 0);
+            continue;
+        }
         XREAD(fp, kx_ct, 48);
         // try to unlock chunk
         if (!found)
@@ -236,15 +684,17 @@ error:
 static int decrypt_pdkf_block(FILE* fp,
                               u8* enc_key,
                               const u8 *password,
-                              size_t password_size)
+                              size_t password_size,
+                              int legacy)
 {
     int rv = 1;
     struct ls_pdkf_params params;
-    u8 params_buf [6],
+    u8 params_buf [7],
        salt       [255];
+    size_t params_size = legacy ? 6 : 7;
 
-    XREAD(fp, params_buf, 6);
-    ls_pdkf_decode(params_buf, &params);
+    XREAD(fp, params_buf, params_size);
+    ls_pdkf_decode(params_buf, params_size, &params);
 
     ENSURE(ls_pdkf_verify(&params) == 0, "invalid pdkf parameters");
     XREAD(fp, salt, params.salt_size);
@@ -259,79 +709,429 @@ error:
     return rv;
 }
 
+static int decrypt_stream_params(FILE* fp, struct ls_stream_params *params)
+{
+    int rv = 1;
+    u8 params_buf [LS_STREAM_MAX],
+       size;
+
+    XREAD(fp, &size, 1);
+    ENSURE(size < sizeof(params_buf), "bad encryption");
+    XREAD(fp, params_buf, size);
+    ENSURE(ls_stream_decode(params_buf, size, params) == 0
+            && ls_stream_verify(params) == 0,
+           "unsupported stream parameters");
+    rv = 0;
+
+error:
+    return rv;
+}
+
+struct unlock_ctx {
+    const u8                 *key;
+    const u8                 *nonce;
+    const struct ls_fast_ctx *fast; // NULL unless a fast stream
+    int                       legacy;
+    int                       compressed; // 'Z' chunks are allowed
+    int                       tree;       // LS_DIGEST_TREE
+    int                       done; // seen the digest chunk
+    crypto_blake2b_ctx        hash;
+    struct output             out;
+    // with --range, only plaintext bytes [lo, hi) are written out
+    int                       ranged;
+    uint64_t                  lo, hi;
+    size_t                    chunk_size;
+};
+
+// --range OFFSET:LEN
+struct range {
+    uint64_t offset,
+             length;
+};
+
+// Where the chunks of an indexed stream are, assuming that every chunk
+// but the last is full.  Chunk lengths are checked as they are read.
+struct range_layout {
+    uint64_t nchunks;   // plaintext chunks in the stream
+    size_t   last_size; // plaintext bytes in the last of them
+    off_t    digest;    // offset of the digest chunk
+    uint64_t first,     // chunks holding the range
+             end;
+};
+
+static int unlock_chunk(void *arg, struct pl_slot *slot)
+{
+    struct unlock_ctx *uc = arg;
+    size_t length = slot->in_size - (uc->fast != NULL ? 20 : 16);
+    int err;
+    if (uc->compressed) {
+        err = uc->fast != NULL
+            ? ls_fast_unlock(uc->fast, slot->out, slot->index,
+                             slot->in, length)
+            : uc->legacy
+            ? ls_unlock_payload(slot->out, slot->nonce, uc->key,
+                                slot->in, length)
+            : ls_unlock_payload_at(slot->out, uc->nonce, uc->key, slot->index,
+                                   slot->in, length);
+    } else {
+        // in place: slots have no out buffer of their own, see decrypt
+        err = uc->fast != NULL
+            ? ls_fast_unlock_inplace(uc->fast, slot->in, slot->index, length)
+            : uc->legacy
+            ? ls_unlock_payload_inplace(slot->in, slot->nonce, uc->key, length)
+            : ls_unlock_payload_at_inplace(slot->in, uc->nonce, uc->key,
+                                           slot->index, length);
+        slot->out = slot->in + (uc->fast != NULL ? LS_HEAD_FAST
+                                                 : LS_PAYLOAD_HEAD);
+    }
+    if (err != 0) {
+        ERR("bad encryption: cannot unlock");
+        return -1;
+    }
+    slot->out_size = length;
+    if (slot->out[0] == HEAD_LZ4) {
+        // the ciphertext is no longer needed: inflate into slot->in,
+        // and swap the buffers (of the same size, see decrypt)
+        size_t size;
+        if (!uc->compressed
+                || lz_decompress(slot->in + 1, uc->chunk_size, &size,
+                                 slot->out + 1, length - 1) != 0) {
+            ERR("bad encryption: cannot decompress");
+            return -1;
+        }
+        u8 *pt = slot->in;
+        slot->in       = slot->out;
+        slot->out      = pt;
+        slot->out[0]   = HEAD_BLOCK;
+        slot->out_size = 1 + size;
+    }
+    if (uc->tree && !uc->ranged && slot->out[0] == HEAD_BLOCK)
+        ls_chunk_digest(slot->digest, slot->out + 1, slot->out_size - 1);
+    return 0;
+}
+
+static int flush_plaintext(void *arg)
+{
+    struct unlock_ctx *uc = arg;
+    if (out_flush(&uc->out) != 0) {
+        ERR("cannot write to output stream");
+        return -1;
+    }
+    return 0;
+}
+
+// Runs in order, on the writer thread
+static int emit_chunk(void *arg, struct pl_slot *slot)
+{
+    int rv = -1;
+    struct unlock_ctx *uc = arg;
+    u8 digest[64];
+    u8 *pt = slot->out;
+    size_t length = slot->out_size;
+    struct st_timer t;
+
+    ENSURE(!uc->done, "expected EOF");
+    switch (pt[0]) {
+    default:
+        ERR("bad encryption");
+        goto error;
+    case HEAD_BLOCK:
+        if (uc->ranged) {
+            uint64_t start = slot->index * uc->chunk_size,
+                     lo    = uc->lo > start ? uc->lo - start : 0,
+                     hi    = uc->hi - start < length - 1 ? uc->hi - start : length - 1;
+            ENSURE(out_queue(&uc->out, pt + 1 + lo, hi - lo) == 0,
+                   "cannot write to output stream");
+            break;
+        }
+        st_start(ST_HASH, &t);
+        if (uc->tree)
+            crypto_blake2b_update(&uc->hash, slot->digest, 64);
+        else
+            crypto_blake2b_update(&uc->hash, pt + 1, length - 1);
+        st_stop(ST_HASH, &t);
+        ENSURE(out_queue(&uc->out, pt + 1, length - 1) == 0,
+               "cannot write to output stream");
+        break;
+    case HEAD_DIGEST:
+        ENSURE(length - 1 == 64, "bad encryption");
+        // a range does not see the whole plaintext. Unlocking the digest
+        // chunk at its index still proves where the stream ends.
+        if (!uc->ranged) {
+            crypto_blake2b_final(&uc->hash, digest);
+            ENSURE(crypto_verify64(digest, pt + 1) == 0, "invalid digest");
+        }
+        uc->done = 1;
+        break;
+    }
+    rv = 0;
+
+error:
+    WIPE_BUF(digest);
+    return rv;
+}
+
+// Lays out the stream from its size, and seeks fp to the first chunk
+// of the range (or to the digest chunk, if the range is empty).
+static int range_setup(FILE* fp, struct unlock_ctx *uc,
+                       const struct range *range, struct range_layout *rl)
+{
+    int rv = 1;
+    uint64_t overhead = uc->fast != NULL ? 20 : 36,
+             chunk_ct = overhead + 1 + uc->chunk_size;
+    off_t start = ftello(fp),
+          total;
+
+    ENSURE(!uc->legacy, "--range needs an indexed or fast stream");
+    ENSURE(!uc->compressed, "--range needs an uncompressed stream");
+    ENSURE(start >= 0 && fseeko(fp, 0, SEEK_END) == 0 && (total = ftello(fp)) >= 0,
+           "--range needs a seekable input");
+    ENSURE((uint64_t) (total - start) >= overhead + 1 + 64, "bad encryption");
+
+    uint64_t data = (uint64_t) (total - start) - (overhead + 1 + 64),
+             rem  = data % chunk_ct;
+    ENSURE(rem == 0 || rem >= overhead + 2, "bad encryption: uneven chunks");
+    rl->nchunks   = data / chunk_ct + (rem != 0);
+    rl->last_size = rem != 0 ? rem - overhead - 1 : uc->chunk_size;
+    rl->digest    = start + (off_t) data;
+
+    uint64_t size = rl->nchunks == 0 ? 0
+                  : (rl->nchunks - 1) * uc->chunk_size + rl->last_size;
+    uc->ranged = 1;
+    uc->lo     = range->offset < size ? range->offset : size;
+    uc->hi     = range->length < size - uc->lo ? uc->lo + range->length : size;
+    rl->first  = uc->lo / uc->chunk_size;
+    rl->end    = uc->hi == uc->lo ? rl->first : (uc->hi - 1) / uc->chunk_size + 1;
+
+    ENSURE(fseeko(fp, rl->first == rl->end ? rl->digest
+                                           : start + (off_t) (rl->first * chunk_ct),
+                  SEEK_SET) == 0, "cannot seek input stream");
+    if (rl->first == rl->end)
+        rl->first = rl->end = rl->nchunks;
+    rv = 0;
+
+error:
+    return rv;
+}
+
+// Plaintext length (with the block header) of chunk index, see range_setup
+static size_t range_chunk_length(const struct unlock_ctx *uc,
+                                 const struct range_layout *rl, uint64_t index)
+{
+    return index + 1 < rl->nchunks ? uc->chunk_size + 1
+         : index + 1 == rl->nchunks ? rl->last_size + 1
+         : 1 + 64;
+}
+
 static int decrypt(FILE* fp,
                    const u8* sk, const u8* verify_sender,
-                   const u8* password, size_t password_size)
+                   const u8* password, size_t password_size,
+                   const struct range *range, size_t jobs)
 {
     int rv = 1;
     u8 nonce    [24],
        enc_key  [32],
-       digest   [64],
+       head     [16 + 4],
        key_mode;
     size_t length;
+    uint64_t index = 0;
+    struct ls_stream_params params = {
+        .version     = LS_VERSION_LEGACY,
+        .chunk_shift = LS_CHUNK_SHIFT_DEFAULT,
+    };
+    struct pipeline *pl = NULL;
+    struct ls_fast_ctx fast;
+    struct unlock_ctx uc;
+    struct range_layout rl = { .nchunks = 0 };
+    struct st_timer t;
+    int streaming = 0;
+    crypto_blake2b_init(&uc.hash);
+    uc.fast   = NULL;
+    uc.ranged = 0;
 
-    size_t buf_size = READ_SIZE + 1 + 16;
-    u8 *buf = malloc(buf_size);
-
-    ENSURE(buf != NULL, "malloc()");
     XREAD(fp, nonce, 24);
     XREAD(fp, &key_mode, 1);
+    if (key_mode == HEAD_PARAMS) {
+        if (decrypt_stream_params(fp, &params) != 0)
+            goto error;
+        XREAD(fp, &key_mode, 1);
+    }
 
     switch(key_mode) {
         default:
             ERR("bad encryption");
             goto error;
         case HEAD_PUBKEY:
+        case HEAD_TAGGED:
             ENSURE(sk != NULL, "no secret key given");
-            if (decrypt_pubkey_block(fp, enc_key, sk, verify_sender) != 0)
+            st_start(ST_KX, &t);
+            int err = decrypt_pubkey_block(fp, enc_key, sk, verify_sender, nonce,
+                                           key_mode == HEAD_TAGGED);
+            st_stop(ST_KX, &t);
+            if (err != 0)
                 goto error;
             break;
         case HEAD_PDKF:
             ENSURE(password != NULL, "no password given");
-            if (decrypt_pdkf_block(fp, enc_key, password, password_size) != 0)
+            if (decrypt_pdkf_block(fp, enc_key, password, password_size,
+                                   params.version == LS_VERSION_LEGACY) != 0)
                 goto error;
             break;
     }
 
-    // begin ptrypt
-    crypto_blake2b_ctx ctx;
-    crypto_blake2b_init(&ctx);
+    uc.key    = enc_key;
+    uc.nonce  = nonce;
+    uc.legacy = params.version == LS_VERSION_LEGACY;
+    uc.compressed = params.compression != LS_COMPRESSION_NONE;
+    uc.tree       = params.digest == LS_DIGEST_TREE;
+    uc.done   = 0;
+    if (params.version == LS_VERSION_FAST) {
+        ls_fast_init(&fast, enc_key, nonce);
+        uc.fast = &fast;
+    }
+    size_t head_size  = uc.fast   != NULL ? 4
+                      : uc.legacy         ? 16 + 2
+                      :                     16 + 4,
+           chunk_size = ls_chunk_size(&params);
+    uc.chunk_size = chunk_size;
+    if (range != NULL) {
+        if (range_setup(fp, &uc, range, &rl) != 0)
+            goto error;
+        index = rl.first;
+    }
 
-    u8 *pt = buf + 16;
+    st_start(ST_STREAM, &t);
+    streaming = 1;
+    ENSURE(out_open(&uc.out, stdout) == 0, "cannot write to output stream");
+    size_t ct_cap = 4 + 16 + 1 + chunk_size;
+    pl = pl_new(jobs, ct_cap, uc.compressed ? ct_cap : 0,
+                chunk_arena(chunk_size), unlock_chunk, emit_chunk, flush_plaintext, &uc);
+    ENSURE(pl != NULL, "cannot start workers");
 
+    // walk the length headers; payloads are unlocked by the workers
     while (1) {
-        XREAD(fp, buf, 16 + 2);
-        ENSURE(ls_unlock_length(&length, nonce, enc_key, buf) == 0,
-               "bad encryption: cannot unlock");
-        ENSURE(length >= 1,             "bad encryption");
-        ENSURE(length <= READ_SIZE + 1, "bad encryption");
-        XREAD(fp, buf, 16 + length);
-        ENSURE(ls_unlock_payload(pt, nonce, enc_key, buf, length) == 0,
-               "bad encryption: cannot unlock");
-
-        switch (pt[0]) {
-        default:
-            ERR("bad encryption");
+        struct pl_slot *slot = pl_acquire(pl);
+        if (slot == NULL)
             goto error;
-        case HEAD_BLOCK:
-            crypto_blake2b_update(&ctx, pt + 1, length - 1);
-            XWRITE(stdout, pt + 1, length - 1);
+        struct st_timer io;
+        st_start(ST_IO, &io);
+        size_t n = fread(head, 1, head_size, fp);
+        st_stop(ST_IO, &io);
+        st_add(ST_READS, 1);
+        st_add(ST_BYTES_IN, n);
+        ENSURE(!ferror(fp), "cannot read from input stream");
+        if (n == 0 && feof(fp))
             break;
-        case HEAD_DIGEST:
-            ENSURE(length - 1 == 64, "bad encryption");
-            crypto_blake2b_final(&ctx, digest);
-            ENSURE(crypto_verify64(digest, pt + 1) == 0, "invalid digest");
-            // do 1 extra read and expect an EOF
-            ENSURE(fread(buf, 1, 1, fp) == 0 && feof(fp), "expected EOF");
-            rv = 0;
+        ENSURE(n == head_size, "cannot read from input stream");
+        ENSURE((uc.fast != NULL
+                ? ls_fast_unlock_length(uc.fast, &length, index, head)
+                : uc.legacy
+                ? ls_unlock_length(&length, nonce, enc_key, head)
+                : ls_unlock_length_at(&length, nonce, enc_key, index, head)) == 0,
+               "bad encryption: cannot unlock");
+        ENSURE(length >= 1,             "bad encryption");
+        ENSURE(length <= chunk_size + 1, "bad encryption");
+        ENSURE(range == NULL || length == range_chunk_length(&uc, &rl, index),
+               "bad encryption: uneven chunks");
+        if (uc.fast != NULL) {
+            // the length is authenticated along with the payload
+            memcpy(slot->in, head, 4);
+            XREAD(fp, slot->in + 4, length + 16);
+            slot->in_size = 4 + length + 16;
+        } else {
+            XREAD(fp, slot->in, 16 + length);
+            slot->in_size = 16 + length;
+        }
+        slot->index   = index++;
+        if (uc.legacy) {
+            memcpy(slot->nonce, nonce, 24);
+            ls_increment_nonce(nonce);
+        }
+        if (pl_submit(pl, slot) != 0)
             goto error;
+        // done with the range, skip to the digest chunk
+        if (range != NULL && index == rl.end && index < rl.nchunks) {
+            ENSURE(fseeko(fp, rl.digest, SEEK_SET) == 0, "cannot seek input stream");
+            index = rl.nchunks;
         }
     }
 
+    int err = pl_finish(pl);
+    pl = NULL;
+    if (err != 0)
+        goto error;
+    ENSURE(uc.done, "bad encryption: missing digest");
+    rv = 0;
+
 error:
+    if (pl != NULL)
+        pl_finish(pl);
+    if (streaming)
+        st_stop(ST_STREAM, &t);
     length = 0;
-    _free(buf, buf_size);
+    WIPE_BUF(head);
+    WIPE_BUF(enc_key);
+    WIPE_CTX(&uc.hash);
+    WIPE_CTX(&fast);
+    return rv;
+}
+
+//
+// Rekeying
+//
+// Unwraps the stream key with sk, and writes the stream to out with a
+// new KX block for rs.  The nonce, stream parameters and key do not
+// change, so the chunks are copied as they are, without being checked:
+// the recepients of out check them when they decrypt.  The new block
+// comes from an ephemeral sender: -v on out no longer passes for the
+// original one.
+static int rekey(FILE* fp, FILE* out,
+                 const u8* sk, const u8* verify_sender,
+                 struct recepients *rs, int tagged, size_t jobs)
+{
+    int rv = 1;
+    u8 nonce     [24],
+       enc_key   [32],
+       sender_sk [32],
+       key_mode;
+    struct ls_stream_params params;
+    int has_params = 0;
+
+    XREAD(fp, nonce, 24);
+    XREAD(fp, &key_mode, 1);
+    if (key_mode == HEAD_PARAMS) {
+        if (decrypt_stream_params(fp, &params) != 0)
+            goto error;
+        has_params = 1;
+        XREAD(fp, &key_mode, 1);
+    }
+    ENSURE(key_mode == HEAD_PUBKEY || key_mode == HEAD_TAGGED,
+           "can only rekey streams encrypted to public keys");
+
+    struct st_timer t;
+    st_start(ST_KX, &t);
+    int err = decrypt_pubkey_block(fp, enc_key, sk, verify_sender, nonce,
+                                   key_mode == HEAD_TAGGED);
+    st_stop(ST_KX, &t);
+    if (err != 0)
+        goto error;
+
+    // a new sender: the key wrapping nonce is fixed, so the wrapped keys
+    // of a sender and recepient pair must not lock two stream keys
+    ENSURE(_random(sender_sk, 32) == 0, "cannot generate ephemeral key");
+    ENSURE(kx_precompute(rs, sender_sk, jobs) == 0,
+           "cannot compute shared keys");
+
+    XWRITE(out, nonce, 24);
+    if ((has_params && write_stream_params(out, &params) != 0)
+            || write_pubkey_block(out, sender_sk, rs, enc_key, nonce, tagged) != 0)
+        goto error;
+    ENSURE(_copy(fp, out) == 0, "cannot copy the encrypted stream");
+    rv = 0;
+
+error:
     WIPE_BUF(enc_key);
+    WIPE_BUF(sender_sk);
     return rv;
 }
 
@@ -348,9 +1148,8 @@ static int read_key(char* fn, char* key_type, u8* key)
     ENSURE(_read(fp, b64_buf, sizeof(b64_buf)) == 0,
            "cannot read %s key '%s'", key_type, fn);
     ENSURE(b64_decoded_size(b64_buf, sizeof(b64_buf)) == 32
-            && b64_validate(b64_buf, sizeof(b64_buf)) == 0,
+            && b64_decode_checked(key, b64_buf, sizeof(b64_buf)) == 0,
            "invalid %s key '%s'", key_type, fn);
-    b64_decode(key, b64_buf, sizeof(b64_buf));
     rv = 0;
 
 error:
@@ -374,8 +1173,9 @@ int main(int argc, char** argv)
 {
     int rv = 1;
     struct recepients rcs;
-    rcs.recp = NULL;
-    rcs.size = 0;
+    rcs.recp   = NULL;
+    rcs.shared = NULL;
+    rcs.size   = 0;
 
     FILE* input_fp = stdin;
     FILE* tmp_fp = NULL;
@@ -389,10 +1189,35 @@ int main(int argc, char** argv)
     int kflag = 0,
         pflag = 0,
         vflag = 0,
+        tflag = 0,
+        oflag = 0,
         action = 0;
 
+    size_t jobs = 1;
+    char *tmp;
+    struct range range;
+    int rflag = 0;
+    const char *batch_dir = NULL,
+               *list_fn   = NULL,
+               *agent     = NULL;
+    char **inputs = NULL;
+    size_t ninputs = 0;
+    u8 pdkf_key    [32],
+       pdkf_params [7 + 32];
+
+    static const struct option long_options[] = {
+        { "range", required_argument, NULL, 'R' },
+        { "list",  required_argument, NULL, 'L' },
+        { "stats", no_argument,       NULL, 'S' },
+        { "digest", required_argument, NULL, 'T' },
+        { NULL,    0,                 NULL, 0   },
+    };
+
+    st_enable_from_env();
+
     int c = 0;
-    while ((c = getopt(argc, argv, "hEDr:k:v:p:o:a")) != -1) {
+    while ((c = getopt_long(argc, argv, "hEDKr:k:v:p:o:O:A:aj:c:l:ftz",
+                            long_options, NULL)) != -1) {
         switch (c) {
         default: goto error;
         case 'h':
@@ -431,44 +1256,157 @@ int main(int argc, char** argv)
             tmp_fp = NULL;
             break;
         case 'o':
+            oflag = 1;
             stdout = fopen(optarg, "w");
             ENSURE(stdout != NULL, "cannot open output file: %s", optarg);
             break;
+        case 'j':
+            errno = 0;
+            jobs = strtoul(optarg, &tmp, 10);
+            ENSURE(errno == 0 && tmp != optarg && *tmp == '\0'
+                    && jobs >= 1 && jobs <= 256,
+                   "invalid argument to -j");
+            break;
+        case 'c':
+            errno = 0;
+            stream_params.chunk_shift = strtoul(optarg, &tmp, 10);
+            ENSURE(errno == 0 && tmp != optarg && *tmp == '\0'
+                    && ls_stream_verify(&stream_params) == 0,
+                   "invalid argument to -c");
+            break;
+        case 'l':
+            errno = 0;
+            pdkf_standard_params.nb_lanes = strtoul(optarg, &tmp, 10);
+            ENSURE(errno == 0 && tmp != optarg && *tmp == '\0'
+                    && ls_pdkf_verify(&pdkf_standard_params) == 0,
+                   "invalid argument to -l");
+            break;
+        case 'R':
+            rflag = 1;
+            errno = 0;
+            range.offset = strtoull(optarg, &tmp, 10);
+            ENSURE(errno == 0 && tmp != optarg && *tmp == ':',
+                   "invalid argument to --range");
+            optarg = tmp + 1;
+            range.length = strtoull(optarg, &tmp, 10);
+            ENSURE(errno == 0 && tmp != optarg && *tmp == '\0',
+                   "invalid argument to --range");
+            break;
+        case 'O': batch_dir = optarg; break;
+        case 'A': agent     = optarg; break;
+        case 'L': list_fn   = optarg; break;
+        case 'S': st_enable(); break;
+        case 'T':
+            if (strcmp(optarg, "blake2b") == 0)
+                stream_params.digest = LS_DIGEST_BLAKE2B;
+            else if (strcmp(optarg, "tree") == 0)
+                stream_params.digest = LS_DIGEST_TREE;
+            else
+                ENSURE(0, "invalid argument to --digest");
+            break;
+        case 't': tflag = 1; break;
+        case 'f': stream_params.version = LS_VERSION_FAST; break;
+        case 'z': stream_params.compression = LS_COMPRESSION_LZ4; break;
         case 'E': action = 'E'; break;
         case 'D': action = 'D'; break;
+        case 'K': action = 'K'; break;
         }
     }
 
+    ENSURE(batch_dir != NULL || list_fn == NULL, "--list needs -O");
+    if (batch_dir != NULL) {
+        ENSURE(action == 'E', "-O only works with -E");
+        ENSURE(!oflag, "cannot use both -o and -O");
+        if (list_fn != NULL) {
+            ENSURE(argc == optind, SEE_USAGE);
+            if (read_list(list_fn, &inputs, &ninputs) != 0)
+                goto error;
+        } else {
+            ENSURE(argc > optind, "need at least 1 input with -O");
+            inputs  = argv + optind;
+            ninputs = argc - optind;
+        }
     // check that we only have at most 1 positional argument
-    ENSURE(argc <= optind + 1, SEE_USAGE);
-    if (argc == optind + 1) {
+    } else if (argc > optind + 1) {
+        ERR(SEE_USAGE);
+        goto error;
+    } else if (argc == optind + 1) {
         input_fp = fopen(argv[optind], "r");
         ENSURE(input_fp != NULL, "cannot open input file %s", argv[optind]);
     }
 
     ENSURE(!(kflag && pflag), "cannot specify both key and password");
+    ENSURE(!rflag || action == 'D', "--range only works with -D");
+    ENSURE(agent == NULL || (!kflag && !pflag && !vflag && !rflag
+                             && rcs.size == 0 && batch_dir == NULL),
+           "-A uses the keys of the agent");
 
     switch (action) {
     default:
         ERR(SEE_USAGE);
         break;
     case 'E':
-        if (pflag) {
-            rv = encrypt_pdkf(input_fp, password, password_size);
+        if (agent != NULL) {
+            rv = ag_call("ichi-lock", agent, AG_LOCK, NULL, 0,
+                         input_fp, stdout, NULL, NULL);
+        } else if (batch_dir != NULL) {
+            struct batch b = {
+                .inputs = inputs,
+                .size   = ninputs,
+                .dir    = batch_dir,
+                .sk     = kflag ? sk : NULL,
+                .rs     = &rcs,
+                .tagged = tflag,
+            };
+            if (pflag) {
+                if (pdkf_setup(pdkf_key, pdkf_params,
+                               password, password_size) != 0)
+                    goto error;
+                b.pdkf_key    = pdkf_key;
+                b.pdkf_params = pdkf_params;
+            } else {
+                ENSURE(rcs.size > 0, "need at least 1 recepient");
+                if (kflag)
+                    ENSURE(kx_precompute(&rcs, sk, jobs) == 0,
+                           "cannot compute shared keys");
+            }
+            rv = encrypt_batch(&b, jobs);
+        } else if (pflag) {
+            if (pdkf_setup(pdkf_key, pdkf_params,
+                           password, password_size) != 0)
+                goto error;
+            rv = encrypt_pdkf(input_fp, stdout, pdkf_key, pdkf_params, jobs);
         } else {
             ENSURE(rcs.size > 0, "need at least 1 recepient");
             if (!kflag)
                 ENSURE(_random(sk, 32) == 0, "cannot generate ephemeral key");
-            rv = encrypt_pubkey(input_fp, sk, rcs);
+            ENSURE(kx_precompute(&rcs, sk, jobs) == 0,
+                   "cannot compute shared keys");
+            rv = encrypt_pubkey(input_fp, stdout, sk, rcs, tflag, jobs);
         }
         break;
+    case 'K':
+        ENSURE(agent == NULL, "-A only works with -E or -D");
+        ENSURE(kflag, "-K needs the secret key of a recepient");
+        ENSURE(!pflag, "can only rekey streams encrypted to public keys");
+        ENSURE(rcs.size > 0, "need at least 1 recepient");
+        rv = rekey(input_fp, stdout, sk, vflag ? verify_sender : NULL,
+                   &rcs, tflag, jobs);
+        break;
     case 'D':
+        if (agent != NULL) {
+            rv = ag_call("ichi-lock", agent, AG_UNLOCK, NULL, 0,
+                         input_fp, stdout, NULL, NULL);
+            break;
+        }
         ENSURE(kflag || pflag, "at least one of password or key needs to be specified");
         rv = decrypt(input_fp,
                      kflag ? sk : NULL,
                      vflag ? verify_sender : NULL,
                      pflag ? password : NULL,
-                     pflag ? password_size : 0);
+                     pflag ? password_size : 0,
+                     rflag ? &range : NULL,
+                     jobs);
         break;
     }
 
@@ -478,6 +1416,12 @@ error:
     WIPE_BUF(sk);
     WIPE_BUF(password);
     WIPE_BUF(recepient);
+    WIPE_BUF(pdkf_key);
+    if (list_fn != NULL) {
+        for (size_t i = 0; i < ninputs; i++)
+            free(inputs[i]);
+        free(inputs);
+    }
     if (input_fp != NULL && fclose(input_fp) != 0) {
         ERR("fclose()");
         rv = 1;
@@ -488,5 +1432,8 @@ error:
     }
     if (tmp_fp != NULL) fclose(tmp_fp);
     if (rcs.recp != NULL) free(rcs.recp);
+    _free(rcs.shared, 32 * rcs.size);
+    pl_arena_free(arena);
+    st_report(stderr, "ichi-lock");
     return rv;
 }
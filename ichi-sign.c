@@ -4,14 +4,20 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <getopt.h>
 
 #include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 #include <dirent.h>
 #include <fcntl.h>
 
 #include "monocypher/monocypher.h"
 #include "base64/base64.h"
 #include "utils.h"
+#include "pipeline.h"
+#include "stats.h"
+#include "agent.h"
 
 
 #define ERR(...)      _err("ichi-sign", __VA_ARGS__)
@@ -22,6 +28,26 @@
 #define B64_SIG_SIZE (88)
 #define SIG_ARMOR_TOP "\n----BEGIN ICHI SIGNATURE----\n"
 #define SIG_ARMOR_END "\n---- END ICHI SIGNATURE ----\n"
+#define ARMOR_TOP_SIZE (sizeof(SIG_ARMOR_TOP) - 1)
+#define ARMOR_END_SIZE (sizeof(SIG_ARMOR_END) - 1)
+#define ARMOR_SIZE     (ARMOR_TOP_SIZE + B64_SIG_SIZE + 1 + ARMOR_END_SIZE)
+
+// Signatures name their key with a "key <fingerprint>\n" line: right
+// after SIG_ARMOR_TOP in inline armor, after the base64 when detached.
+// Signatures without it (older ones) are checked against every key.
+#define KEY_ID_SIZE    (8)
+#define KEY_LINE_TAG   "key "
+#define KEY_LINE_SIZE  (sizeof(KEY_LINE_TAG) - 1 + 2 * KEY_ID_SIZE + 1)
+#define ID_ARMOR_SIZE  (ARMOR_SIZE + KEY_LINE_SIZE)
+
+// Keyring index, all integers little endian:
+//   header:  magic[8] || count(4) || names_size(4)
+//   entries: count times key_id[8] || pk[32] || name_off(4) || name_len(4),
+//            sorted by key_id
+//   names:   names_size bytes of NUL terminated file names
+#define INDEX_MAGIC       "ICHIKEYS"
+#define INDEX_HEADER_SIZE (16)
+#define INDEX_ENTRY_SIZE  (KEY_ID_SIZE + 32 + 8)
 
 #define XERR(...)    do { ERR(__VA_ARGS__); goto error; } while(0)
 #define XREAD(...)   do { if (_read(__VA_ARGS__)) XERR("fread()"); } while(0)
@@ -31,6 +57,11 @@ const char* HELP =
     "usage:\n"
     "  ichi-sign -k SK [-d] [-o OUTPUT] [INPUT]\n"
     "  ichi-sign -V [-p PK] [-s SIG] [-x] [-o OUTPUT] [INPUT]\n"
+    "  ichi-sign -I DIR [-o INDEX]\n"
+    "  ichi-sign -k SK {-m [-o MANIFEST] | -d} [-j JOBS] {FILE... | -l LIST}\n"
+    "  ichi-sign -V -m [-p PK] [-j JOBS] [MANIFEST]\n"
+    "  ichi-sign -A SOCKET [-d] [-o OUTPUT] [INPUT]\n"
+    "  ichi-sign -V -A SOCKET -s SIG [INPUT]\n"
     "\n"
     "options:\n"
     "  -o OUTPUT specify output file.\n"
@@ -40,8 +71,22 @@ const char* HELP =
     "  -p PK     specify public key at path PK.\n"
     "  -s SIG    specify file for detached signature.\n"
     "  -x        print out contents if verification is successful.\n"
+    "  -I DIR    compile the public keys in DIR into a keyring index.\n"
+    "            DIR may also be a bundle of `ichi-keygen -n`.\n"
+    "  -m        sign a manifest of the BLAKE2b digests of every FILE,\n"
+    "            in b2sum format.  with -V, also check every file the\n"
+    "            manifest lists.\n"
+    "  -l LIST   read the FILEs from LIST, one per line (- for stdin).\n"
+    "  -j JOBS   hash or sign files on JOBS threads (default: 1).\n"
+    "  -A SOCKET sign or verify with the keys of the `ichi-agent`\n"
+    "            listening on SOCKET.\n"
+    "  --stats   print time per phase and counters to stderr, as JSON\n"
+    "            (also with $ICHI_STATS=1).\n"
     "\n"
     "INPUT and OUTPUT default to stdin and stdout respectively.\n"
+    "With several FILEs (or -l), -d writes each signature to FILE.sig.\n"
+    "Without -p, keys are looked up in $ICHI_SIGN_KEYRING, which is\n"
+    "either a directory of .sign.pub files or an index built by -I.\n"
     "\n"
     "SK and PK can be generated by ichi-keygen.\n\n";
 
@@ -49,12 +94,15 @@ enum action {
     ACTION_SIGN,
     ACTION_VERIFY,
     ACTION_TRIM,
+    ACTION_INDEX,
 };
 
 struct sign_ctx {
     FILE* input;
     FILE* output;
     uint8_t sk[32];
+    uint8_t pk[32];
+    crypto_sign_ctx first; // after crypto_sign_init_first_pass(), see sign_setup
     uint8_t detached; // produce a detached signature
 };
 
@@ -69,183 +117,523 @@ struct verify_ctx {
     uint8_t stream_output;
 };
 
+// public keys to check a signature against
+struct signer {
+    char*   name;
+    uint8_t pk[32];
+};
+
+// what the armor or detached signature file holds
+struct signature {
+    uint8_t sig[64];
+    uint8_t key_id[KEY_ID_SIZE];
+    uint8_t has_key_id;
+};
+
+struct signers {
+    struct signer* list;
+    size_t         size;
+};
+
 int trim(FILE* input, FILE* output);
 int sign(struct sign_ctx ctx);
 int verify(struct verify_ctx ctx);
-int verify_keyring(const struct verify_ctx* ctx,
-                   const uint8_t *msg, size_t msg_size,
-                   const uint8_t *sig);
+int load_keyring(struct signers* ss, const char* keyring_dir);
+int load_bundle(struct signers* ss, const char* bundle_fn);
+int load_index(struct signers* ss, const char* index_fn, const struct signature* s);
+int compile_index(const char* keyring_dir, FILE* output);
+void sign_setup(struct sign_ctx* ctx);
 
-uint8_t* fp_to_buf(FILE* fp, size_t* buf_size)
+// First bytes of the BLAKE2b hash of a public key
+void key_id(uint8_t id[KEY_ID_SIZE], const uint8_t pk[32])
 {
-    size_t total = 0;
-    size_t size = BUF_SIZE;
-    uint8_t* buf = malloc(size);
-    if (buf == NULL)
-        XERR("malloc()");
+    crypto_blake2b_general(id, KEY_ID_SIZE, NULL, 0, pk, 32);
+}
 
-    while (1) {
-        total += fread(buf + total, 1, BUF_SIZE, fp);
-        if (ferror(fp))
-            XERR("fread()");
-        if (feof(fp)) {
-            *buf_size = total;
-            return buf;
-        }
-        if (total + BUF_SIZE > size) {
-            size += BUF_SIZE;
-            uint8_t* new_buf = realloc(buf, size);
-            if (new_buf == NULL) {
-                free(buf);
-                XERR("malloc()");
-            }
-            buf = new_buf;
-        }
+void key_line(uint8_t line[KEY_LINE_SIZE], const uint8_t id[KEY_ID_SIZE])
+{
+    static const char hex[] = "0123456789abcdef";
+    size_t tag_size = sizeof(KEY_LINE_TAG) - 1;
+    memcpy(line, KEY_LINE_TAG, tag_size);
+    for (size_t i = 0; i < KEY_ID_SIZE; i++) {
+        line[tag_size + 2*i]     = hex[id[i] >> 4];
+        line[tag_size + 2*i + 1] = hex[id[i] & 15];
     }
+    line[KEY_LINE_SIZE - 1] = '\n';
+}
+
+int hex_digit(uint8_t c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+int parse_key_line(uint8_t id[KEY_ID_SIZE], const uint8_t line[KEY_LINE_SIZE])
+{
+    size_t tag_size = sizeof(KEY_LINE_TAG) - 1;
+    if (memcmp(line, KEY_LINE_TAG, tag_size) != 0
+            || line[KEY_LINE_SIZE - 1] != '\n')
+        return -1;
+    for (size_t i = 0; i < KEY_ID_SIZE; i++) {
+        int hi = hex_digit(line[tag_size + 2*i]),
+            lo = hex_digit(line[tag_size + 2*i + 1]);
+        if (hi < 0 || lo < 0)
+            return -1;
+        id[i] = (uint8_t) (hi << 4 | lo);
+    }
+    return 0;
+}
+
+// Copies fp to a temporary file, so that we can seek through it.
+FILE* spool(FILE* fp)
+{
+    uint8_t* buf = malloc(BUF_SIZE);
+    FILE* tmp = tmpfile();
+    if (buf == NULL || tmp == NULL)
+        XERR("cannot spool input");
+
+    size_t n;
+    while ((n = fread(buf, 1, BUF_SIZE, fp)) > 0)
+        XWRITE(tmp, buf, n);
+    if (ferror(fp))
+        XERR("fread()");
+    if (fflush(tmp) != 0 || fseeko(tmp, 0, SEEK_SET) != 0)
+        XERR("cannot spool input");
+    free(buf);
+    return tmp;
 
 error:
+    if (tmp != NULL) fclose(tmp);
+    free(buf);
     return NULL;
 }
 
-int sign(struct sign_ctx ctx)
+// Makes *input seekable, spooling it to *spooled if it is not, and
+// leaves it at the start.  *size is the size of the whole input.
+int open_seekable(FILE** input, FILE** spooled, off_t* size)
 {
     int rv = 1;
-    uint8_t pk      [32],
-            sig     [64],
-            b64_sig [B64_SIG_SIZE];
+    if (fseeko(*input, 0, SEEK_END) != 0) {
+        errno = 0; // not seekable, which is fine
+        *spooled = spool(*input);
+        if (*spooled == NULL)
+            goto error;
+        *input = *spooled;
+        if (fseeko(*input, 0, SEEK_END) != 0)
+            XERR("fseeko()");
+    }
+    *size = ftello(*input);
+    if (*size < 0)
+        XERR("ftello()");
+    if (fseeko(*input, 0, SEEK_SET) != 0)
+        XERR("fseeko()");
+    rv = 0;
 
-    size_t msg_size;
-    uint8_t* msg = fp_to_buf(ctx.input, &msg_size);
-    if (msg == NULL)
-        goto error;
+error:
+    return rv;
+}
 
-    crypto_sign_public_key(pk, ctx.sk);
-    crypto_sign(sig, ctx.sk, pk, msg, msg_size);
+// One pass of a streaming signature over the first size bytes of in.
+// The message is also hashed on the side, and copied to output if
+// output is not NULL.  in comes from in_open_buffered(), so that all
+// three see the same copy of each block.
+int sign_pass(struct input* in, off_t size, crypto_sign_ctx_abstract* sctx,
+              uint8_t digest[64], FILE* output)
+{
+    int rv = 1;
+    crypto_blake2b_ctx hctx;
+    const uint8_t* buf;
+    size_t n;
+    struct st_timer t;
+    if (in_rewind(in) != 0)
+        XERR("fseeko()");
+
+    crypto_blake2b_init(&hctx);
+    while (size > 0) {
+        size_t want = size > BUF_SIZE ? BUF_SIZE : (size_t) size;
+        if (in_next(in, &buf, &n, want) != 0 || n == 0)
+            XERR("fread()");
+        st_start(ST_HASH, &t);
+        crypto_sign_update(sctx, buf, n);
+        crypto_blake2b_update(&hctx, buf, n);
+        st_stop(ST_HASH, &t);
+        if (output != NULL)
+            XWRITE(output, buf, n);
+        size -= n;
+    }
+    crypto_blake2b_final(&hctx, digest);
+    rv = 0;
+
+error:
+    crypto_wipe(&hctx, sizeof(hctx));
+    return rv;
+}
+
+// Writes a detached signature, or the armor that ends an inline one
+int write_signature(FILE* output, const uint8_t sig[64], const uint8_t pk[32],
+                    int detached)
+{
+    int rv = 1;
+    uint8_t b64_sig [B64_SIG_SIZE],
+            id      [KEY_ID_SIZE],
+            line    [KEY_LINE_SIZE];
     b64_encode(b64_sig, sig, 64);
+    key_id(id, pk);
+    key_line(line, id);
 
-    if (ctx.detached) {
-        XWRITE(ctx.output, b64_sig, B64_SIG_SIZE);
+    if (detached) {
+        XWRITE(output, b64_sig, B64_SIG_SIZE);
+        XWRITE(output, (uint8_t *) "\n", 1);
+        XWRITE(output, line, KEY_LINE_SIZE);
     } else {
-        XWRITE(ctx.output, msg, msg_size);
-        XWRITE(ctx.output, (uint8_t *) SIG_ARMOR_TOP, strlen(SIG_ARMOR_TOP));
-        XWRITE(ctx.output, b64_sig, 44);
-        XWRITE(ctx.output, (uint8_t *) "\n", 1);
-        XWRITE(ctx.output, b64_sig + 44, 44);
-        XWRITE(ctx.output, (uint8_t *) SIG_ARMOR_END, strlen(SIG_ARMOR_END));
+        XWRITE(output, (uint8_t *) SIG_ARMOR_TOP, strlen(SIG_ARMOR_TOP));
+        XWRITE(output, line, KEY_LINE_SIZE);
+        XWRITE(output, b64_sig, 44);
+        XWRITE(output, (uint8_t *) "\n", 1);
+        XWRITE(output, b64_sig + 44, 44);
+        XWRITE(output, (uint8_t *) SIG_ARMOR_END, strlen(SIG_ARMOR_END));
     }
     rv = 0;
 
 error:
-    if (msg != NULL) free(msg);
     return rv;
 }
 
-int sig_from_file(FILE* fp, uint8_t *sig)
+// The public key and the hashed secret key are the same for every
+// message, so they are computed once and kept in ctx->first.
+void sign_setup(struct sign_ctx* ctx)
+{
+    crypto_sign_public_key(ctx->pk, ctx->sk);
+    crypto_sign_init_first_pass((crypto_sign_ctx_abstract*) &ctx->first,
+                                ctx->sk, ctx->pk);
+}
+
+int sign(struct sign_ctx ctx)
 {
     int rv = 1;
-    uint8_t b64_sig[B64_SIG_SIZE];
+    uint8_t sig     [64],
+            first   [64],
+            second  [64];
+    FILE* input = ctx.input;
+    FILE* spooled = NULL;
+    struct input in = { .map = NULL, .buf = NULL };
+    off_t msg_size;
+    crypto_sign_ctx_abstract* actx = (crypto_sign_ctx_abstract*) &ctx.first;
+
+    // EdDSA reads the message twice; pipes go through a temporary file.
+    // Not mapped: the nonce and the side digest must see the same bytes.
+    if (open_seekable(&input, &spooled, &msg_size) != 0)
+        goto error;
+    if (in_open_buffered(&in, input) != 0)
+        XERR("malloc()");
+
+    if (sign_pass(&in, msg_size, actx, first, NULL) != 0)
+        goto error;
+    crypto_sign_init_second_pass(actx);
+    if (sign_pass(&in, msg_size, actx, second,
+                  ctx.detached ? NULL : ctx.output) != 0)
+        goto error;
+    // Signing two different messages with the same nonce would reveal
+    // the secret key: never finish if the input changed under us.
+    if (crypto_verify64(first, second) != 0)
+        XERR("input changed while signing");
+    crypto_sign_final(actx, sig);
+    rv = write_signature(ctx.output, sig, ctx.pk, ctx.detached);
+
+error:
+    crypto_wipe(&ctx.first, sizeof(ctx.first));
+    crypto_wipe(ctx.sk, sizeof(ctx.sk));
+    in_close(&in);
+    if (spooled != NULL) fclose(spooled);
+    return rv;
+}
+
+int sig_from_file(FILE* fp, struct signature* s)
+{
+    int rv = 1;
+    uint8_t b64_sig[B64_SIG_SIZE],
+            line   [1 + KEY_LINE_SIZE];
 
     // read signature from ctx.sig
     XREAD(fp, b64_sig, B64_SIG_SIZE);
-    if (b64_validate(b64_sig, B64_SIG_SIZE) != 0
-            || b64_decoded_size(b64_sig, B64_SIG_SIZE) != 64)
+    if (b64_decoded_size(b64_sig, B64_SIG_SIZE) != 64
+            || b64_decode_checked(s->sig, b64_sig, B64_SIG_SIZE) != 0)
         XERR("malformed signature");
 
-    b64_decode(sig, b64_sig, B64_SIG_SIZE);
+    // older detached signatures end right after the base64
+    s->has_key_id = fread(line, 1, sizeof(line), fp) == sizeof(line)
+        && line[0] == '\n'
+        && parse_key_line(s->key_id, line + 1) == 0;
+    if (ferror(fp))
+        XERR("fread()");
     rv = 0;
 
 error:
     return rv;
 }
 
-int sig_from_buf(uint8_t* sig, size_t* new_buf_size, const uint8_t* buf, size_t buf_size)
+// tail points to the last tail_size bytes of a signed file.  Returns
+// the size of the armor found at the end, or 0 if there is none.
+size_t sig_from_armor(struct signature* s, const uint8_t* tail, size_t tail_size)
 {
-    #define TOP_SZ   (strlen(SIG_ARMOR_TOP))
-    #define SIG_SZ   (B64_SIG_SIZE + 1)
-    #define END_SZ   (strlen(SIG_ARMOR_END))
-    #define TOTAL_SZ (TOP_SZ + SIG_SZ + END_SZ)
-    #define TOP_PTR  (buf + buf_size - TOTAL_SZ)
-    #define SIG_PTR  (TOP_PTR + TOP_SZ)
-    #define END_PTR  (SIG_PTR + SIG_SZ)
-
+    const uint8_t* armor = tail + tail_size - ARMOR_SIZE;
+    const uint8_t* b64_ptr = armor + ARMOR_TOP_SIZE;
     uint8_t b64_sig[B64_SIG_SIZE];
+    size_t armor_size = ARMOR_SIZE;
 
-    if (buf_size < TOTAL_SZ
-            || memcmp(TOP_PTR, SIG_ARMOR_TOP, TOP_SZ) != 0
-            || memcmp(END_PTR, SIG_ARMOR_END, END_SZ) != 0
-            || SIG_PTR[44] != '\n')
-        return -1;
+    if (tail_size < ARMOR_SIZE
+            || memcmp(b64_ptr + B64_SIG_SIZE + 1, SIG_ARMOR_END, ARMOR_END_SIZE) != 0
+            || b64_ptr[44] != '\n')
+        return 0;
 
-    memcpy(b64_sig,      SIG_PTR,      44);
-    memcpy(b64_sig + 44, SIG_PTR + 45, 44);
-    if (b64_validate(b64_sig, B64_SIG_SIZE) != 0
-            || b64_decoded_size(b64_sig, B64_SIG_SIZE) != 64)
-        return -1;
-    b64_decode(sig, b64_sig, B64_SIG_SIZE);
-    *new_buf_size = buf_size - TOTAL_SZ;
-    return 0;
+    s->has_key_id = 0;
+    if (memcmp(armor, SIG_ARMOR_TOP, ARMOR_TOP_SIZE) != 0) {
+        armor = tail + tail_size - ID_ARMOR_SIZE;
+        if (tail_size < ID_ARMOR_SIZE
+                || memcmp(armor, SIG_ARMOR_TOP, ARMOR_TOP_SIZE) != 0
+                || parse_key_line(s->key_id, armor + ARMOR_TOP_SIZE) != 0)
+            return 0;
+        s->has_key_id = 1;
+        armor_size = ID_ARMOR_SIZE;
+    }
+
+    memcpy(b64_sig,      b64_ptr,      44);
+    memcpy(b64_sig + 44, b64_ptr + 45, 44);
+    if (b64_decoded_size(b64_sig, B64_SIG_SIZE) != 64
+            || b64_decode_checked(s->sig, b64_sig, B64_SIG_SIZE) != 0)
+        return 0;
+    return armor_size;
+}
 
-    #undef TOP_SZ
-    #undef SIG_SZ
-    #undef END_SZ
-    #undef TOTAL_SZ
-    #undef TOP_PTR
-    #undef SIG_PTR
-    #undef END_PTR
+// Keeps only the signers whose key matches the signature's fingerprint.
+// Signatures without one are checked against everybody.  Returns the
+// number of signers left.
+size_t filter_signers(struct signers* ss, const struct signature* s)
+{
+    if (!s->has_key_id)
+        return ss->size;
+    size_t kept = 0;
+    for (size_t i = 0; i < ss->size; i++) {
+        uint8_t id[KEY_ID_SIZE];
+        key_id(id, ss->list[i].pk);
+        if (memcmp(id, s->key_id, KEY_ID_SIZE) == 0) {
+            struct signer tmp = ss->list[kept];
+            ss->list[kept++] = ss->list[i];
+            ss->list[i] = tmp;
+        }
+    }
+    return kept;
+}
+
+// Streams the message (size bytes, or up to EOF if size < 0) through
+// one check context per signer.  Returns the index of the first signer
+// whose key checks the signature, -1 if none does, -2 on error.
+long check_stream(struct input* in, off_t size, const uint8_t* sig,
+                  const struct signers* ss)
+{
+    long rv = -2;
+    const uint8_t* buf;
+    size_t n;
+    struct st_timer t;
+    crypto_check_ctx* ctxs = calloc(ss->size ? ss->size : 1, sizeof(*ctxs));
+    if (ctxs == NULL)
+        XERR("malloc()");
+    st_add(ST_KEYS, ss->size);
+
+    for (size_t i = 0; i < ss->size; i++)
+        crypto_check_init((crypto_check_ctx_abstract*) &ctxs[i], sig, ss->list[i].pk);
+
+    // small steps, so that every context hashes data still in cache
+    while (size != 0) {
+        size_t want = size < 0 || size > BUF_SIZE ? BUF_SIZE : (size_t) size;
+        if (in_next(in, &buf, &n, want) != 0 || (n == 0 && size > 0))
+            XERR("fread()");
+        if (n == 0)
+            break;
+        st_start(ST_HASH, &t);
+        for (size_t i = 0; i < ss->size; i++)
+            crypto_check_update((crypto_check_ctx_abstract*) &ctxs[i], buf, n);
+        st_stop(ST_HASH, &t);
+        if (size > 0)
+            size -= n;
+    }
+
+    rv = -1;
+    for (size_t i = 0; i < ss->size; i++) {
+        if (crypto_check_final((crypto_check_ctx_abstract*) &ctxs[i]) == 0) {
+            rv = (long) i;
+            break;
+        }
+    }
+
+error:
+    free(ctxs);
+    return rv;
+}
+
+// Copies size bytes from the start of in to output
+int copy_message(struct input* in, off_t size, FILE* output)
+{
+    int rv = 1;
+    const uint8_t* buf;
+    size_t n;
+    if (in_rewind(in) != 0)
+        XERR("fseeko()");
+    while (size > 0) {
+        size_t want = size > IN_BUF_SIZE ? IN_BUF_SIZE : (size_t) size;
+        if (in_next(in, &buf, &n, want) != 0 || n == 0)
+            XERR("fread()");
+        XWRITE(output, buf, n);
+        size -= n;
+    }
+    rv = 0;
+
+error:
+    return rv;
+}
+
+// Reads the armor at the end of the size bytes of fp, which are then
+// cut down to the message.
+int armor_from_file(FILE* fp, off_t* size, struct signature* s)
+{
+    int rv = 1;
+    uint8_t tail[ID_ARMOR_SIZE];
+    size_t tail_size = *size < (off_t) ID_ARMOR_SIZE
+        ? (size_t) *size : ID_ARMOR_SIZE;
+    if (fseeko(fp, *size - (off_t) tail_size, SEEK_SET) != 0)
+        XERR("fseeko()");
+    XREAD(fp, tail, tail_size);
+    size_t armor_size = sig_from_armor(s, tail, tail_size);
+    if (armor_size == 0)
+        XERR("malformed signature");
+    *size -= armor_size;
+    if (fseeko(fp, 0, SEEK_SET) != 0)
+        XERR("fseeko()");
+    rv = 0;
+
+error:
+    return rv;
 }
 
 int verify(struct verify_ctx ctx)
 {
     int rv = 1;
-    uint8_t sig[64];
+    struct signature s;
+    FILE* input = ctx.input;
+    FILE* spooled = NULL;
+    struct input in = { .map = NULL, .buf = NULL };
+    off_t msg_size = -1; // up to EOF
+    struct signers ss = { NULL, 0 };
+    struct signer single;
 
-    size_t msg_size;
-    uint8_t *msg = fp_to_buf(ctx.input, &msg_size);
-    if (msg == NULL)
+    // The signature has to be known before the message is hashed: inline
+    // signatures are read from the end, and output is only written once
+    // the signature checks.  Both need a seekable input.
+    if ((!ctx.detached || ctx.stream_output)
+            && open_seekable(&input, &spooled, &msg_size) != 0)
         goto error;
 
     if (ctx.detached) {
-        if (sig_from_file(ctx.sig, sig) != 0)
+        if (sig_from_file(ctx.sig, &s) != 0)
             goto error;
-    } else {
-        if (sig_from_buf(sig, &msg_size, msg, msg_size) != 0)
-            XERR("malformed signature");
+    } else if (armor_from_file(input, &msg_size, &s) != 0) {
+        goto error;
     }
 
+    char* keyring_dir = getenv("ICHI_SIGN_KEYRING");
+    struct stat st;
+    int indexed = 0;
     if (ctx.keyring) {
-        rv = verify_keyring(&ctx, msg, msg_size, sig);
+        if (keyring_dir == NULL)
+            XERR("$ICHI_SIGN_KEYRING is unset");
+        if (stat(keyring_dir, &st) != 0)
+            XERR("stat()");
+        indexed = S_ISREG(st.st_mode);
+        if (indexed
+                ? load_index(&ss, keyring_dir, &s) != 0
+                : load_keyring(&ss, keyring_dir) != 0)
+            goto error;
     } else {
-        if (crypto_check(sig, ctx.pk, msg, msg_size) != 0)
-            XERR("invalid signature");
-        if (ctx.stream_output)
-            XWRITE(ctx.output, msg, msg_size);
+        single.name = ctx.pk_fn;
+        memcpy(single.pk, ctx.pk, 32);
+        ss.list = &single;
+        ss.size = 1;
+    }
+
+    // the stored size is kept so that every name is freed
+    struct signers candidates = { ss.list, filter_signers(&ss, &s) };
+    if (candidates.size == 0)
+        XERR("invalid signature");
+    if (in_open(&in, input) != 0)
+        XERR("malloc()");
+    long match = check_stream(&in, msg_size, s.sig, &candidates);
+    if (match == -2)
+        goto error;
+    if (match == -1)
+        XERR("invalid signature");
+    if (ctx.stream_output && copy_message(&in, msg_size, ctx.output) != 0)
+        goto error;
+
+    if (indexed)
+        ERR("good signature by '%s' in '%s'", ss.list[match].name, keyring_dir);
+    else if (ctx.keyring)
+        ERR("good signature by '%s%s%s'",
+            keyring_dir,
+            keyring_dir[strlen(keyring_dir)] == '/' ? "" : "/",
+            ss.list[match].name);
+    else
         ERR("good signature by '%s'", ctx.pk_fn);
-        rv = 0;
+    rv = 0;
+
+error:
+    if (ctx.keyring && ss.list != NULL) {
+        for (size_t i = 0; i < ss.size; i++)
+            free(ss.list[i].name);
+        free(ss.list);
     }
+    in_close(&in);
+    if (spooled != NULL) fclose(spooled);
+    return rv;
+}
+
+// Appends a copy of name and pk to ss, cap is the allocated size
+int add_signer(struct signers* ss, size_t* cap, const char* name, const uint8_t pk[32])
+{
+    int rv = 1;
+    if (ss->size == *cap) {
+        size_t new_cap = *cap ? 2 * *cap : 16;
+        struct signer* list = realloc(ss->list, new_cap * sizeof(*list));
+        if (list == NULL)
+            XERR("malloc()");
+        ss->list = list;
+        *cap = new_cap;
+    }
+    ss->list[ss->size].name = strdup(name);
+    if (ss->list[ss->size].name == NULL)
+        XERR("malloc()");
+    memcpy(ss->list[ss->size].pk, pk, 32);
+    ss->size++;
+    rv = 0;
 
 error:
-    if (msg != NULL) free(msg);
     return rv;
 }
 
-int verify_keyring(const struct verify_ctx* ctx,
-                   const uint8_t* msg, size_t msg_size,
-                   const uint8_t* sig)
+int load_keyring(struct signers* ss, const char* keyring_dir)
 {
     int rv = 1;
     int dir_fd;
-    DIR* dir = NULL;
-    char* keyring_dir = getenv("ICHI_SIGN_KEYRING");
-    if (keyring_dir == NULL)
-        XERR("$ICHI_SIGN_KEYRING is unset");
-
-    dir = opendir(keyring_dir);
+    DIR* dir = opendir(keyring_dir);
+    if (dir == NULL)
+        XERR("opendir()");
     dir_fd = dirfd(dir);
     if (dir_fd < 0)
         XERR("dirfd()");
 
     uint8_t b64_pk [B64_KEY_SIZE],
             pk     [32];
+    size_t cap = 0;
 
     struct dirent* entry;
     while ((entry = readdir(dir)) != NULL) {
@@ -254,26 +642,20 @@ int verify_keyring(const struct verify_ctx* ctx,
             int fd = openat(dir_fd, entry->d_name, O_RDONLY);
             if (fd < 0
                     || read(fd, b64_pk, B64_KEY_SIZE) < B64_KEY_SIZE
-                    || b64_validate(b64_pk, B64_KEY_SIZE) != 0
-                    || b64_decoded_size(b64_pk, B64_KEY_SIZE) != 32) {
+                    || b64_decoded_size(b64_pk, B64_KEY_SIZE) != 32
+                    || b64_decode_checked(pk, b64_pk, B64_KEY_SIZE) != 0) {
                 if (fd >= 0)
                     close(fd);
                 continue;
             }
             close(fd);
-            b64_decode(pk, b64_pk, B64_KEY_SIZE);
-            if (crypto_check(sig, pk, msg, msg_size) == 0) {
-                ERR("good signature by '%s%s%s'",
-                    keyring_dir,
-                    keyring_dir[strlen(keyring_dir)] == '/' ? "" : "/",
-                    entry->d_name);
-                if (ctx->stream_output)
-                    XWRITE(ctx->output, msg, msg_size);
-                rv = 0;
-                break;
-            }
+            if (add_signer(ss, &cap, entry->d_name, pk) != 0)
+                goto error;
         }
     }
+    // failed opens and short reads are skipped, not errors
+    errno = 0;
+    rv = 0;
 
 error:
     if (dir != NULL)
@@ -281,24 +663,529 @@ error:
     return rv;
 }
 
+// Public key bundles of `ichi-keygen -n -p`: one "NAME KEY" line each
+int load_bundle(struct signers* ss, const char* bundle_fn)
+{
+    int rv = 1;
+    char* line = NULL;
+    size_t cap = 0, ss_cap = 0, lineno = 0;
+    ssize_t n;
+    uint8_t pk[32];
+    FILE* fp = fopen(bundle_fn, "r");
+    if (fp == NULL)
+        XERR("fopen()");
+
+    while ((n = getline(&line, &cap, fp)) > 0) {
+        lineno++;
+        if (line[n - 1] == '\n')
+            line[--n] = '\0';
+        if (n < B64_KEY_SIZE + 2)
+            XERR("%s:%zu: malformed bundle", bundle_fn, lineno);
+        uint8_t* b64_pk = (uint8_t*) line + n - B64_KEY_SIZE;
+        if (b64_pk[-1] != ' '
+                || b64_decoded_size(b64_pk, B64_KEY_SIZE) != 32
+                || b64_decode_checked(pk, b64_pk, B64_KEY_SIZE) != 0)
+            XERR("%s:%zu: malformed bundle", bundle_fn, lineno);
+        b64_pk[-1] = '\0';
+        if (add_signer(ss, &ss_cap, line, pk) != 0)
+            goto error;
+    }
+    if (ferror(fp))
+        XERR("fread()");
+    errno = 0;
+    rv = 0;
+
+error:
+    free(line);
+    if (fp != NULL) fclose(fp);
+    return rv;
+}
+
+uint32_t load32_le(const uint8_t* in)
+{
+    return (uint32_t) in[0]
+        | ((uint32_t) in[1] << 8)
+        | ((uint32_t) in[2] << 16)
+        | ((uint32_t) in[3] << 24);
+}
+
+void store32_le(uint8_t* out, uint32_t in)
+{
+    out[0] = (in)       & 0xFF;
+    out[1] = (in >> 8)  & 0xFF;
+    out[2] = (in >> 16) & 0xFF;
+    out[3] = (in >> 24) & 0xFF;
+}
+
+// Loads the signers of index_fn that may have made s: the ones with the
+// same fingerprint, found by binary search, or all of them if s has none.
+int load_index(struct signers* ss, const char* index_fn, const struct signature* s)
+{
+    int rv = 1;
+    uint8_t* map = MAP_FAILED;
+    size_t map_size = 0;
+    size_t cap = 0;
+    struct stat st;
+    int fd = open(index_fn, O_RDONLY);
+    if (fd < 0)
+        XERR("open()");
+    if (fstat(fd, &st) != 0)
+        XERR("fstat()");
+    map_size = (size_t) st.st_size;
+    if (map_size < INDEX_HEADER_SIZE)
+        XERR("malformed keyring index");
+    map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED)
+        XERR("mmap()");
+
+    uint64_t count      = load32_le(map + 8),
+             names_size = load32_le(map + 12);
+    if (memcmp(map, INDEX_MAGIC, 8) != 0
+            || INDEX_HEADER_SIZE + count * INDEX_ENTRY_SIZE + names_size != map_size)
+        XERR("malformed keyring index");
+    const uint8_t* entries = map + INDEX_HEADER_SIZE;
+    const uint8_t* names = entries + count * INDEX_ENTRY_SIZE;
+
+    size_t lo = 0, hi = count;
+    if (s->has_key_id) {
+        // first entry not below the fingerprint
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (memcmp(entries + mid * INDEX_ENTRY_SIZE, s->key_id, KEY_ID_SIZE) < 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        hi = count;
+    }
+    for (size_t i = lo; i < hi; i++) {
+        const uint8_t* entry = entries + i * INDEX_ENTRY_SIZE;
+        if (s->has_key_id && memcmp(entry, s->key_id, KEY_ID_SIZE) != 0)
+            break;
+        uint64_t name_off = load32_le(entry + KEY_ID_SIZE + 32),
+                 name_len = load32_le(entry + KEY_ID_SIZE + 36);
+        if (name_off + name_len >= names_size || names[name_off + name_len] != 0)
+            XERR("malformed keyring index");
+        if (add_signer(ss, &cap, (const char*) names + name_off, entry + KEY_ID_SIZE) != 0)
+            goto error;
+    }
+    rv = 0;
+
+error:
+    if (map != MAP_FAILED)
+        munmap(map, map_size);
+    if (fd >= 0)
+        close(fd);
+    return rv;
+}
+
+struct index_entry {
+    uint8_t        key_id[KEY_ID_SIZE];
+    struct signer* signer;
+};
+
+int index_entry_cmp(const void* a, const void* b)
+{
+    const struct index_entry* x = a;
+    const struct index_entry* y = b;
+    int c = memcmp(x->key_id, y->key_id, KEY_ID_SIZE);
+    return c != 0 ? c : strcmp(x->signer->name, y->signer->name);
+}
+
+int compile_index(const char* keyring_dir, FILE* output)
+{
+    int rv = 1;
+    struct signers ss = { NULL, 0 };
+    struct index_entry* index = NULL;
+    uint8_t header[INDEX_HEADER_SIZE],
+            entry [INDEX_ENTRY_SIZE];
+
+    struct stat st;
+    if (stat(keyring_dir, &st) != 0)
+        XERR("stat()");
+    if (S_ISREG(st.st_mode)
+            ? load_bundle(&ss, keyring_dir) != 0
+            : load_keyring(&ss, keyring_dir) != 0)
+        goto error;
+    index = calloc(ss.size ? ss.size : 1, sizeof(*index));
+    if (index == NULL)
+        XERR("malloc()");
+
+    uint64_t names_size = 0;
+    for (size_t i = 0; i < ss.size; i++) {
+        key_id(index[i].key_id, ss.list[i].pk);
+        index[i].signer = &ss.list[i];
+        names_size += strlen(ss.list[i].name) + 1;
+    }
+    if (ss.size > UINT32_MAX || names_size > UINT32_MAX)
+        XERR("keyring too large");
+    qsort(index, ss.size, sizeof(*index), index_entry_cmp);
+
+    memcpy(header, INDEX_MAGIC, 8);
+    store32_le(header + 8,  (uint32_t) ss.size);
+    store32_le(header + 12, (uint32_t) names_size);
+    XWRITE(output, header, INDEX_HEADER_SIZE);
+
+    uint32_t name_off = 0;
+    for (size_t i = 0; i < ss.size; i++) {
+        uint32_t name_len = (uint32_t) strlen(index[i].signer->name);
+        memcpy(entry, index[i].key_id, KEY_ID_SIZE);
+        memcpy(entry + KEY_ID_SIZE, index[i].signer->pk, 32);
+        store32_le(entry + KEY_ID_SIZE + 32, name_off);
+        store32_le(entry + KEY_ID_SIZE + 36, name_len);
+        XWRITE(output, entry, INDEX_ENTRY_SIZE);
+        name_off += name_len + 1;
+    }
+    for (size_t i = 0; i < ss.size; i++)
+        XWRITE(output, (const uint8_t*) index[i].signer->name,
+               strlen(index[i].signer->name) + 1);
+    rv = 0;
+
+error:
+    for (size_t i = 0; i < ss.size; i++)
+        free(ss.list[i].name);
+    free(ss.list);
+    free(index);
+    return rv;
+}
+
 int trim(FILE* input, FILE* output)
 {
     int rv = 1;
-    size_t msg_size;
-    uint8_t* msg = fp_to_buf(input, &msg_size);
-    if (msg == NULL)
+    FILE* spooled = NULL;
+    struct input in = { .map = NULL, .buf = NULL };
+    struct signature s;
+    off_t msg_size;
+
+    if (open_seekable(&input, &spooled, &msg_size) != 0
+            || armor_from_file(input, &msg_size, &s) != 0)
         goto error;
+    if (in_open(&in, input) != 0)
+        XERR("malloc()");
+    if (copy_message(&in, msg_size, output) != 0)
+        goto error;
+    rv = 0;
+
+error:
+    in_close(&in);
+    if (spooled != NULL) fclose(spooled);
+    return rv;
+}
 
-    uint8_t tmp[64];
+// Manifests list the BLAKE2b-512 digest of files, one per line, in the
+// format of b2sum: 128 hex digits, two spaces and the path.  They are
+// signed inline like any other message.
+#define MANIFEST_HEX_SIZE (2 * 64)
 
-    if (sig_from_buf(tmp, &msg_size, msg, msg_size) != 0)
-        XERR("malformed signature");
+struct batch {
+    char**           files;
+    size_t           size;
+    uint8_t*         digests;  // 64 bytes per file
+    struct sign_ctx* sctx;     // when signing each file
+};
+
+// One path per line, empty lines ignored, - is stdin.
+int read_list(const char* fn, struct batch* b)
+{
+    int rv = 1;
+    char* line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    FILE* fp = strcmp(fn, "-") == 0 ? stdin : fopen(fn, "r");
+    if (fp == NULL)
+        XERR("fopen()");
+
+    while ((n = getline(&line, &cap, fp)) > 0) {
+        if (line[n - 1] == '\n')
+            line[--n] = '\0';
+        if (n == 0)
+            continue;
+        char** files = reallocarray(b->files, b->size + 1, sizeof(char*));
+        if (files == NULL)
+            XERR("malloc()");
+        b->files = files;
+        if ((b->files[b->size] = strdup(line)) == NULL)
+            XERR("malloc()");
+        b->size++;
+    }
+    if (ferror(fp))
+        XERR("fread()");
+    errno = 0;
+    rv = 0;
+
+error:
+    free(line);
+    if (fp != NULL && fp != stdin) fclose(fp);
+    return rv;
+}
+
+int hash_file(const char* fn, uint8_t digest[64])
+{
+    int rv = 1;
+    struct input in = { .map = NULL, .buf = NULL };
+    crypto_blake2b_ctx hctx;
+    const uint8_t* buf;
+    size_t n;
+    struct st_timer t;
+    FILE* fp = fopen(fn, "r");
+    if (fp == NULL)
+        XERR("cannot open '%s'", fn);
+    if (in_open(&in, fp) != 0)
+        XERR("malloc()");
+
+    crypto_blake2b_init(&hctx);
+    do {
+        if (in_next(&in, &buf, &n, IN_BUF_SIZE) != 0)
+            XERR("cannot read '%s'", fn);
+        st_start(ST_HASH, &t);
+        crypto_blake2b_update(&hctx, buf, n);
+        st_stop(ST_HASH, &t);
+    } while (n > 0);
+    crypto_blake2b_final(&hctx, digest);
+    rv = 0;
+
+error:
+    in_close(&in);
+    if (fp != NULL) fclose(fp);
+    return rv;
+}
+
+int hash_task(void* arg, size_t i)
+{
+    struct batch* b = arg;
+    errno = 0;
+    return hash_file(b->files[i], b->digests + 64 * i);
+}
+
+// Signs b->files[i] into b->files[i].sig
+int sign_task(void* arg, size_t i)
+{
+    int rv = 1;
+    struct batch* b = arg;
+    struct sign_ctx ctx = *b->sctx;
+    const char* fn = b->files[i];
+    char* sig_fn = malloc(strlen(fn) + sizeof(".sig"));
+    errno = 0;
+    ctx.input = NULL;
+    ctx.output = NULL;
+    if (sig_fn == NULL)
+        XERR("malloc()");
+    sprintf(sig_fn, "%s.sig", fn);
+
+    if ((ctx.input = fopen(fn, "r")) == NULL)
+        XERR("cannot open '%s'", fn);
+    if ((ctx.output = fopen(sig_fn, "w")) == NULL)
+        XERR("cannot open '%s'", sig_fn);
+    rv = sign(ctx);
+    if (fclose(ctx.output) != 0 && rv == 0)
+        rv = 1;
+    ctx.output = NULL;
+    if (rv != 0) {
+        ERR("cannot sign '%s'", fn);
+        unlink(sig_fn);
+    }
+
+error:
+    if (ctx.output != NULL) fclose(ctx.output);
+    if (ctx.input != NULL) fclose(ctx.input);
+    crypto_wipe(&ctx, sizeof(ctx));
+    free(sig_fn);
+    return rv;
+}
 
-    XWRITE(output, msg, msg_size);
+int sign_files(struct sign_ctx* ctx, struct batch* b, size_t jobs)
+{
+    b->sctx = ctx;
+    return pl_for(jobs, b->size, sign_task, b) == 0 ? 0 : 1;
+}
+
+int sign_manifest(struct sign_ctx ctx, struct batch* b, size_t jobs)
+{
+    int rv = 1;
+    static const char hex[] = "0123456789abcdef";
+    char line[MANIFEST_HEX_SIZE + 2];
+    FILE* manifest = tmpfile();
+    if (manifest == NULL)
+        XERR("tmpfile()");
+    for (size_t i = 0; i < b->size; i++)
+        if (strchr(b->files[i], '\n') != NULL)
+            XERR("cannot list '%s' in a manifest", b->files[i]);
+
+    b->digests = malloc(64 * (b->size ? b->size : 1));
+    if (b->digests == NULL)
+        XERR("malloc()");
+    if (pl_for(jobs, b->size, hash_task, b) != 0)
+        goto error;
+
+    for (size_t i = 0; i < b->size; i++) {
+        const uint8_t* digest = b->digests + 64 * i;
+        for (size_t k = 0; k < 64; k++) {
+            line[2*k]     = hex[digest[k] >> 4];
+            line[2*k + 1] = hex[digest[k] & 15];
+        }
+        line[MANIFEST_HEX_SIZE] = line[MANIFEST_HEX_SIZE + 1] = ' ';
+        XWRITE(manifest, (uint8_t*) line, sizeof(line));
+        XWRITE(manifest, (uint8_t*) b->files[i], strlen(b->files[i]));
+        XWRITE(manifest, (uint8_t*) "\n", 1);
+    }
+    if (fflush(manifest) != 0 || fseeko(manifest, 0, SEEK_SET) != 0)
+        XERR("cannot write manifest");
+
+    ctx.input = manifest;
+    ctx.detached = 0;
+    rv = sign(ctx);
+
+error:
+    crypto_wipe(&ctx, sizeof(ctx));
+    if (manifest != NULL) fclose(manifest);
+    return rv;
+}
+
+// Reads the lines of a checked manifest into b
+int parse_manifest(FILE* fp, struct batch* b)
+{
+    int rv = 1;
+    char* line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    size_t digests_cap = 0;
+
+    while ((n = getline(&line, &cap, fp)) > 0) {
+        if (line[n - 1] == '\n')
+            line[--n] = '\0';
+        if (n < MANIFEST_HEX_SIZE + 3
+                || line[MANIFEST_HEX_SIZE] != ' '
+                || line[MANIFEST_HEX_SIZE + 1] != ' ')
+            XERR("malformed manifest");
+
+        if (b->size == digests_cap) {
+            digests_cap = digests_cap ? 2 * digests_cap : 64;
+            char** files = reallocarray(b->files, digests_cap, sizeof(char*));
+            if (files != NULL)
+                b->files = files;
+            uint8_t* digests = reallocarray(b->digests, digests_cap, 64);
+            if (digests != NULL)
+                b->digests = digests;
+            if (files == NULL || digests == NULL)
+                XERR("malloc()");
+        }
+        uint8_t* digest = b->digests + 64 * b->size;
+        for (size_t k = 0; k < 64; k++) {
+            int hi = hex_digit(line[2*k]),
+                lo = hex_digit(line[2*k + 1]);
+            if (hi < 0 || lo < 0)
+                XERR("malformed manifest");
+            digest[k] = (uint8_t) (hi << 4 | lo);
+        }
+        if ((b->files[b->size] = strdup(line + MANIFEST_HEX_SIZE + 2)) == NULL)
+            XERR("malloc()");
+        b->size++;
+    }
+    if (ferror(fp))
+        XERR("fread()");
+    rv = 0;
+
+error:
+    free(line);
+    return rv;
+}
+
+int check_task(void* arg, size_t i)
+{
+    struct batch* b = arg;
+    uint8_t digest[64];
+    errno = 0;
+    if (hash_file(b->files[i], digest) != 0)
+        return -1;
+    if (crypto_verify64(digest, b->digests + 64 * i) != 0) {
+        ERR("'%s' does not match the manifest", b->files[i]);
+        return -1;
+    }
+    return 0;
+}
+
+// Checks the signature of the manifest, then every file it lists.
+int verify_manifest(struct verify_ctx ctx, size_t jobs)
+{
+    int rv = 1;
+    struct batch b = { NULL, 0, NULL, NULL };
+    FILE* manifest = tmpfile();
+    if (manifest == NULL)
+        XERR("tmpfile()");
+
+    ctx.output = manifest;
+    ctx.stream_output = 1;
+    if (verify(ctx) != 0)
+        goto error;
+    if (fflush(manifest) != 0 || fseeko(manifest, 0, SEEK_SET) != 0)
+        XERR("cannot read manifest");
+    if (parse_manifest(manifest, &b) != 0)
+        goto error;
+    if (pl_for(jobs, b.size, check_task, &b) != 0)
+        XERR("manifest check failed");
+    ERR("%zu files match the manifest", b.size);
+    rv = 0;
+
+error:
+    for (size_t i = 0; i < b.size; i++)
+        free(b.files[i]);
+    free(b.files);
+    free(b.digests);
+    if (manifest != NULL) fclose(manifest);
+    return rv;
+}
+
+// Signs through ichi-agent.  Inline signatures copy the message after
+// it was sent, so the input has to be seekable.
+int sign_with_agent(const char* agent, FILE* input, FILE* output, int detached)
+{
+    int rv = 1;
+    uint8_t result[64 + 32];
+    size_t result_size = sizeof(result);
+    FILE* spooled = NULL;
+    struct input in = { .map = NULL, .buf = NULL };
+    off_t msg_size;
+
+    if (!detached && open_seekable(&input, &spooled, &msg_size) != 0)
+        goto error;
+    if (ag_call("ichi-sign", agent, AG_SIGN, NULL, 0, input, NULL,
+                result, &result_size) != 0)
+        goto error;
+    if (result_size != sizeof(result))
+        XERR("malformed answer from agent");
+
+    if (!detached) {
+        if (fseeko(input, 0, SEEK_SET) != 0)
+            XERR("fseeko()");
+        if (in_open(&in, input) != 0)
+            XERR("malloc()");
+        if (copy_message(&in, msg_size, output) != 0)
+            goto error;
+    }
+    rv = write_signature(output, result, result + 64, detached);
+
+error:
+    in_close(&in);
+    if (spooled != NULL) fclose(spooled);
+    return rv;
+}
+
+// Checks a detached signature against the key of ichi-agent
+int verify_with_agent(const char* agent, struct verify_ctx ctx)
+{
+    int rv = 1;
+    struct signature s;
+    if (!ctx.detached)
+        XERR("-A needs a detached signature (-s)");
+    if (sig_from_file(ctx.sig, &s) != 0)
+        goto error;
+    if (ag_call("ichi-sign", agent, AG_VERIFY, s.sig, 64, ctx.input, NULL,
+                NULL, NULL) != 0)
+        goto error;
+    ERR("good signature by the key of agent '%s'", agent);
     rv = 0;
 
 error:
-    if (msg != NULL) free(msg);
     return rv;
 }
 
@@ -313,11 +1200,9 @@ int read_key_from_file(char* fn, uint8_t *key)
     if (_read(fp, b64_key, sizeof(b64_key)) != 0)
         XERR("fread()");
 
-    if (b64_validate(b64_key, sizeof(b64_key)) != 0
-            || b64_decoded_size(b64_key, sizeof(b64_key)) != 32)
+    if (b64_decoded_size(b64_key, sizeof(b64_key)) != 32
+            || b64_decode_checked(key, b64_key, sizeof(b64_key)) != 0)
         XERR("malformed key");
-
-    b64_decode(key, b64_key, sizeof(b64_key));
     rv = 0;
 
 error:
@@ -343,9 +1228,23 @@ int main(int argc, char** argv)
     vctx.keyring = 1;
     vctx.stream_output = 0;
 
-    int kflag = 0;
+    int kflag = 0,
+        mflag = 0;
+    char* index_dir = NULL;
+    char* list_fn = NULL;
+    char* agent = NULL;
+    char* end;
+    size_t jobs = 1;
+    struct batch batch = { NULL, 0, NULL, NULL };
+    static const struct option long_options[] = {
+        { "stats", no_argument, NULL, 'S' },
+        { NULL,    0,           NULL, 0   },
+    };
+    st_enable_from_env();
+
     int c;
-    while ((c = getopt(argc, argv, "ho:k:dVp:s:xT")) != -1)
+    while ((c = getopt_long(argc, argv, "ho:k:dVp:s:xTI:ml:j:A:",
+                            long_options, NULL)) != -1)
         switch (c) {
             default: goto error;
             case 'h':
@@ -389,7 +1288,54 @@ int main(int argc, char** argv)
             case 'T':
                 action = ACTION_TRIM;
                 break;
+            // keyring index
+            case 'I':
+                action = ACTION_INDEX;
+                index_dir = optarg;
+                break;
+            // batches
+            case 'm':
+                mflag = 1;
+                break;
+            case 'l':
+                list_fn = optarg;
+                break;
+            case 'A':
+                agent = optarg;
+                break;
+            case 'S':
+                st_enable();
+                break;
+            case 'j':
+                errno = 0;
+                jobs = strtoul(optarg, &end, 10);
+                if (errno != 0 || end == optarg || *end != '\0'
+                        || jobs < 1 || jobs > 256)
+                    XERR("invalid argument to -j");
+                break;
+        }
+
+    // several files to sign
+    int batched = action == ACTION_SIGN
+        && (mflag || list_fn != NULL || argc > optind + 1);
+    if (batched) {
+        if (list_fn != NULL && argc > optind)
+            XERR("invalid usage");
+        if (list_fn != NULL && read_list(list_fn, &batch) != 0)
+            goto error;
+        for (int i = optind; i < argc; i++) {
+            char** files = reallocarray(batch.files, batch.size + 1, sizeof(char*));
+            if (files == NULL)
+                XERR("malloc()");
+            batch.files = files;
+            if ((batch.files[batch.size] = strdup(argv[i])) == NULL)
+                XERR("malloc()");
+            batch.size++;
         }
+        if (!mflag && !sctx.detached)
+            XERR("several files need -m or -d");
+        optind = argc;
+    }
 
     if (argc > optind + 1) XERR("invalid usage");
     if (argc == optind + 1) {
@@ -401,28 +1347,50 @@ int main(int argc, char** argv)
     switch (action) {
         default: goto error;
         case ACTION_SIGN:
+            if (agent != NULL && !kflag && !batched) {
+                rv = sign_with_agent(agent, input, output, sctx.detached);
+                break;
+            }
             if (!kflag) {
                 ERR("no secret key specified");
                 goto error;
             }
             sctx.output = output;
             sctx.input = input;
-            rv = sign(sctx);
+            sign_setup(&sctx);
+            if (mflag)
+                rv = sign_manifest(sctx, &batch, jobs);
+            else if (batched)
+                rv = sign_files(&sctx, &batch, jobs);
+            else
+                rv = sign(sctx);
             break;
         case ACTION_VERIFY:
             vctx.output = output;
             vctx.input = input;
-            rv = verify(vctx);
+            if (agent != NULL && vctx.keyring && !mflag)
+                rv = verify_with_agent(agent, vctx);
+            else
+                rv = mflag ? verify_manifest(vctx, jobs) : verify(vctx);
             break;
         case ACTION_TRIM:
             rv = trim(input, output);
             break;
+        case ACTION_INDEX:
+            rv = compile_index(index_dir, output);
+            break;
     }
 
 error:
     WIPE_BUF(sctx.sk);
+    crypto_wipe(&sctx.first, sizeof(sctx.first));
+    for (size_t i = 0; i < batch.size; i++)
+        free(batch.files[i]);
+    free(batch.files);
+    free(batch.digests);
     if (vctx.sig != NULL) fclose(vctx.sig);
     if (output != NULL) fclose(output);
     if (input != NULL) fclose(input);
+    st_report(stderr, "ichi-sign");
     return rv;
 }
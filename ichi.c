@@ -0,0 +1,508 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ichi.h"
+#include "utils.h"
+
+#define WIPE_BUF(buf) crypto_wipe((buf), sizeof(buf))
+#define WIPE_CTX(ctx) crypto_wipe((ctx), sizeof(*(ctx)))
+
+typedef uint8_t u8;
+
+static const u8 HEAD_PARAMS = '%',
+                HEAD_PUBKEY = '@',
+                HEAD_TAGGED = '&',
+                HEAD_BLOCK  = 'B',
+                HEAD_DIGEST = '$';
+
+// Feeds a plaintext chunk to the stream digest, for LS_DIGEST_TREE
+// (plain BLAKE2b streams hash the plaintext as it comes).
+static void hash_chunk(crypto_blake2b_ctx *hash,
+                       const struct ls_stream_params *params,
+                       const u8 *chunk, size_t size)
+{
+    u8 digest[64];
+    if (params->digest != LS_DIGEST_TREE)
+        return;
+    ls_chunk_digest(digest, chunk, size);
+    crypto_blake2b_update(hash, digest, 64);
+    WIPE_BUF(digest);
+}
+
+// framing around a chunk of plaintext + 1 bytes
+static size_t chunk_overhead(const struct ls_stream_params *params)
+{
+    return params->version == LS_VERSION_FAST   ? 4 + 16
+         : params->version == LS_VERSION_LEGACY ? 16 + 2 + 16
+         :                                        16 + 4 + 16;
+}
+
+
+//
+// Encryption
+//
+int ichi_lock_setup(ichi_lock_ctx *ctx,
+                    const u8 *sk,
+                    const u8  recp[][32], size_t nrecp,
+                    int tagged,
+                    const struct ls_stream_params *params)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    if (nrecp == 0 || nrecp > ICHI_RECEPIENTS_MAX
+            || ls_stream_verify(params) != 0
+            || params->version == LS_VERSION_LEGACY
+            || params->compression != LS_COMPRESSION_NONE)
+        return -1;
+
+    ctx->params     = *params;
+    ctx->chunk_size = ls_chunk_size(params);
+    ctx->tagged     = tagged;
+    ctx->ephemeral  = sk == NULL;
+    ctx->nrecp      = nrecp;
+    memcpy(ctx->recp, recp, 32 * nrecp);
+    if (!ctx->ephemeral) {
+        memcpy(ctx->sk, sk, 32);
+        crypto_key_exchange_public_key(ctx->pk, ctx->sk);
+        for (size_t i = 0; i < nrecp; i++)
+            ls_kx_shared(ctx->shared[i], ctx->sk, ctx->recp[i]);
+    }
+
+    ctx->chunk = malloc(1 + ctx->chunk_size);
+    if (ctx->chunk == NULL) {
+        ichi_lock_free(ctx);
+        return -1;
+    }
+    return 0;
+}
+
+int ichi_lock_clone(ichi_lock_ctx *dst, const ichi_lock_ctx *src)
+{
+    memcpy(dst, src, sizeof(*dst));
+    dst->chunk = malloc(1 + dst->chunk_size);
+    if (dst->chunk == NULL) {
+        WIPE_CTX(dst);
+        return -1;
+    }
+    return 0;
+}
+
+void ichi_lock_free(ichi_lock_ctx *ctx)
+{
+    _free(ctx->chunk, 1 + ctx->chunk_size);
+    WIPE_CTX(ctx);
+}
+
+size_t ichi_lock_init(ichi_lock_ctx *ctx, u8 *out)
+{
+    u8 *p = out;
+    ctx->err   = 0;
+    ctx->index = 0;
+    ctx->have  = 0;
+
+    if (_random(ctx->nonce, 24) != 0 || _random(ctx->key, 32) != 0)
+        goto error;
+    if (ctx->ephemeral) {
+        if (_random(ctx->sk, 32) != 0)
+            goto error;
+        crypto_key_exchange_public_key(ctx->pk, ctx->sk);
+        for (size_t i = 0; i < ctx->nrecp; i++)
+            ls_kx_shared(ctx->shared[i], ctx->sk, ctx->recp[i]);
+    }
+
+    memcpy(p, ctx->nonce, 24);                   p += 24;
+    *p++ = HEAD_PARAMS;
+    p   += ls_stream_encode(p, &ctx->params);
+    *p++ = ctx->tagged ? HEAD_TAGGED : HEAD_PUBKEY;
+    memcpy(p, ctx->pk, 32);                      p += 32;
+    *p++ = ctx->nrecp & 0xFF;
+    for (size_t i = 0; i < ctx->nrecp; i++) {
+        if (ctx->tagged) {
+            ls_kx_wrap_tagged(p, ctx->shared[i], ctx->key, ctx->nonce);
+            p += 8 + 48;
+        } else {
+            ls_kx_wrap(p, ctx->shared[i], ctx->key);
+            p += 48;
+        }
+    }
+
+    if (ctx->params.version == LS_VERSION_FAST)
+        ls_fast_init(&ctx->fast, ctx->key, ctx->nonce);
+    crypto_blake2b_init(&ctx->hash);
+    ctx->chunk[0] = HEAD_BLOCK;
+    return p - out;
+
+error:
+    ctx->err = 1;
+    return 0;
+}
+
+// Locks ctx->chunk[0..size] into out, returns the ciphertext size
+static size_t lock_chunk(ichi_lock_ctx *ctx, u8 *out, const u8 *chunk, size_t size)
+{
+    uint64_t index = ctx->index++;
+    if (ctx->params.version == LS_VERSION_FAST) {
+        ls_fast_lock(&ctx->fast, out, index, chunk, size);
+        return 20 + size;
+    }
+    ls_lock_at(out, ctx->nonce, ctx->key, index, chunk, size);
+    return 36 + size;
+}
+
+// Whatever is buffered: up to chunk_size - 1 bytes can be waiting
+size_t ichi_lock_update_size(const ichi_lock_ctx *ctx, size_t in_size)
+{
+    size_t chunks = (ctx->chunk_size - 1 + in_size) / ctx->chunk_size;
+    return chunks * (chunk_overhead(&ctx->params) + 1 + ctx->chunk_size);
+}
+
+size_t ichi_lock_update(ichi_lock_ctx *ctx, u8 *out,
+                        const u8 *in, size_t in_size)
+{
+    size_t written = 0;
+    if (ctx->err)
+        return 0;
+    while (in_size > 0) {
+        size_t take = ctx->chunk_size - ctx->have;
+        if (take > in_size)
+            take = in_size;
+        memcpy(ctx->chunk + 1 + ctx->have, in, take);
+        if (ctx->params.digest == LS_DIGEST_BLAKE2B)
+            crypto_blake2b_update(&ctx->hash, in, take);
+        ctx->have += take;
+        in        += take;
+        in_size   -= take;
+        // only the last chunk of a message may be short
+        if (ctx->have == ctx->chunk_size) {
+            hash_chunk(&ctx->hash, &ctx->params, ctx->chunk + 1, ctx->have);
+            written += lock_chunk(ctx, out + written, ctx->chunk, 1 + ctx->have);
+            ctx->have = 0;
+        }
+    }
+    return written;
+}
+
+size_t ichi_lock_final_size(const ichi_lock_ctx *ctx)
+{
+    size_t overhead = chunk_overhead(&ctx->params);
+    return overhead + ctx->chunk_size  // last chunk, at most chunk_size - 1
+         + overhead + 1 + 64;
+}
+
+size_t ichi_lock_final(ichi_lock_ctx *ctx, u8 *out)
+{
+    u8 digest[1 + 64];
+    size_t written = 0;
+    if (ctx->err)
+        return 0;
+    if (ctx->have > 0) {
+        hash_chunk(&ctx->hash, &ctx->params, ctx->chunk + 1, ctx->have);
+        written += lock_chunk(ctx, out, ctx->chunk, 1 + ctx->have);
+    }
+
+    digest[0] = HEAD_DIGEST;
+    crypto_blake2b_final(&ctx->hash, digest + 1);
+    written += lock_chunk(ctx, out + written, digest, sizeof(digest));
+
+    ctx->have = 0;
+    crypto_wipe(ctx->chunk, 1 + ctx->chunk_size);
+    WIPE_BUF(ctx->key);
+    WIPE_CTX(&ctx->fast);
+    WIPE_BUF(digest);
+    if (ctx->ephemeral) {
+        WIPE_BUF(ctx->sk);
+        WIPE_BUF(ctx->shared);
+    }
+    return written;
+}
+
+int ichi_lock_err(const ichi_lock_ctx *ctx)
+{
+    return ctx->err;
+}
+
+
+//
+// Decryption
+//
+enum {
+    U_NONCE,
+    U_MODE,
+    U_PARAMS_SIZE,
+    U_PARAMS,
+    U_SENDER,
+    U_SLOT,
+    U_HEAD,
+    U_BODY,
+    U_DONE,
+};
+
+// room for the largest chunk of the stream, grown once if needed
+static int unlock_reserve(ichi_unlock_ctx *ctx, size_t size)
+{
+    if (ctx->buf_cap >= size)
+        return 0;
+    u8 *buf = malloc(size);
+    if (buf == NULL)
+        return -1;
+    if (ctx->have > 0)
+        memcpy(buf, ctx->buf, ctx->have);
+    _free(ctx->buf, ctx->buf_cap);
+    ctx->buf     = buf;
+    ctx->buf_cap = size;
+    return 0;
+}
+
+static size_t chunk_cap(size_t chunk_size)
+{
+    return 4 + 16 + 1 + chunk_size + 16;
+}
+
+int ichi_unlock_setup(ichi_unlock_ctx *ctx,
+                      const u8 sk[32],
+                      const u8 *verify_sender)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    memcpy(ctx->sk, sk, 32);
+    crypto_key_exchange_public_key(ctx->pk, sk);
+    if (verify_sender != NULL) {
+        ctx->verify = 1;
+        memcpy(ctx->verify_pk, verify_sender, 32);
+    }
+    if (unlock_reserve(ctx, chunk_cap((size_t) 1 << LS_CHUNK_SHIFT_DEFAULT)) != 0) {
+        ichi_unlock_free(ctx);
+        return -1;
+    }
+    ichi_unlock_init(ctx);
+    return 0;
+}
+
+int ichi_unlock_clone(ichi_unlock_ctx *dst, const ichi_unlock_ctx *src)
+{
+    memcpy(dst, src, sizeof(*dst));
+    dst->buf     = NULL;
+    dst->buf_cap = 0;
+    if (unlock_reserve(dst, src->buf_cap) != 0) {
+        WIPE_CTX(dst);
+        return -1;
+    }
+    ichi_unlock_init(dst);
+    return 0;
+}
+
+void ichi_unlock_free(ichi_unlock_ctx *ctx)
+{
+    _free(ctx->buf, ctx->buf_cap);
+    WIPE_CTX(ctx);
+}
+
+void ichi_unlock_init(ichi_unlock_ctx *ctx)
+{
+    ctx->state              = U_NONCE;
+    ctx->need               = 24;
+    ctx->have               = 0;
+    ctx->err                = 0;
+    ctx->seen_params        = 0;
+    ctx->found              = 0;
+    ctx->index              = 0;
+    ctx->params.version     = LS_VERSION_LEGACY;
+    ctx->params.chunk_shift = LS_CHUNK_SHIFT_DEFAULT;
+    ctx->chunk_size         = ls_chunk_size(&ctx->params);
+    crypto_blake2b_init(&ctx->hash);
+}
+
+// Every chunk decrypts to less than it takes in, but may complete one
+// that is already buffered
+size_t ichi_unlock_update_size(const ichi_unlock_ctx *ctx, size_t in_size)
+{
+    return ctx->have + in_size;
+}
+
+static size_t head_size(const ichi_unlock_ctx *ctx)
+{
+    return ctx->params.version == LS_VERSION_FAST   ? 4
+         : ctx->params.version == LS_VERSION_LEGACY ? 16 + 2
+         :                                            16 + 4;
+}
+
+// Handles the field that has just been read into ctx->buf.
+// Returns the number of plaintext bytes written to out, sets ctx->err
+// on failure.
+static size_t unlock_step(ichi_unlock_ctx *ctx, u8 *out)
+{
+    size_t length, written = 0;
+    u8 *buf = ctx->buf;
+
+    switch (ctx->state) {
+    case U_NONCE:
+        memcpy(ctx->nonce, buf, 24);
+        ctx->state = U_MODE;
+        ctx->need  = 1;
+        break;
+    case U_MODE:
+        if (buf[0] == HEAD_PARAMS && !ctx->seen_params) {
+            ctx->state = U_PARAMS_SIZE;
+            ctx->need  = 1;
+        } else if (buf[0] == HEAD_PUBKEY || buf[0] == HEAD_TAGGED) {
+            ctx->tagged = buf[0] == HEAD_TAGGED;
+            ctx->state  = U_SENDER;
+            ctx->need   = 32 + 1;
+        } else {
+            // HEAD_PDKF, or garbage
+            goto error;
+        }
+        break;
+    case U_PARAMS_SIZE:
+        if (buf[0] >= LS_STREAM_MAX)
+            goto error;
+        ctx->state = U_PARAMS;
+        ctx->need  = buf[0];
+        break;
+    case U_PARAMS:
+        if (ls_stream_decode(buf, ctx->need, &ctx->params) != 0
+                || ls_stream_verify(&ctx->params) != 0
+                || ctx->params.compression != LS_COMPRESSION_NONE)
+            goto error;
+        ctx->chunk_size  = ls_chunk_size(&ctx->params);
+        ctx->seen_params = 1;
+        ctx->state       = U_MODE;
+        ctx->need        = 1;
+        if (unlock_reserve(ctx, chunk_cap(ctx->chunk_size)) != 0)
+            goto error;
+        break;
+    case U_SENDER:
+        if (ctx->verify && crypto_verify32(ctx->verify_pk, buf) != 0)
+            goto error;
+        if (!ctx->has_shared || crypto_verify32(ctx->sender, buf) != 0) {
+            memcpy(ctx->sender, buf, 32);
+            ls_kx_shared(ctx->shared, ctx->sk, ctx->sender);
+            ctx->has_shared = 1;
+        }
+        ls_kx_tag(ctx->tag, ctx->shared, ctx->nonce);
+        ctx->nrecp = buf[32];
+        if (ctx->nrecp == 0)
+            goto error;
+        ctx->state = U_SLOT;
+        ctx->need  = ctx->tagged ? 8 + 48 : 48;
+        break;
+    case U_SLOT:
+        if (!ctx->found && ctx->tagged)
+            ctx->found = memcmp(buf, ctx->tag, 8) == 0
+                && ls_kx_unwrap(buf + 8, ctx->key, ctx->shared) == 0;
+        else if (!ctx->found)
+            ctx->found = ls_kx_unwrap(buf, ctx->key, ctx->shared) == 0;
+        if (--ctx->nrecp > 0)
+            break;
+        if (!ctx->found)
+            goto error;
+        if (ctx->params.version == LS_VERSION_FAST)
+            ls_fast_init(&ctx->fast, ctx->key, ctx->nonce);
+        ctx->state = U_HEAD;
+        ctx->need  = head_size(ctx);
+        break;
+    case U_HEAD:
+        if ((ctx->params.version == LS_VERSION_FAST
+             ? ls_fast_unlock_length(&ctx->fast, &length, ctx->index, buf)
+             : ctx->params.version == LS_VERSION_LEGACY
+             ? ls_unlock_length(&length, ctx->nonce, ctx->key, buf)
+             : ls_unlock_length_at(&length, ctx->nonce, ctx->key, ctx->index, buf)) != 0
+                || length < 1 || length > ctx->chunk_size + 1)
+            goto error;
+        ctx->state = U_BODY;
+        if (ctx->params.version == LS_VERSION_FAST) {
+            // the length is authenticated along with the payload
+            ctx->need = 4 + length + 16;
+            return 0;
+        }
+        ctx->need = 16 + length;
+        break;
+    case U_BODY: {
+        u8 *pt;
+        if (ctx->params.version == LS_VERSION_FAST) {
+            length = ctx->need - 4 - 16;
+            pt     = buf + LS_HEAD_FAST;
+            if (ls_fast_unlock_inplace(&ctx->fast, buf, ctx->index, length) != 0)
+                goto error;
+        } else {
+            length = ctx->need - 16;
+            pt     = buf + LS_PAYLOAD_HEAD;
+            if ((ctx->params.version == LS_VERSION_LEGACY
+                 ? ls_unlock_payload_inplace(buf, ctx->nonce, ctx->key, length)
+                 : ls_unlock_payload_at_inplace(buf, ctx->nonce, ctx->key,
+                                                ctx->index, length)) != 0)
+                goto error;
+        }
+        ctx->index++;
+        if (pt[0] == HEAD_BLOCK) {
+            if (ctx->params.digest == LS_DIGEST_BLAKE2B)
+                crypto_blake2b_update(&ctx->hash, pt + 1, length - 1);
+            hash_chunk(&ctx->hash, &ctx->params, pt + 1, length - 1);
+            memcpy(out, pt + 1, length - 1);
+            written = length - 1;
+            ctx->state = U_HEAD;
+            ctx->need  = head_size(ctx);
+        } else if (pt[0] == HEAD_DIGEST && length == 1 + 64) {
+            u8 digest[64];
+            crypto_blake2b_final(&ctx->hash, digest);
+            int ok = crypto_verify64(digest, pt + 1) == 0;
+            WIPE_BUF(digest);
+            if (!ok)
+                goto error;
+            ctx->state = U_DONE;
+            ctx->need  = 0;
+        } else {
+            goto error;
+        }
+        crypto_wipe(pt, length);
+        break;
+    }
+    default:
+        goto error;
+    }
+    ctx->have = 0;
+    return written;
+
+error:
+    ctx->err = 1;
+    return 0;
+}
+
+size_t ichi_unlock_update(ichi_unlock_ctx *ctx, u8 *out,
+                          const u8 *in, size_t in_size)
+{
+    size_t written = 0;
+    while (!ctx->err) {
+        if (ctx->state == U_DONE) {
+            if (in_size > 0)
+                ctx->err = 1; // expected EOF
+            break;
+        }
+        if (ctx->have == ctx->need) {
+            written += unlock_step(ctx, out + written);
+            continue;
+        }
+        if (in_size == 0)
+            break;
+        size_t take = ctx->need - ctx->have;
+        if (take > in_size)
+            take = in_size;
+        memcpy(ctx->buf + ctx->have, in, take);
+        ctx->have += take;
+        in        += take;
+        in_size   -= take;
+    }
+    return written;
+}
+
+int ichi_unlock_final(ichi_unlock_ctx *ctx)
+{
+    int rv = ctx->err || ctx->state != U_DONE ? -1 : 0;
+    WIPE_BUF(ctx->key);
+    WIPE_CTX(&ctx->fast);
+    WIPE_CTX(&ctx->hash);
+    ctx->err = rv != 0;
+    return rv;
+}
+
+int ichi_unlock_err(const ichi_unlock_ctx *ctx)
+{
+    return ctx->err;
+}
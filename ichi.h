@@ -0,0 +1,132 @@
+#ifndef ICHI_H
+#define ICHI_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "monocypher/monocypher.h"
+#include "lock_stream.h"
+
+// libichi: lock streams in memory, one message after another.
+//
+// Contexts are set up once and reused for every message; after setup,
+// nothing is allocated.  Each message goes through init/update/final,
+// like the base64 incremental interface: output buffers are provided
+// by the caller, sized with the *_size functions, and errors stick to
+// the context until the next init.
+//
+// Only KX mode ('@' and '&') streams are handled: password streams
+// spend their time in Argon2i, not in process startup.  Compressed
+// streams (`ichi-lock -z`) are not handled either: a chunk may inflate
+// to more than it takes in, so output could not be sized up front.
+
+#define ICHI_RECEPIENTS_MAX 255
+// upper bound on what ichi_lock_init() writes
+#define ICHI_LOCK_HEADER_MAX (24 + 1 + LS_STREAM_MAX + 1 + 32 + 1 \
+                              + ICHI_RECEPIENTS_MAX * (8 + 48))
+
+//
+// Encryption
+//
+typedef struct {
+    struct ls_stream_params params;
+    size_t   chunk_size;
+    int      tagged;
+    int      ephemeral; // new sender key for every message
+    uint8_t  sk[32];
+    uint8_t  pk[32];
+    size_t   nrecp;
+    uint8_t  recp  [ICHI_RECEPIENTS_MAX][32];
+    uint8_t  shared[ICHI_RECEPIENTS_MAX][32];
+
+    // current message
+    uint8_t  nonce[24];
+    uint8_t  key  [32];
+    struct ls_fast_ctx fast;
+    crypto_blake2b_ctx hash;
+    uint64_t index;
+    uint8_t *chunk;     // 'B' + pending plaintext
+    size_t   have;
+    int      err;
+} ichi_lock_ctx;
+
+// With sk == NULL, every message gets a new random sender key, at the
+// cost of one key exchange per recepient and message.  With a sender
+// key, the shared keys are computed once here.  The key wrapping nonce
+// is fixed by the format, so as with `ichi-lock -k`, the wrapped keys
+// of a sender and recepient pair share a keystream; prefer a NULL sk
+// unless the recepients verify the sender.
+// params must be an uncompressed indexed or fast stream.  Returns 0 on
+// success.
+int    ichi_lock_setup(ichi_lock_ctx *ctx,
+                       const uint8_t *sk,
+                       const uint8_t  recp[][32], size_t nrecp,
+                       int tagged,
+                       const struct ls_stream_params *params);
+// A context set up like src, for another thread: no key exchange.
+int    ichi_lock_clone(ichi_lock_ctx *dst, const ichi_lock_ctx *src);
+void   ichi_lock_free(ichi_lock_ctx *ctx);
+
+// Starts a message and writes its header: at most ICHI_LOCK_HEADER_MAX.
+size_t ichi_lock_init(ichi_lock_ctx *ctx, uint8_t *out);
+// Bounds that do not depend on what the context holds: a buffer sized
+// once for the largest update (and the final call) fits every message.
+size_t ichi_lock_update_size(const ichi_lock_ctx *ctx, size_t in_size);
+size_t ichi_lock_update(ichi_lock_ctx *ctx, uint8_t *out,
+                        const uint8_t *in, size_t in_size);
+size_t ichi_lock_final_size(const ichi_lock_ctx *ctx);
+size_t ichi_lock_final(ichi_lock_ctx *ctx, uint8_t *out);
+int    ichi_lock_err(const ichi_lock_ctx *ctx);
+
+//
+// Decryption
+//
+typedef struct {
+    uint8_t  sk[32];
+    uint8_t  pk[32];
+    int      verify;     // only accept streams from verify_pk
+    uint8_t  verify_pk[32];
+    uint8_t  sender[32]; // shared key with the last sender, see below
+    uint8_t  shared[32];
+    int      has_shared;
+
+    // current message
+    int      state;
+    int      seen_params;
+    int      tagged;
+    int      found;
+    struct ls_stream_params params;
+    size_t   chunk_size;
+    size_t   nrecp;
+    uint8_t  tag  [8];
+    uint8_t  nonce[24];
+    uint8_t  key  [32];
+    struct ls_fast_ctx fast;
+    crypto_blake2b_ctx hash;
+    uint64_t index;
+    uint8_t *buf;        // the header field or chunk being read
+    size_t   buf_cap;
+    size_t   have;
+    size_t   need;
+    int      err;
+} ichi_unlock_ctx;
+
+// verify_sender may be NULL.  The shared key with the last sender is
+// kept, so that messages from a static sender skip the key exchange.
+int    ichi_unlock_setup(ichi_unlock_ctx *ctx,
+                         const uint8_t sk[32],
+                         const uint8_t *verify_sender);
+int    ichi_unlock_clone(ichi_unlock_ctx *dst, const ichi_unlock_ctx *src);
+void   ichi_unlock_free(ichi_unlock_ctx *ctx);
+
+void   ichi_unlock_init(ichi_unlock_ctx *ctx);
+// Depends on the ciphertext buffered so far, and on the chunk size of
+// the stream once its header is read: call it before every update.
+size_t ichi_unlock_update_size(const ichi_unlock_ctx *ctx, size_t in_size);
+// Plaintext is released one authenticated chunk at a time; it is only
+// known to be complete once ichi_unlock_final() succeeds.
+size_t ichi_unlock_update(ichi_unlock_ctx *ctx, uint8_t *out,
+                          const uint8_t *in, size_t in_size);
+// 0 if the whole stream, digest included, checked out.
+int    ichi_unlock_final(ichi_unlock_ctx *ctx);
+int    ichi_unlock_err(const ichi_unlock_ctx *ctx);
+#endif
@@ -0,0 +1,219 @@
+// Drives libichi from the shell, for test_lock.sh: input is fed in
+// pieces of odd sizes, and one context is reused for every file.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "base64/base64.h"
+#include "ichi.h"
+#include "utils.h"
+
+#define ERR(...)      _err("libichi_test", __VA_ARGS__)
+#define XERR(...)     do { ERR(__VA_ARGS__); goto error; } while (0)
+#define B64_KEY_SIZE  44
+
+static const char *HELP =
+    "usage:\n"
+    "  libichi_test -E [-k SK] [-t] [-f] [-d] -r RECP... OUTPUT...\n"
+    "  libichi_test -D -k SK [-v SENDER] INPUT...\n"
+    "\n"
+    "-E encrypts stdin once into each OUTPUT, -D decrypts every INPUT\n"
+    "to stdout.  -d ends streams with a tree digest.\n";
+
+static const size_t PIECES[] = { 1, 3, 1000, 4096, 70000, 17 };
+#define NPIECES (sizeof(PIECES) / sizeof(PIECES[0]))
+
+static int read_key(const char *fn, uint8_t key[32])
+{
+    int rv = 1;
+    uint8_t b64[B64_KEY_SIZE];
+    FILE *fp = fopen(fn, "r");
+    if (fp == NULL)
+        XERR("fopen()");
+    if (_read(fp, b64, sizeof(b64)) != 0
+            || b64_decoded_size(b64, sizeof(b64)) != 32
+            || b64_decode_checked(key, b64, sizeof(b64)) != 0)
+        XERR("invalid key '%s'", fn);
+    rv = 0;
+
+error:
+    if (fp != NULL) fclose(fp);
+    return rv;
+}
+
+static uint8_t *read_all(FILE *fp, size_t *size)
+{
+    size_t cap = 1 << 16;
+    uint8_t *buf = malloc(cap);
+    *size = 0;
+    while (buf != NULL) {
+        *size += fread(buf + *size, 1, cap - *size, fp);
+        if (ferror(fp) || feof(fp))
+            break;
+        uint8_t *grown = realloc(buf, 2 * cap);
+        if (grown == NULL)
+            free(buf);
+        buf = grown;
+        cap *= 2;
+    }
+    if (buf != NULL && ferror(fp)) {
+        free(buf);
+        buf = NULL;
+    }
+    return buf;
+}
+
+static int encrypt(ichi_lock_ctx *ctx, const uint8_t *msg, size_t size,
+                   const char *fn)
+{
+    int rv = 1;
+    uint8_t *out = NULL;
+    FILE *fp = fopen(fn, "w");
+    if (fp == NULL)
+        XERR("fopen()");
+    out = malloc(ICHI_LOCK_HEADER_MAX + ichi_lock_update_size(ctx, 70000)
+                 + ichi_lock_final_size(ctx));
+    if (out == NULL)
+        XERR("malloc()");
+
+    size_t n = ichi_lock_init(ctx, out);
+    if (_write(fp, out, n) != 0)
+        XERR("fwrite()");
+    for (size_t i = 0, off = 0; off < size; i++) {
+        size_t piece = PIECES[i % NPIECES];
+        if (piece > size - off)
+            piece = size - off;
+        n = ichi_lock_update(ctx, out, msg + off, piece);
+        if (_write(fp, out, n) != 0)
+            XERR("fwrite()");
+        off += piece;
+    }
+    n = ichi_lock_final(ctx, out);
+    if (ichi_lock_err(ctx) || _write(fp, out, n) != 0)
+        XERR("cannot encrypt");
+    rv = 0;
+
+error:
+    free(out);
+    if (fp != NULL) fclose(fp);
+    return rv;
+}
+
+static int decrypt(ichi_unlock_ctx *ctx, const char *fn)
+{
+    int rv = 1;
+    size_t size;
+    uint8_t *msg = NULL, *out = NULL;
+    FILE *fp = fopen(fn, "r");
+    if (fp == NULL)
+        XERR("fopen()");
+    msg = read_all(fp, &size);
+    out = malloc(size + 1); // never more plaintext than ciphertext
+    if (msg == NULL || out == NULL)
+        XERR("malloc()");
+
+    ichi_unlock_init(ctx);
+    for (size_t i = 0, off = 0; off < size; i++) {
+        size_t piece = PIECES[i % NPIECES];
+        if (piece > size - off)
+            piece = size - off;
+        size_t n = ichi_unlock_update(ctx, out, msg + off, piece);
+        // stdio may leave errno set when stdout is a pipe
+        if (fwrite(out, 1, n, stdout) != n)
+            XERR("fwrite()");
+        off += piece;
+    }
+    if (ichi_unlock_final(ctx) != 0)
+        XERR("cannot decrypt '%s'", fn);
+    rv = 0;
+
+error:
+    free(msg);
+    free(out);
+    if (fp != NULL) fclose(fp);
+    return rv;
+}
+
+int main(int argc, char **argv)
+{
+    int rv = 1;
+    int action = 0, kflag = 0, vflag = 0, tagged = 0;
+    uint8_t sk[32], sender[32];
+    uint8_t (*recp)[32] = calloc(ICHI_RECEPIENTS_MAX, 32);
+    size_t nrecp = 0;
+    ichi_lock_ctx *lock = NULL;
+    uint8_t *msg = NULL;
+    struct ls_stream_params params = {
+        .version     = LS_VERSION_INDEXED,
+        .chunk_shift = LS_CHUNK_SHIFT_DEFAULT,
+    };
+    if (recp == NULL)
+        XERR("malloc()");
+
+    int c;
+    while ((c = getopt(argc, argv, "hEDk:v:r:tfdc:")) != -1)
+        switch (c) {
+        default: goto error;
+        case 'h':
+            printf("%s", HELP);
+            rv = 0;
+            goto error;
+        case 'E': action = 'E'; break;
+        case 'D': action = 'D'; break;
+        case 't': tagged = 1; break;
+        case 'f': params.version = LS_VERSION_FAST; break;
+        case 'd': params.digest  = LS_DIGEST_TREE; break;
+        case 'c': params.chunk_shift = strtoul(optarg, NULL, 10); break;
+        case 'k':
+            kflag = 1;
+            if (read_key(optarg, sk) != 0)
+                goto error;
+            break;
+        case 'v':
+            vflag = 1;
+            if (read_key(optarg, sender) != 0)
+                goto error;
+            break;
+        case 'r':
+            if (nrecp == ICHI_RECEPIENTS_MAX || read_key(optarg, recp[nrecp]) != 0)
+                goto error;
+            nrecp++;
+            break;
+        }
+
+    if (action == 'E') {
+        size_t size;
+        lock = calloc(1, sizeof(*lock));
+        msg  = read_all(stdin, &size);
+        if (lock == NULL || msg == NULL
+                || ichi_lock_setup(lock, kflag ? sk : NULL, recp, nrecp,
+                                   tagged, &params) != 0)
+            XERR("cannot set up encryption");
+        rv = 0;
+        for (int i = optind; i < argc && rv == 0; i++)
+            rv = encrypt(lock, msg, size, argv[i]);
+    } else if (action == 'D' && kflag) {
+        ichi_unlock_ctx ctx;
+        if (ichi_unlock_setup(&ctx, sk, vflag ? sender : NULL) != 0)
+            XERR("cannot set up decryption");
+        rv = 0;
+        for (int i = optind; i < argc && rv == 0; i++)
+            rv = decrypt(&ctx, argv[i]);
+        ichi_unlock_free(&ctx);
+    } else {
+        XERR("invalid usage. see -h");
+    }
+
+error:
+    crypto_wipe(sk, sizeof(sk));
+    if (lock != NULL) {
+        ichi_lock_free(lock);
+        free(lock);
+    }
+    free(msg);
+    free(recp);
+    if (fclose(stdout) != 0)
+        rv = 1;
+    return rv;
+}
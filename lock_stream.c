@@ -1,6 +1,11 @@
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "lock_stream.h"
+#include "pipeline.h"
+#include "stats.h"
 #include "monocypher/monocypher.h"
 
 #define WIPE_BUF(buf) crypto_wipe((buf), sizeof(buf))
@@ -9,27 +14,91 @@ typedef uint8_t u8;
 
 static const u8 zeros [24] = { 0 };
 
+static void count_chunk(size_t size)
+{
+    st_add(ST_CHUNKS,  1);
+    st_add(ST_PAYLOAD, size);
+}
+
 void ls_increment_nonce(u8 buf[24])
 {
     for (size_t i = 0; i < 24 && buf[i] == 255; i++)
         buf[i]++;
 }
 
+// Nonce for the counter-th use of the stream key: the last
+// 8 bytes of nonce, read as a LE integer, plus counter.
+void ls_nonce_at(u8 output[24], const u8 nonce[24], uint64_t counter)
+{
+    memcpy(output, nonce, 24);
+    for (size_t i = 16; i < 24; i++) {
+        counter += output[i];
+        output[i] = counter & 0xFF;
+        counter >>= 8;
+    }
+}
+
 //
 // KX Key mode
 //
-void ls_kx_challenge(      u8 output[16 + 32],
-                     const u8 sk[32],
-                     const u8 pk[32],
-                     const u8 enc_key[32])
+// The shared key only depends on the sender and the recepient,
+// so it can be computed once and reused across streams.
+void ls_kx_shared(      u8 shared_key[32],
+                  const u8 sk[32],
+                  const u8 pk[32])
 {
-    u8 shared_key[32];
     crypto_key_exchange(shared_key, sk, pk);
+}
+
+void ls_kx_wrap(      u8 output[16 + 32],
+                const u8 shared_key[32],
+                const u8 enc_key[32])
+{
     crypto_lock(output,
                 output + 16,
                 shared_key,
                 zeros,
                 enc_key, 32);
+}
+
+void ls_kx_challenge(      u8 output[16 + 32],
+                     const u8 sk[32],
+                     const u8 pk[32],
+                     const u8 enc_key[32])
+{
+    u8 shared_key[32];
+    ls_kx_shared(shared_key, sk, pk);
+    ls_kx_wrap(output, shared_key, enc_key);
+    WIPE_BUF(shared_key);
+}
+
+// Tagged slots start with a short recepient tag, so a recepient
+// only has to try the slots that carry its own tag.
+void ls_kx_tag(      u8 tag[8],
+               const u8 shared_key[32],
+               const u8 nonce[24])
+{
+    crypto_blake2b_general(tag, 8, shared_key, 32, nonce, 24);
+}
+
+void ls_kx_wrap_tagged(      u8 output[8 + 16 + 32],
+                       const u8 shared_key[32],
+                       const u8 enc_key[32],
+                       const u8 nonce[24])
+{
+    ls_kx_tag(output, shared_key, nonce);
+    ls_kx_wrap(output + 8, shared_key, enc_key);
+}
+
+void ls_kx_challenge_tagged(      u8 output[8 + 16 + 32],
+                            const u8 sk[32],
+                            const u8 pk[32],
+                            const u8 enc_key[32],
+                            const u8 nonce[24])
+{
+    u8 shared_key[32];
+    ls_kx_shared(shared_key, sk, pk);
+    ls_kx_wrap_tagged(output, shared_key, enc_key, nonce);
     WIPE_BUF(shared_key);
 }
 
@@ -37,6 +106,7 @@ int ls_kx_unwrap(      u8 input[16 + 32],
                        u8 enc_key[32],
                  const u8 shared_key[32])
 {
+    st_add(ST_SLOTS, 1);
     return crypto_unlock(enc_key,
                          shared_key,
                          zeros,
@@ -57,8 +127,128 @@ void ls_pdkf_challenge(u8 *out,
     out[2] = (params->nb_blocks >> 16) & 0xFF;
     out[3] = (params->nb_blocks >> 24) & 0xFF;
     out[4] = (params->nb_iterations)   & 0xFF;
-    out[5] = (params->salt_size)       & 0xFF;
-    memcpy(out + 6, salt, params->salt_size);
+    out[5] = (params->nb_lanes)        & 0xFF;
+    out[6] = (params->salt_size)       & 0xFF;
+    memcpy(out + 7, salt, params->salt_size);
+}
+
+struct pdkf_run_ctx {
+    crypto_argon2_fill *fill;
+    void               *fill_ctx;
+};
+
+static int pdkf_lane(void *arg, size_t lane)
+{
+    struct pdkf_run_ctx *ctx = arg;
+    ctx->fill(ctx->fill_ctx, (uint32_t) lane);
+    return 0;
+}
+
+// one thread per lane
+static void pdkf_run(void *run_ctx, crypto_argon2_fill *fill,
+                     void *fill_ctx, uint32_t nb_lanes)
+{
+    (void) run_ctx;
+    struct pdkf_run_ctx ctx = { fill, fill_ctx };
+    if (pl_for(nb_lanes, nb_lanes, pdkf_lane, &ctx) != 0) {
+        // pdkf_lane never fails, so pl_for only does when it cannot
+        // allocate its threads, before any work.  Filling a lane twice
+        // would be harmless anyway: the lanes of a slice are independent.
+        for (uint32_t i = 0; i < nb_lanes; i++)
+            fill(fill_ctx, i);
+    }
+}
+
+// Huge pages cut the TLB misses of Argon2i's random block accesses.
+// Try, in order: explicit huge pages, transparent huge pages, malloc.
+// The area is prefaulted so that page faults stay out of the KDF.
+#define PDKF_HUGE_PAGE (2 << 20)
+
+int ls_pdkf_area_alloc(struct ls_pdkf_area *area, size_t nb_blocks)
+{
+    size_t size = nb_blocks * 1024;
+    int saved_errno = errno; // failed attempts are not errors
+    area->base   = NULL;
+    area->size   = 0;
+    area->mapped = 0;
+
+    size_t mapped_size = (size + PDKF_HUGE_PAGE - 1) & ~(size_t)(PDKF_HUGE_PAGE - 1);
+    void *base = MAP_FAILED;
+#if defined(MAP_HUGETLB) && defined(MAP_POPULATE)
+    base = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE,
+                -1, 0);
+#endif
+    if (base == MAP_FAILED) {
+        base = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+            madvise(base, mapped_size, MADV_HUGEPAGE);
+#endif
+            // prefault, one write per page
+            long page = sysconf(_SC_PAGESIZE);
+            if (page <= 0)
+                page = 4096;
+            for (size_t i = 0; i < mapped_size; i += (size_t) page)
+                ((volatile u8 *) base)[i] = 0;
+        }
+    }
+    if (base != MAP_FAILED) {
+        area->base   = base;
+        area->size   = mapped_size;
+        area->mapped = 1;
+        st_buffers((int64_t) area->size);
+        errno = saved_errno;
+        return 0;
+    }
+
+    area->base = malloc(size);
+    if (area->base == NULL)
+        return -1;
+    area->size = size;
+    st_buffers((int64_t) area->size);
+    errno = saved_errno;
+    return 0;
+}
+
+void ls_pdkf_area_free(struct ls_pdkf_area *area)
+{
+    if (area->base == NULL)
+        return;
+    if (area->mapped)
+        munmap(area->base, area->size);
+    else
+        free(area->base);
+    st_buffers(-(int64_t) area->size);
+    area->base = NULL;
+    area->size = 0;
+}
+
+int ls_pdkf_key_area(u8 key[32],
+                     const struct ls_pdkf_params *params,
+                     const u8 *salt,
+                     const u8 *password, size_t password_size,
+                     struct ls_pdkf_area *area)
+{
+    struct st_timer t;
+    st_start(ST_PDKF, &t);
+    // grow the area if needed
+    if (area->size < params->nb_blocks * 1024) {
+        ls_pdkf_area_free(area);
+        if (ls_pdkf_area_alloc(area, params->nb_blocks) != 0)
+            return -1;
+    }
+
+    crypto_argon2i_lanes(key, 32,
+                         area->base, params->nb_blocks, params->nb_iterations,
+                         params->nb_lanes,
+                         password, password_size,
+                         salt, params->salt_size,
+                         NULL, 0, NULL, 0,
+                         pdkf_run, NULL);
+    st_stop(ST_PDKF, &t);
+    return 0;
 }
 
 int ls_pdkf_key(u8 key[32],
@@ -66,31 +256,33 @@ int ls_pdkf_key(u8 key[32],
                 const u8 *salt,
                 const u8 *password, size_t password_size)
 {
-    void* work_area = malloc(params->nb_blocks * 1024);
-    if (work_area == NULL)
-        return -1;
-
-    crypto_argon2i(key, 32,
-                   work_area, params->nb_blocks, params->nb_iterations,
-                   password, password_size,
-                   salt, params->salt_size);
-    free(work_area);
-    return 0;
+    struct ls_pdkf_area area = { NULL, 0, 0 };
+    int rv = ls_pdkf_key_area(key, params, salt, password, password_size,
+                              &area);
+    ls_pdkf_area_free(&area);
+    return rv;
 }
 
-void ls_pdkf_decode(u8 *input, struct ls_pdkf_params *params)
+int ls_pdkf_decode(const u8 *input, size_t input_size,
+                   struct ls_pdkf_params *params)
 {
+    if (input_size != 6 && input_size != 7)
+        return -1;
     params->nb_blocks = (size_t) input[0]
                       | (size_t) input[1] << 8
                       | (size_t) input[2] << 16
                       | (size_t) input[3] << 24;
     params->nb_iterations = (size_t) input[4];
-    params->salt_size     = (size_t) input[5];
+    params->nb_lanes      = input_size == 7 ? (size_t) input[5] : 1;
+    params->salt_size     = (size_t) input[input_size - 1];
+    return 0;
 }
 
 int ls_pdkf_verify(const struct ls_pdkf_params *params)
 {
-    if (!(params->nb_blocks >= 8
+    if (!(params->nb_lanes >= 1
+                && params->nb_lanes <= LS_PDKF_LANES_MAX
+                && params->nb_blocks >= 8 * params->nb_lanes
                 && params->nb_blocks <= 100000
                 && params->nb_iterations >= 1
                 && params->nb_iterations <= 10
@@ -101,6 +293,72 @@ int ls_pdkf_verify(const struct ls_pdkf_params *params)
 }
 
 
+//
+// Stream parameters
+//
+size_t ls_stream_encode(u8 out[LS_STREAM_MAX], const struct ls_stream_params *params)
+{
+    out[0] = 2; // number of parameter bytes that follow
+    out[1] = (params->version)     & 0xFF;
+    out[2] = (params->chunk_shift) & 0xFF;
+    if (params->compression == LS_COMPRESSION_NONE
+            && params->digest == LS_DIGEST_BLAKE2B)
+        return 3;
+    out[0] = 3;
+    out[3] = (params->compression) & 0xFF;
+    if (params->digest == LS_DIGEST_BLAKE2B)
+        return 4;
+    out[0] = 4;
+    out[4] = (params->digest) & 0xFF;
+    return 5;
+}
+
+// Parameters missing from the end of input take their defaults.
+int ls_stream_decode(const u8 *input, size_t input_size,
+                     struct ls_stream_params *params)
+{
+    if (input_size < 1 || input_size > 4)
+        return -1;
+    params->version     = (size_t) input[0];
+    params->chunk_shift = input_size > 1
+                        ? (size_t) input[1]
+                        : LS_CHUNK_SHIFT_DEFAULT;
+    params->compression = input_size > 2
+                        ? (size_t) input[2]
+                        : LS_COMPRESSION_NONE;
+    params->digest      = input_size > 3
+                        ? (size_t) input[3]
+                        : LS_DIGEST_BLAKE2B;
+    return 0;
+}
+
+int ls_stream_verify(const struct ls_stream_params *params)
+{
+    if (!((params->version == LS_VERSION_INDEXED
+                    || params->version == LS_VERSION_FAST)
+                && params->chunk_shift >= LS_CHUNK_SHIFT_MIN
+                && params->chunk_shift <= LS_CHUNK_SHIFT_MAX
+                && params->compression <= LS_COMPRESSION_LZ4
+                && params->digest <= LS_DIGEST_TREE)) {
+        return -1;
+    }
+    return 0;
+}
+
+size_t ls_chunk_size(const struct ls_stream_params *params)
+{
+    return (size_t) 1 << params->chunk_shift;
+}
+
+void ls_chunk_digest(u8 digest[64], const u8 *chunk, size_t size)
+{
+    struct st_timer t;
+    st_start(ST_HASH, &t);
+    crypto_blake2b(digest, chunk, size);
+    st_stop(ST_HASH, &t);
+}
+
+
 //
 // After key mode (lock stream)
 //
@@ -110,6 +368,7 @@ void ls_lock(u8       *output,  // input_size + 34
              const u8 *input, size_t input_size)
 {
     u8 length[2];
+    count_chunk(input_size);
     length[0] = (input_size)      & 0xFF;
     length[1] = (input_size >> 8) & 0xFF;
 
@@ -154,9 +413,228 @@ int ls_unlock_payload(u8       *output,
                       const u8  key   [32],
                       const u8 *input, size_t input_size)
 {
+    count_chunk(input_size);
     ls_increment_nonce(nonce);
     return crypto_unlock(output,
                          key, nonce,
                          input, /* mac */
                          input + 16, input_size);
 }
+
+
+//
+// Indexed lock stream: chunk `index` uses counters 2*index (length)
+// and 2*index + 1 (payload), so chunks can be processed in any order.
+//
+void ls_lock_at(u8       *output,  // input_size + 36
+                const u8  nonce [24],
+                const u8  key   [32],
+                uint64_t  index,
+                const u8 *input, size_t input_size)
+{
+    u8 length[4],
+       chunk_nonce[24];
+    count_chunk(input_size);
+    length[0] = (input_size)       & 0xFF;
+    length[1] = (input_size >> 8)  & 0xFF;
+    length[2] = (input_size >> 16) & 0xFF;
+    length[3] = (input_size >> 24) & 0xFF;
+
+    ls_nonce_at(chunk_nonce, nonce, 2 * index);
+    crypto_lock(output,
+                output + 16, /* mac */
+                key, chunk_nonce,
+                length, 4);
+
+    ls_nonce_at(chunk_nonce, nonce, 2 * index + 1);
+    crypto_lock(output + 20,
+                output + 20 + 16, /* mac */
+                key, chunk_nonce,
+                input, input_size);
+    WIPE_BUF(length);
+}
+
+int ls_unlock_length_at(size_t   *to_read,
+                        const u8  nonce [24],
+                        const u8  key   [32],
+                        uint64_t  index,
+                        const u8  input [20])
+{
+    int rv = -1;
+    u8 length_buf[4],
+       chunk_nonce[24];
+    ls_nonce_at(chunk_nonce, nonce, 2 * index);
+    if (crypto_unlock(length_buf,
+                      key, chunk_nonce,
+                      input /* mac */,
+                      input + 16, 4) != 0)
+        goto error;
+    rv = 0;
+    *to_read = (size_t) length_buf[0]
+             | (size_t) length_buf[1] << 8
+             | (size_t) length_buf[2] << 16
+             | (size_t) length_buf[3] << 24;
+error:
+    WIPE_BUF(length_buf);
+    return rv;
+}
+
+int ls_unlock_payload_at(u8       *output,
+                         const u8  nonce [24],
+                         const u8  key   [32],
+                         uint64_t  index,
+                         const u8 *input, size_t input_size)
+{
+    u8 chunk_nonce[24];
+    count_chunk(input_size);
+    ls_nonce_at(chunk_nonce, nonce, 2 * index + 1);
+    return crypto_unlock(output,
+                         key, chunk_nonce,
+                         input, /* mac */
+                         input + 16, input_size);
+}
+
+
+//
+// Fast lock stream: chunk `index` is encrypted with ChaCha20 under the
+// per-stream subkey and nonce counter `index`. Block 0 of the keystream
+// provides the Poly1305 key and masks the length; the payload starts at
+// block 1. A single MAC covers enc(length) and enc(payload).
+//
+void ls_fast_init(struct ls_fast_ctx *ctx,
+                  const u8 key  [32],
+                  const u8 nonce[24])
+{
+    crypto_hchacha20(ctx->key, key, nonce);
+    memcpy(ctx->nonce, nonce, 24);
+}
+
+static void ls_fast_block(u8 block[64], u8 chunk_nonce[24],
+                          const struct ls_fast_ctx *ctx, uint64_t index)
+{
+    ls_nonce_at(chunk_nonce, ctx->nonce, index);
+    crypto_chacha20_ctr(block, 0, 64, ctx->key, chunk_nonce + 16, 0);
+}
+
+void ls_fast_lock(const struct ls_fast_ctx *ctx,
+                  u8       *output,  // input_size + 20
+                  uint64_t  index,
+                  const u8 *input, size_t input_size)
+{
+    u8 block[64],
+       chunk_nonce[24];
+    count_chunk(input_size);
+    ls_fast_block(block, chunk_nonce, ctx, index);
+
+    output[0] = ((input_size)       & 0xFF) ^ block[32];
+    output[1] = ((input_size >> 8)  & 0xFF) ^ block[33];
+    output[2] = ((input_size >> 16) & 0xFF) ^ block[34];
+    output[3] = ((input_size >> 24) & 0xFF) ^ block[35];
+    crypto_chacha20_ctr(output + 4, input, input_size,
+                        ctx->key, chunk_nonce + 16, 1);
+    crypto_poly1305(output + 4 + input_size, /* mac */
+                    output, 4 + input_size,
+                    block);
+    WIPE_BUF(block);
+}
+
+// The length is only authenticated by ls_fast_unlock, callers
+// must bound it before reading the rest of the chunk.
+int ls_fast_unlock_length(const struct ls_fast_ctx *ctx,
+                          size_t   *to_read,
+                          uint64_t  index,
+                          const u8  input[4])
+{
+    u8 block[64],
+       chunk_nonce[24];
+    ls_fast_block(block, chunk_nonce, ctx, index);
+    *to_read = (size_t) (input[0] ^ block[32])
+             | (size_t) (input[1] ^ block[33]) << 8
+             | (size_t) (input[2] ^ block[34]) << 16
+             | (size_t) (input[3] ^ block[35]) << 24;
+    WIPE_BUF(block);
+    return 0;
+}
+
+int ls_fast_unlock(const struct ls_fast_ctx *ctx,
+                   u8       *output,
+                   uint64_t  index,
+                   const u8 *input, // 4 + output_size + 16
+                   size_t    output_size)
+{
+    int rv = -1;
+    u8 block[64],
+       chunk_nonce[24],
+       mac[16];
+    count_chunk(output_size);
+    ls_fast_block(block, chunk_nonce, ctx, index);
+    crypto_poly1305(mac, input, 4 + output_size, block);
+    if (crypto_verify16(mac, input + 4 + output_size) != 0)
+        goto error;
+    crypto_chacha20_ctr(output, input + 4, output_size,
+                        ctx->key, chunk_nonce + 16, 1);
+    rv = 0;
+error:
+    WIPE_BUF(block);
+    return rv;
+}
+
+
+//
+// In place.  ChaCha20 reads every byte before writing it back, and the
+// MACs are taken before decrypting, so the buffers of the functions
+// above may overlap exactly.
+//
+size_t ls_lock_inplace(u8       *chunk,
+                       u8        nonce [24],
+                       const u8  key   [32],
+                       size_t    size)
+{
+    ls_lock(chunk, nonce, key, chunk + LS_HEAD_LEGACY, size);
+    return LS_HEAD_LEGACY + size;
+}
+
+size_t ls_lock_at_inplace(u8       *chunk,
+                          const u8  nonce [24],
+                          const u8  key   [32],
+                          uint64_t  index,
+                          size_t    size)
+{
+    ls_lock_at(chunk, nonce, key, index, chunk + LS_HEAD_INDEXED, size);
+    return LS_HEAD_INDEXED + size;
+}
+
+size_t ls_fast_lock_inplace(const struct ls_fast_ctx *ctx,
+                            u8       *chunk,
+                            uint64_t  index,
+                            size_t    size)
+{
+    ls_fast_lock(ctx, chunk, index, chunk + LS_HEAD_FAST, size);
+    return LS_HEAD_FAST + size + LS_TAIL_FAST;
+}
+
+int ls_unlock_payload_inplace(u8       *chunk,
+                              u8        nonce [24],
+                              const u8  key   [32],
+                              size_t    size)
+{
+    return ls_unlock_payload(chunk + LS_PAYLOAD_HEAD, nonce, key, chunk, size);
+}
+
+int ls_unlock_payload_at_inplace(u8       *chunk,
+                                 const u8  nonce [24],
+                                 const u8  key   [32],
+                                 uint64_t  index,
+                                 size_t    size)
+{
+    return ls_unlock_payload_at(chunk + LS_PAYLOAD_HEAD, nonce, key, index,
+                                chunk, size);
+}
+
+int ls_fast_unlock_inplace(const struct ls_fast_ctx *ctx,
+                           u8       *chunk,
+                           uint64_t  index,
+                           size_t    size)
+{
+    return ls_fast_unlock(ctx, chunk + LS_HEAD_FAST, index, chunk, size);
+}
@@ -5,10 +5,55 @@
 #include <stddef.h>
 
 void ls_increment_nonce(uint8_t buf[24]);
+void ls_nonce_at(uint8_t       output[24],
+                 const uint8_t nonce[24],
+                 uint64_t      counter);
+
+#define LS_VERSION_LEGACY  1  // running nonce, 2-byte lengths
+#define LS_VERSION_INDEXED 2  // nonces derived from the chunk index
+#define LS_VERSION_FAST    3  // one subkey per stream, one MAC per chunk
+#define LS_STREAM_MAX      16 // max size of an encoded stream header
+
+// chunk size is 2^chunk_shift bytes
+#define LS_CHUNK_SHIFT_DEFAULT 15
+#define LS_CHUNK_SHIFT_MIN     8
+#define LS_CHUNK_SHIFT_MAX     24
+
+#define LS_COMPRESSION_NONE 0
+#define LS_COMPRESSION_LZ4  1  // chunks may be 'Z' + LZ4 block
+
+#define LS_DIGEST_BLAKE2B 0  // BLAKE2b of the plaintext
+#define LS_DIGEST_TREE    1  // BLAKE2b of the BLAKE2b of every chunk
+
+struct ls_stream_params {
+    size_t version;
+    size_t chunk_shift;
+    size_t compression;
+    size_t digest;
+};
+
+size_t ls_chunk_size(const struct ls_stream_params *params);
+// Digest of a plaintext chunk, fed to the stream digest for
+// LS_DIGEST_TREE.  Chunks can be hashed on any thread.
+void ls_chunk_digest(uint8_t digest[64], const uint8_t *chunk, size_t size);
+
+// Fast stream: the XChaCha20 subkey is derived once per stream
+struct ls_fast_ctx {
+    uint8_t key  [32];
+    uint8_t nonce[24];
+};
+
+void ls_fast_init(struct ls_fast_ctx *ctx,
+                  const uint8_t key  [32],
+                  const uint8_t nonce[24]);
+
+// Argon2i lanes are computed on as many threads
+#define LS_PDKF_LANES_MAX 16
 
 struct ls_pdkf_params {
     size_t nb_blocks;
     size_t nb_iterations;
+    size_t nb_lanes;
     size_t salt_size;
 };
 
@@ -16,19 +61,68 @@ struct ls_pdkf_params {
 // Encryption
 //
 // KX Mode
+void ls_kx_shared(uint8_t       shared_key[32],
+                  const uint8_t sk[32],
+                  const uint8_t pk[32]);
+void ls_kx_wrap(uint8_t       output[16 + 32],
+                const uint8_t shared_key[32],
+                const uint8_t enc_key[32]);
+void ls_kx_wrap_tagged(uint8_t       output[8 + 16 + 32],
+                       const uint8_t shared_key[32],
+                       const uint8_t enc_key[32],
+                       const uint8_t nonce[24]);
 void ls_kx_challenge(uint8_t       output[16 + 32],
                      const uint8_t sk[32],
                      const uint8_t pk[32],
                      const uint8_t enc_key[32]);
+void ls_kx_challenge_tagged(uint8_t       output[8 + 16 + 32],
+                            const uint8_t sk[32],
+                            const uint8_t pk[32],
+                            const uint8_t enc_key[32],
+                            const uint8_t nonce[24]);
 // PDKF Mode
-void ls_pdkf_challenge(uint8_t *out /* 6 + salt_size */,
+void ls_pdkf_challenge(uint8_t *out /* 7 + salt_size */,
                        const struct ls_pdkf_params *params,
                        const uint8_t *salt);
+// Stream parameters
+size_t ls_stream_encode(uint8_t out[LS_STREAM_MAX],
+                        const struct ls_stream_params *params);
 // Lockstream
 void ls_lock(uint8_t       *output,  // input_size + 34
              uint8_t        nonce [24],
              const uint8_t  key   [32],
              const uint8_t *input, size_t input_size);
+void ls_lock_at(uint8_t       *output,  // input_size + 36
+                const uint8_t  nonce [24],
+                const uint8_t  key   [32],
+                uint64_t       index,
+                const uint8_t *input, size_t input_size);
+void ls_fast_lock(const struct ls_fast_ctx *ctx,
+                  uint8_t       *output,  // input_size + 20
+                  uint64_t       index,
+                  const uint8_t *input, size_t input_size);
+
+// In place: the plaintext sits in the caller's buffer after LS_HEAD_*
+// bytes of room for the lengths and MACs (and before LS_TAIL_FAST more
+// for fast streams), and is locked where it is.  Returns the size of
+// the locked chunk, which starts at the beginning of the buffer.
+#define LS_HEAD_LEGACY  34
+#define LS_HEAD_INDEXED 36
+#define LS_HEAD_FAST    4
+#define LS_TAIL_FAST    16
+size_t ls_lock_inplace(uint8_t       *chunk, // plaintext at chunk + 34
+                       uint8_t        nonce [24],
+                       const uint8_t  key   [32],
+                       size_t         size);
+size_t ls_lock_at_inplace(uint8_t       *chunk, // plaintext at chunk + 36
+                          const uint8_t  nonce [24],
+                          const uint8_t  key   [32],
+                          uint64_t       index,
+                          size_t         size);
+size_t ls_fast_lock_inplace(const struct ls_fast_ctx *ctx,
+                            uint8_t  *chunk, // plaintext at chunk + 4
+                            uint64_t  index,
+                            size_t    size);
 
 
 //
@@ -39,6 +133,22 @@ int ls_pdkf_key(uint8_t key[32],
                 const uint8_t *salt,
                 const uint8_t *password, size_t password_size);
 
+// Reusable Argon2i work area, backed by huge pages when possible.
+// ls_pdkf_key_area() grows it as needed, and wipes it after use.
+struct ls_pdkf_area {
+    void  *base;
+    size_t size;
+    int    mapped;
+};
+
+int ls_pdkf_area_alloc(struct ls_pdkf_area *area, size_t nb_blocks);
+void ls_pdkf_area_free(struct ls_pdkf_area *area);
+int ls_pdkf_key_area(uint8_t key[32],
+                     const struct ls_pdkf_params *params,
+                     const uint8_t *salt,
+                     const uint8_t *password, size_t password_size,
+                     struct ls_pdkf_area *area);
+
 
 //
 // Decryption
@@ -47,10 +157,18 @@ int ls_pdkf_key(uint8_t key[32],
 int ls_kx_unwrap(uint8_t       input[16 + 32],
                  uint8_t       enc_key[32],
                  const uint8_t shared_key[32]);
+void ls_kx_tag(uint8_t       tag[8],
+               const uint8_t shared_key[32],
+               const uint8_t nonce[24]);
 // PDKF
-void ls_pdkf_decode(uint8_t input[6],
-                    struct ls_pdkf_params *params);
+// input_size is 6 for legacy streams (1 lane), else 7
+int ls_pdkf_decode(const uint8_t *input, size_t input_size,
+                   struct ls_pdkf_params *params);
 int ls_pdkf_verify(const struct ls_pdkf_params *params);
+// Stream parameters
+int ls_stream_decode(const uint8_t *input, size_t input_size,
+                     struct ls_stream_params *params);
+int ls_stream_verify(const struct ls_stream_params *params);
 
 // Lockstream
 int ls_unlock_length(size_t       *to_read,
@@ -62,4 +180,45 @@ int ls_unlock_payload(uint8_t       *output,
                       uint8_t        nonce [24],
                       const uint8_t  key   [32],
                       const uint8_t *input, size_t input_size);
+
+int ls_unlock_length_at(size_t       *to_read,
+                        const uint8_t nonce [24],
+                        const uint8_t key   [32],
+                        uint64_t      index,
+                        const uint8_t input [20]);
+
+int ls_unlock_payload_at(uint8_t       *output,
+                         const uint8_t  nonce [24],
+                         const uint8_t  key   [32],
+                         uint64_t       index,
+                         const uint8_t *input, size_t input_size);
+
+int ls_fast_unlock_length(const struct ls_fast_ctx *ctx,
+                          size_t       *to_read,
+                          uint64_t      index,
+                          const uint8_t input[4]);
+
+int ls_fast_unlock(const struct ls_fast_ctx *ctx,
+                   uint8_t       *output,
+                   uint64_t       index,
+                   const uint8_t *input, // 4 + output_size + 16
+                   size_t         output_size);
+
+// In place: chunk holds what ls_unlock_payload*() or ls_fast_unlock()
+// take as input, and the plaintext is left at chunk + LS_PAYLOAD_HEAD
+// (chunk + LS_HEAD_FAST for fast streams).  size is the plaintext size.
+#define LS_PAYLOAD_HEAD 16
+int ls_unlock_payload_inplace(uint8_t       *chunk,
+                              uint8_t        nonce [24],
+                              const uint8_t  key   [32],
+                              size_t         size);
+int ls_unlock_payload_at_inplace(uint8_t       *chunk,
+                                 const uint8_t  nonce [24],
+                                 const uint8_t  key   [32],
+                                 uint64_t       index,
+                                 size_t         size);
+int ls_fast_unlock_inplace(const struct ls_fast_ctx *ctx,
+                           uint8_t  *chunk,
+                           uint64_t  index,
+                           size_t    size);
 #endif
@@ -0,0 +1,186 @@
+#include <string.h>
+#include "lz.h"
+
+typedef uint8_t u8;
+
+#define MIN_MATCH     4
+#define LAST_LITERALS 5  // the block ends with at least 5 literals...
+#define MF_LIMIT      12 // ...and its last match starts 12 bytes before
+#define MAX_OFFSET    65535
+#define HASH_LOG      12
+#define SKIP_TRIGGER  6  // search faster after 2^6 misses in a row
+
+static uint32_t load32(const u8 *p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static uint32_t hash4(const u8 *p)
+{
+    return (load32(p) * 2654435761u) >> (32 - HASH_LOG);
+}
+
+// Bytes of a length once the 15 of its token is taken out
+static size_t length_size(size_t length)
+{
+    return length >= 15 ? (length - 15) / 255 + 1 : 0;
+}
+
+static u8 *put_length(u8 *op, size_t length)
+{
+    for (length -= 15; length >= 255; length -= 255)
+        *op++ = 255;
+    *op++ = (u8) length;
+    return op;
+}
+
+// Emits literals [anchor, ip), followed by a match unless the block
+// ends here (match_length == 0).  Returns NULL if out is too small.
+static u8 *put_sequence(u8 *op, const u8 *oend,
+                        const u8 *anchor, const u8 *ip,
+                        size_t offset, size_t match_length)
+{
+    size_t literals = ip - anchor,
+           extra    = match_length > 0 ? match_length - MIN_MATCH : 0,
+           need     = 1 + length_size(literals) + literals
+                    + (match_length > 0 ? 2 + length_size(extra) : 0);
+    if ((size_t) (oend - op) < need)
+        return NULL;
+
+    u8 *token = op++;
+    *token = (u8) ((literals < 15 ? literals : 15) << 4);
+    if (literals >= 15)
+        op = put_length(op, literals);
+    memcpy(op, anchor, literals);
+    op += literals;
+    if (match_length == 0)
+        return op;
+
+    *op++ = offset & 0xFF;
+    *op++ = offset >> 8;
+    *token |= extra < 15 ? extra : 15;
+    if (extra >= 15)
+        op = put_length(op, extra);
+    return op;
+}
+
+size_t lz_compress(u8 *out, size_t out_cap, const u8 *in, size_t in_size)
+{
+    uint32_t table[1 << HASH_LOG]; // last position of every hash
+    const u8 *ip     = in,
+             *anchor = in,
+             *iend   = in + in_size;
+    u8       *op     = out,
+             *oend   = out + out_cap;
+
+    if (in_size > MF_LIMIT) {
+        const u8 *mf_limit    = iend - MF_LIMIT,
+                 *match_limit = iend - LAST_LITERALS;
+        memset(table, 0, sizeof(table));
+        ip++;
+        while (ip <= mf_limit) {
+            const u8 *match;
+            size_t misses = 1 << SKIP_TRIGGER,
+                   step   = 1;
+            while (1) {
+                uint32_t h = hash4(ip);
+                match    = in + table[h];
+                table[h] = (uint32_t) (ip - in);
+                if (match < ip && ip - match <= MAX_OFFSET
+                        && load32(match) == load32(ip))
+                    break;
+                ip  += step;
+                step = misses++ >> SKIP_TRIGGER;
+                if (ip > mf_limit)
+                    goto last_literals;
+            }
+
+            while (ip > anchor && match > in && ip[-1] == match[-1]) {
+                ip--;
+                match--;
+            }
+            size_t length = MIN_MATCH;
+            while (ip + length < match_limit && ip[length] == match[length])
+                length++;
+
+            op = put_sequence(op, oend, anchor, ip, ip - match, length);
+            if (op == NULL)
+                return 0;
+            ip    += length;
+            anchor = ip;
+            if (ip <= mf_limit)
+                table[hash4(ip - 2)] = (uint32_t) (ip - 2 - in);
+        }
+    }
+
+last_literals:
+    op = put_sequence(op, oend, anchor, iend, 0, 0);
+    return op != NULL ? (size_t) (op - out) : 0;
+}
+
+// Adds the bytes of a length after the 15 of its token
+static int get_length(const u8 **ip, const u8 *iend, size_t *length, size_t max)
+{
+    u8 b;
+    do {
+        if (*ip == iend || *length > max)
+            return -1;
+        b        = *(*ip)++;
+        *length += b;
+    } while (b == 255);
+    return 0;
+}
+
+int lz_decompress(u8 *out, size_t out_cap, size_t *out_size,
+                  const u8 *in, size_t in_size)
+{
+    const u8 *ip   = in,
+             *iend = in + in_size;
+    u8       *op   = out,
+             *oend = out + out_cap;
+
+    if (in_size == 0)
+        return -1;
+    while (1) {
+        u8 token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15 && get_length(&ip, iend, &literals, out_cap) != 0)
+            return -1;
+        if ((size_t) (iend - ip) < literals || (size_t) (oend - op) < literals)
+            return -1;
+        memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+        if (ip == iend)
+            break; // the last sequence has no match
+
+        if (iend - ip < 2)
+            return -1;
+        size_t offset = ip[0] | (size_t) ip[1] << 8,
+               length = token & 15;
+        ip += 2;
+        if (offset == 0 || offset > (size_t) (op - out))
+            return -1;
+        if (length == 15 && get_length(&ip, iend, &length, out_cap) != 0)
+            return -1;
+        length += MIN_MATCH;
+        if ((size_t) (oend - op) < length)
+            return -1;
+
+        const u8 *match = op - offset;
+        if (offset >= length) {
+            memcpy(op, match, length);
+            op += length;
+        } else {
+            // overlapping: repeats the last offset bytes
+            while (length-- > 0)
+                *op++ = *match++;
+        }
+        if (ip == iend)
+            return -1; // ends with a match
+    }
+    *out_size = op - out;
+    return 0;
+}
@@ -0,0 +1,21 @@
+#ifndef KURV_LZ
+#define KURV_LZ
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fast compression of independent blocks, in the LZ4 block format
+// (lz4_Block_format.md in the LZ4 sources): greedy matching with a
+// small hash table, no entropy coding.  Blocks are at most 2^24 bytes.
+
+// Compresses in into out.  Returns the compressed size, or 0 if it
+// would not fit in out_cap bytes: callers pass the size they want to
+// beat, and store the block as is when it does not shrink.
+size_t lz_compress(uint8_t *out, size_t out_cap,
+                   const uint8_t *in, size_t in_size);
+
+// Returns 0 and the decompressed size, or -1 if in is malformed or
+// decompresses to more than out_cap bytes.
+int lz_decompress(uint8_t *out, size_t out_cap, size_t *out_size,
+                  const uint8_t *in, size_t in_size);
+#endif
@@ -0,0 +1,81 @@
+// Prints the fixed-base comb tables of ge_scalarmult_base(), for
+// MONOCYPHER_COMB_TABLES = n (a divisor of 51):
+//
+//   gcc -o gen_comb gen_comb.c && ./gen_comb 3
+//
+// Table k, entry i holds the sum of the 5 teeth 2^(s*j + 5*s*k) B,
+// j < 5, with spacing s = 51 / n: the top tooth is always added, and
+// tooth j < 4 is added if bit j of i is set, subtracted otherwise.
+#include <stdio.h>
+#include <stdlib.h>
+#include "monocypher.c"
+
+static void print_fe(const fe f, const char *end)
+{
+    u8 s[32];
+    fe canon;
+    fe_tobytes(s, f);
+    fe_frombytes(canon, s);
+    printf("{");
+    FOR (i, 0, 10) {
+        printf("%d,", canon[i]);
+        if (i == 4) printf("\n      ");
+    }
+    printf("}%s", end);
+}
+
+int main(int argc, char **argv)
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1;
+    if (n < 1 || 51 % n != 0) {
+        fprintf(stderr, "usage: gen_comb N, with N dividing 51\n");
+        return 1;
+    }
+    int spacing = 51 / n;
+
+    // teeth[k][j] = 2^(spacing*j + 5*spacing*k) B
+    static const u8 one[32] = {1};
+    ge teeth[51][5], dbl, p;
+    ge_scalarmult_base(&p, one);
+    FOR (k, 0, (size_t) n) {
+        FOR (j, 0, 5) {
+            teeth[k][j] = p;
+            FOR (d, 0, (size_t) spacing) {
+                ge_double(&p, &p, &dbl);
+            }
+        }
+    }
+
+    printf("static const ge_precomp b_comb[%d][16] = {\n", n);
+    FOR (k, 0, (size_t) n) {
+        printf("  {\n");
+        FOR (i, 0, 16) {
+            ge sum = teeth[k][4];
+            FOR (j, 0, 4) {
+                ge tooth = teeth[k][j];
+                if (!((i >> j) & 1)) {
+                    fe_neg(tooth.X, tooth.X);
+                    fe_neg(tooth.T, tooth.T);
+                }
+                ge_cached c;
+                ge_cache(&c, &tooth);
+                ge_add(&sum, &sum, &c);
+            }
+            fe zi, x, y, yp, ym, t2;
+            fe_invert(zi, sum.Z);
+            fe_mul(x, sum.X, zi);
+            fe_mul(y, sum.Y, zi);
+            fe_add(yp, y, x);
+            fe_sub(ym, y, x);
+            fe_mul(t2, x, y);
+            fe_mul(t2, t2, D2);
+            printf("    {");
+            print_fe(yp, ",\n     ");
+            print_fe(ym, ",\n     ");
+            print_fe(t2, ",},\n");
+        }
+        printf("  },\n");
+    }
+    printf("};\n");
+    return 0;
+}
@@ -203,13 +203,314 @@ static void chacha20_init_key(u32 block[16], const u8 key[32])
     load32_le_buf(block+4, key                          , 8); // key
 }
 
+// Multi-block SIMD kernels (extension, not part of upstream Monocypher)
+// -------------------------------------------------------------------
+// Each kernel computes several blocks at once, one block per vector lane,
+// then transposes the state back into byte order.  They only process
+// whole batches, and leave the rest (and any batch where the low counter
+// word would wrap) to the scalar loop, so the output is byte-identical.
+// The kernel is picked at run time from what the CPU supports.
+// Define MONOCYPHER_NO_SIMD to only use the portable code.
+#if !defined(MONOCYPHER_NO_SIMD) && defined(__GNUC__) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86
+#include <immintrin.h>
+
+#define AVX2_ROTL(x, n) \
+    _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+#define AVX2_QUARTERROUND(a, b, c, d)                                       \
+    a = _mm256_add_epi32(a, b);                                             \
+    d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);                 \
+    c = _mm256_add_epi32(c, d);  b = AVX2_ROTL(_mm256_xor_si256(b, c), 12); \
+    a = _mm256_add_epi32(a, b);                                             \
+    d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8);                  \
+    c = _mm256_add_epi32(c, d);  b = AVX2_ROTL(_mm256_xor_si256(b, c),  7)
+
+// 4x4 transpose of 32-bit words within each 128-bit lane
+#define AVX2_TRANSPOSE4(a, b, c, d) do {                                    \
+    __m256i t0_ = _mm256_unpacklo_epi32(a, b);                              \
+    __m256i t1_ = _mm256_unpackhi_epi32(a, b);                              \
+    __m256i t2_ = _mm256_unpacklo_epi32(c, d);                              \
+    __m256i t3_ = _mm256_unpackhi_epi32(c, d);                              \
+    a = _mm256_unpacklo_epi64(t0_, t2_);                                    \
+    b = _mm256_unpackhi_epi64(t0_, t2_);                                    \
+    c = _mm256_unpacklo_epi64(t1_, t3_);                                    \
+    d = _mm256_unpackhi_epi64(t1_, t3_);                                    \
+    } while (0)
+
+static __attribute__((target("avx2")))
+void avx2_store(u8 *out, const u8 *in, __m256i v)
+{
+    if (in != 0) {
+        v = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i*)in));
+    }
+    _mm256_storeu_si256((__m256i*)out, v);
+}
+
+// 8 blocks at a time
+static __attribute__((target("avx2")))
+size_t chacha20_avx2(u32 input[16], u8 *out, const u8 *in, size_t nb_blocks)
+{
+    const __m256i rot16 = _mm256_setr_epi8(
+        2, 3, 0, 1,  6, 7, 4, 5, 10, 11,  8,  9, 14, 15, 12, 13,
+        2, 3, 0, 1,  6, 7, 4, 5, 10, 11,  8,  9, 14, 15, 12, 13);
+    const __m256i rot8 = _mm256_setr_epi8(
+        3, 0, 1, 2,  7, 4, 5, 6, 11,  8,  9, 10, 15, 12, 13, 14,
+        3, 0, 1, 2,  7, 4, 5, 6, 11,  8,  9, 10, 15, 12, 13, 14);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    size_t done = 0;
+    while (nb_blocks - done >= 8 && input[12] <= 0xffffffff - 8) {
+        __m256i s[16], x[16];
+        FOR (i, 0, 16) {
+            s[i] = _mm256_set1_epi32((int)input[i]);
+        }
+        s[12] = _mm256_add_epi32(s[12], lanes);
+        FOR (i, 0, 16) {
+            x[i] = s[i];
+        }
+        FOR (i, 0, 10) {
+            AVX2_QUARTERROUND(x[0], x[4], x[ 8], x[12]);
+            AVX2_QUARTERROUND(x[1], x[5], x[ 9], x[13]);
+            AVX2_QUARTERROUND(x[2], x[6], x[10], x[14]);
+            AVX2_QUARTERROUND(x[3], x[7], x[11], x[15]);
+            AVX2_QUARTERROUND(x[0], x[5], x[10], x[15]);
+            AVX2_QUARTERROUND(x[1], x[6], x[11], x[12]);
+            AVX2_QUARTERROUND(x[2], x[7], x[ 8], x[13]);
+            AVX2_QUARTERROUND(x[3], x[4], x[ 9], x[14]);
+        }
+        FOR (i, 0, 16) {
+            x[i] = _mm256_add_epi32(x[i], s[i]);
+        }
+        // x[4g+j], lane k now holds words 4g..4g+3 of block 4k+j
+        FOR (g, 0, 4) {
+            AVX2_TRANSPOSE4(x[4*g], x[4*g+1], x[4*g+2], x[4*g+3]);
+        }
+        FOR (j, 0, 4) {
+            u8       *o = out + j * 64;
+            const u8 *p = in  ? in  + j * 64 : 0;
+            __m256i lo0 = _mm256_permute2x128_si256(x[j], x[4+j],  0x20);
+            __m256i hi0 = _mm256_permute2x128_si256(x[8+j], x[12+j], 0x20);
+            __m256i lo1 = _mm256_permute2x128_si256(x[j], x[4+j],  0x31);
+            __m256i hi1 = _mm256_permute2x128_si256(x[8+j], x[12+j], 0x31);
+            avx2_store(o      , p ? p       : 0, lo0);
+            avx2_store(o +  32, p ? p +  32 : 0, hi0);
+            avx2_store(o + 256, p ? p + 256 : 0, lo1);
+            avx2_store(o + 288, p ? p + 288 : 0, hi1);
+        }
+        input[12] += 8;
+        out       += 512;
+        if (in != 0) {
+            in += 512;
+        }
+        done += 8;
+    }
+    return done;
+}
+
+#define AVX512_QUARTERROUND(a, b, c, d)                                     \
+    a = _mm512_add_epi32(a, b);  d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 16); \
+    c = _mm512_add_epi32(c, d);  b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 12); \
+    a = _mm512_add_epi32(a, b);  d = _mm512_rol_epi32(_mm512_xor_si512(d, a),  8); \
+    c = _mm512_add_epi32(c, d);  b = _mm512_rol_epi32(_mm512_xor_si512(b, c),  7)
+
+#define AVX512_TRANSPOSE4(a, b, c, d) do {                                  \
+    __m512i t0_ = _mm512_unpacklo_epi32(a, b);                              \
+    __m512i t1_ = _mm512_unpackhi_epi32(a, b);                              \
+    __m512i t2_ = _mm512_unpacklo_epi32(c, d);                              \
+    __m512i t3_ = _mm512_unpackhi_epi32(c, d);                              \
+    a = _mm512_unpacklo_epi64(t0_, t2_);                                    \
+    b = _mm512_unpackhi_epi64(t0_, t2_);                                    \
+    c = _mm512_unpacklo_epi64(t1_, t3_);                                    \
+    d = _mm512_unpackhi_epi64(t1_, t3_);                                    \
+    } while (0)
+
+static __attribute__((target("avx512f")))
+void avx512_store(u8 *out, const u8 *in, __m512i v)
+{
+    if (in != 0) {
+        v = _mm512_xor_si512(v, _mm512_loadu_si512((const void*)in));
+    }
+    _mm512_storeu_si512((void*)out, v);
+}
+
+// 16 blocks at a time
+static __attribute__((target("avx512f")))
+size_t chacha20_avx512(u32 input[16], u8 *out, const u8 *in, size_t nb_blocks)
+{
+    const __m512i lanes = _mm512_setr_epi32(0, 1,  2,  3,  4,  5,  6,  7,
+                                            8, 9, 10, 11, 12, 13, 14, 15);
+    size_t done = 0;
+    while (nb_blocks - done >= 16 && input[12] <= 0xffffffff - 16) {
+        __m512i s[16], x[16];
+        FOR (i, 0, 16) {
+            s[i] = _mm512_set1_epi32((int)input[i]);
+        }
+        s[12] = _mm512_add_epi32(s[12], lanes);
+        FOR (i, 0, 16) {
+            x[i] = s[i];
+        }
+        FOR (i, 0, 10) {
+            AVX512_QUARTERROUND(x[0], x[4], x[ 8], x[12]);
+            AVX512_QUARTERROUND(x[1], x[5], x[ 9], x[13]);
+            AVX512_QUARTERROUND(x[2], x[6], x[10], x[14]);
+            AVX512_QUARTERROUND(x[3], x[7], x[11], x[15]);
+            AVX512_QUARTERROUND(x[0], x[5], x[10], x[15]);
+            AVX512_QUARTERROUND(x[1], x[6], x[11], x[12]);
+            AVX512_QUARTERROUND(x[2], x[7], x[ 8], x[13]);
+            AVX512_QUARTERROUND(x[3], x[4], x[ 9], x[14]);
+        }
+        FOR (i, 0, 16) {
+            x[i] = _mm512_add_epi32(x[i], s[i]);
+        }
+        // x[4g+j], lane k now holds words 4g..4g+3 of block 4k+j
+        FOR (g, 0, 4) {
+            AVX512_TRANSPOSE4(x[4*g], x[4*g+1], x[4*g+2], x[4*g+3]);
+        }
+        // transpose the 128-bit lanes of x[j], x[4+j], x[8+j], x[12+j]
+        FOR (j, 0, 4) {
+            __m512i t0 = _mm512_shuffle_i32x4(x[  j], x[ 4+j], 0x44);
+            __m512i t1 = _mm512_shuffle_i32x4(x[  j], x[ 4+j], 0xee);
+            __m512i t2 = _mm512_shuffle_i32x4(x[8+j], x[12+j], 0x44);
+            __m512i t3 = _mm512_shuffle_i32x4(x[8+j], x[12+j], 0xee);
+            __m512i b[4];
+            b[0] = _mm512_shuffle_i32x4(t0, t2, 0x88);
+            b[1] = _mm512_shuffle_i32x4(t0, t2, 0xdd);
+            b[2] = _mm512_shuffle_i32x4(t1, t3, 0x88);
+            b[3] = _mm512_shuffle_i32x4(t1, t3, 0xdd);
+            FOR (k, 0, 4) {
+                size_t offset = (4 * k + j) * 64;
+                avx512_store(out + offset, in ? in + offset : 0, b[k]);
+            }
+        }
+        input[12] += 16;
+        out       += 1024;
+        if (in != 0) {
+            in += 1024;
+        }
+        done += 16;
+    }
+    return done;
+}
+
+#elif !defined(MONOCYPHER_NO_SIMD) && defined(__aarch64__) \
+    && defined(__ARM_NEON) && defined(__ORDER_LITTLE_ENDIAN__) \
+    && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SIMD_NEON
+#include <arm_neon.h>
+
+#define NEON_ROTL(x, n) vsliq_n_u32(vshrq_n_u32(x, 32 - (n)), x, n)
+#define NEON_ROTL16(x) \
+    vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(x)))
+#define NEON_QUARTERROUND(a, b, c, d)                               \
+    a = vaddq_u32(a, b);  d = NEON_ROTL16(veorq_u32(d, a));         \
+    c = vaddq_u32(c, d);  b = NEON_ROTL(veorq_u32(b, c), 12);       \
+    a = vaddq_u32(a, b);  d = NEON_ROTL(veorq_u32(d, a),  8);       \
+    c = vaddq_u32(c, d);  b = NEON_ROTL(veorq_u32(b, c),  7)
+
+#define NEON_ZIP64(f, a, b) vreinterpretq_u32_u64(                  \
+    f(vreinterpretq_u64_u32(a), vreinterpretq_u64_u32(b)))
+#define NEON_TRANSPOSE4(a, b, c, d) do {                            \
+    uint32x4_t t0_ = vzip1q_u32(a, b);                              \
+    uint32x4_t t1_ = vzip2q_u32(a, b);                              \
+    uint32x4_t t2_ = vzip1q_u32(c, d);                              \
+    uint32x4_t t3_ = vzip2q_u32(c, d);                              \
+    a = NEON_ZIP64(vzip1q_u64, t0_, t2_);                           \
+    b = NEON_ZIP64(vzip2q_u64, t0_, t2_);                           \
+    c = NEON_ZIP64(vzip1q_u64, t1_, t3_);                           \
+    d = NEON_ZIP64(vzip2q_u64, t1_, t3_);                           \
+    } while (0)
+
+// 4 blocks at a time
+static size_t chacha20_neon(u32 input[16], u8 *out, const u8 *in,
+                            size_t nb_blocks)
+{
+    const uint32_t lane_init[4] = { 0, 1, 2, 3 };
+    const uint32x4_t lanes = vld1q_u32(lane_init);
+    size_t done = 0;
+    while (nb_blocks - done >= 4 && input[12] <= 0xffffffff - 4) {
+        uint32x4_t s[16], x[16];
+        FOR (i, 0, 16) {
+            s[i] = vdupq_n_u32(input[i]);
+        }
+        s[12] = vaddq_u32(s[12], lanes);
+        FOR (i, 0, 16) {
+            x[i] = s[i];
+        }
+        FOR (i, 0, 10) {
+            NEON_QUARTERROUND(x[0], x[4], x[ 8], x[12]);
+            NEON_QUARTERROUND(x[1], x[5], x[ 9], x[13]);
+            NEON_QUARTERROUND(x[2], x[6], x[10], x[14]);
+            NEON_QUARTERROUND(x[3], x[7], x[11], x[15]);
+            NEON_QUARTERROUND(x[0], x[5], x[10], x[15]);
+            NEON_QUARTERROUND(x[1], x[6], x[11], x[12]);
+            NEON_QUARTERROUND(x[2], x[7], x[ 8], x[13]);
+            NEON_QUARTERROUND(x[3], x[4], x[ 9], x[14]);
+        }
+        FOR (i, 0, 16) {
+            x[i] = vaddq_u32(x[i], s[i]);
+        }
+        // x[4g+j] now holds words 4g..4g+3 of block j
+        FOR (g, 0, 4) {
+            NEON_TRANSPOSE4(x[4*g], x[4*g+1], x[4*g+2], x[4*g+3]);
+        }
+        FOR (j, 0, 4) {
+            FOR (g, 0, 4) {
+                size_t     offset = j * 64 + g * 16;
+                uint32x4_t v      = x[4*g + j];
+                if (in != 0) {
+                    v = veorq_u32(v, vreinterpretq_u32_u8(vld1q_u8(in + offset)));
+                }
+                vst1q_u8(out + offset, vreinterpretq_u8_u32(v));
+            }
+        }
+        input[12] += 4;
+        out       += 256;
+        if (in != 0) {
+            in += 256;
+        }
+        done += 4;
+    }
+    return done;
+}
+#endif
+
+// Processes as many whole blocks as the available kernels can, and
+// returns how many.  Updates the counter in input[12].
+static size_t chacha20_simd(u32 input[16], u8 *out, const u8 *in,
+                            size_t nb_blocks)
+{
+    size_t done = 0;
+#if defined(SIMD_X86)
+    if (nb_blocks >= 16 && __builtin_cpu_supports("avx512f")) {
+        done += chacha20_avx512(input, out, in, nb_blocks);
+    }
+    if (nb_blocks - done >= 8 && __builtin_cpu_supports("avx2")) {
+        done += chacha20_avx2(input, out + done * 64, in ? in + done * 64 : 0,
+                              nb_blocks - done);
+    }
+#elif defined(SIMD_NEON)
+    // Advanced SIMD is part of the AArch64 base architecture
+    done += chacha20_neon(input, out, in, nb_blocks);
+#else
+    (void)input; (void)out; (void)in; (void)nb_blocks;
+#endif
+    return done;
+}
+
 static u64 chacha20_core(u32 input[16], u8 *cipher_text, const u8 *plain_text,
                          size_t text_size)
 {
-    // Whole blocks
+    // Whole blocks, as many as possible with SIMD...
     u32    pool[16];
     size_t nb_blocks = text_size >> 6;
-    FOR (i, 0, nb_blocks) {
+    size_t nb_simd   = chacha20_simd(input, cipher_text, plain_text, nb_blocks);
+    cipher_text += nb_simd * 64;
+    if (plain_text != 0) {
+        plain_text += nb_simd * 64;
+    }
+    // ...then the rest
+    FOR (i, nb_simd, nb_blocks) {
         chacha20_rounds(pool, input);
         if (plain_text != 0) {
             FOR (j, 0, 16) {
@@ -375,6 +676,182 @@ static void poly_block(crypto_poly1305_ctx *ctx)
     ctx->h[4] = (u32)u4; // u4 <=          4
 }
 
+// Multi-block SIMD Poly1305 (extension, not part of upstream Monocypher)
+// ----------------------------------------------------------------------
+// 4 interleaved accumulators in radix 2^26, one per 64-bit vector lane.
+// Each lane computes h_j = h_j * r^4 + m_(4i+j); the lanes are multiplied
+// by r^4, r^3, r^2, r^1 at the end and summed.  That is the same
+// polynomial as the block by block evaluation, so the MAC is identical.
+#define POLY_SIMD_MIN_BLOCKS 16
+#define POLY_MASK26          0x3ffffff
+
+// a * b mod 2^130-5, partially reduced (limbs < 2^26 but h1 < 2^26 + 2^9)
+static void poly26_mul(u64 h[5], const u64 a[5], const u64 b[5])
+{
+    const u64 s1 = b[1] * 5, s2 = b[2] * 5, s3 = b[3] * 5, s4 = b[4] * 5;
+    u64 d0 = a[0]*b[0] + a[1]*s4   + a[2]*s3   + a[3]*s2   + a[4]*s1;
+    u64 d1 = a[0]*b[1] + a[1]*b[0] + a[2]*s4   + a[3]*s3   + a[4]*s2;
+    u64 d2 = a[0]*b[2] + a[1]*b[1] + a[2]*b[0] + a[3]*s4   + a[4]*s3;
+    u64 d3 = a[0]*b[3] + a[1]*b[2] + a[2]*b[1] + a[3]*b[0] + a[4]*s4;
+    u64 d4 = a[0]*b[4] + a[1]*b[3] + a[2]*b[2] + a[3]*b[1] + a[4]*b[0];
+    d1 += d0 >> 26;  d0 &= POLY_MASK26;
+    d2 += d1 >> 26;  d1 &= POLY_MASK26;
+    d3 += d2 >> 26;  d2 &= POLY_MASK26;
+    d4 += d3 >> 26;  d3 &= POLY_MASK26;
+    d0 += (d4 >> 26) * 5;  d4 &= POLY_MASK26;
+    d1 += d0 >> 26;  d0 &= POLY_MASK26;
+    h[0] = d0;  h[1] = d1;  h[2] = d2;  h[3] = d3;  h[4] = d4;
+}
+
+// 32-bit limbs (value < 2^131) to 26-bit limbs
+static void poly26_load(u64 out[5], const u32 in[5])
+{
+    out[0] = ( in[0]                          ) & POLY_MASK26;
+    out[1] = ((in[0] >> 26) | ((u64)in[1] <<  6)) & POLY_MASK26;
+    out[2] = ((in[1] >> 20) | ((u64)in[2] << 12)) & POLY_MASK26;
+    out[3] = ((in[2] >> 14) | ((u64)in[3] << 18)) & POLY_MASK26;
+    out[4] = ( in[3] >>  8) | ((u64)in[4] << 24);
+}
+
+// 26-bit limbs (slightly over is fine) to 32-bit limbs
+static void poly26_store(u32 out[5], const u64 in[5])
+{
+    u64 t;
+    t = in[0] + (in[1] << 26);              out[0] = (u32)t;  t >>= 32;
+    t += in[2] << 20;                       out[1] = (u32)t;  t >>= 32;
+    t += in[3] << 14;                       out[2] = (u32)t;  t >>= 32;
+    t += in[4] <<  8;                       out[3] = (u32)t;  t >>= 32;
+    out[4] = (u32)t;
+}
+
+#if defined(SIMD_X86)
+#define AVX2_MUL(a, b) _mm256_mul_epu32(a, b)
+#define AVX2_ADD(a, b) _mm256_add_epi64(a, b)
+
+// h = h * r, lane by lane.  s = 5 * r
+static __attribute__((target("avx2")))
+void avx2_poly_mul(__m256i h[5], const __m256i r[5], const __m256i s[5])
+{
+    const __m256i mask = _mm256_set1_epi64x(POLY_MASK26);
+    __m256i d0, d1, d2, d3, d4, c;
+    d0 = AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_MUL(h[0], r[0]),
+         AVX2_MUL(h[1], s[4])), AVX2_MUL(h[2], s[3])),
+         AVX2_MUL(h[3], s[2])), AVX2_MUL(h[4], s[1]));
+    d1 = AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_MUL(h[0], r[1]),
+         AVX2_MUL(h[1], r[0])), AVX2_MUL(h[2], s[4])),
+         AVX2_MUL(h[3], s[3])), AVX2_MUL(h[4], s[2]));
+    d2 = AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_MUL(h[0], r[2]),
+         AVX2_MUL(h[1], r[1])), AVX2_MUL(h[2], r[0])),
+         AVX2_MUL(h[3], s[4])), AVX2_MUL(h[4], s[3]));
+    d3 = AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_MUL(h[0], r[3]),
+         AVX2_MUL(h[1], r[2])), AVX2_MUL(h[2], r[1])),
+         AVX2_MUL(h[3], r[0])), AVX2_MUL(h[4], s[4]));
+    d4 = AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_ADD(AVX2_MUL(h[0], r[4]),
+         AVX2_MUL(h[1], r[3])), AVX2_MUL(h[2], r[2])),
+         AVX2_MUL(h[3], r[1])), AVX2_MUL(h[4], r[0]));
+    c = _mm256_srli_epi64(d0, 26);  d0 = _mm256_and_si256(d0, mask);
+    d1 = AVX2_ADD(d1, c);
+    c = _mm256_srli_epi64(d1, 26);  d1 = _mm256_and_si256(d1, mask);
+    d2 = AVX2_ADD(d2, c);
+    c = _mm256_srli_epi64(d2, 26);  d2 = _mm256_and_si256(d2, mask);
+    d3 = AVX2_ADD(d3, c);
+    c = _mm256_srli_epi64(d3, 26);  d3 = _mm256_and_si256(d3, mask);
+    d4 = AVX2_ADD(d4, c);
+    c = _mm256_srli_epi64(d4, 26);  d4 = _mm256_and_si256(d4, mask);
+    d0 = AVX2_ADD(d0, AVX2_ADD(c, _mm256_slli_epi64(c, 2))); // c * 5
+    c = _mm256_srli_epi64(d0, 26);  d0 = _mm256_and_si256(d0, mask);
+    d1 = AVX2_ADD(d1, c);
+    h[0] = d0;  h[1] = d1;  h[2] = d2;  h[3] = d3;  h[4] = d4;
+}
+
+// h += 4 message blocks.  Lanes hold blocks 0, 2, 1, 3 (in that order)
+static __attribute__((target("avx2")))
+void avx2_poly_add(__m256i h[5], const u8 *message)
+{
+    const __m256i mask  = _mm256_set1_epi64x(POLY_MASK26);
+    const __m256i hibit = _mm256_set1_epi64x(1 << 24);
+    __m256i a  = _mm256_loadu_si256((const __m256i*)(message     ));
+    __m256i b  = _mm256_loadu_si256((const __m256i*)(message + 32));
+    __m256i lo = _mm256_unpacklo_epi64(a, b);
+    __m256i hi = _mm256_unpackhi_epi64(a, b);
+    h[0] = AVX2_ADD(h[0], _mm256_and_si256(lo, mask));
+    h[1] = AVX2_ADD(h[1], _mm256_and_si256(_mm256_srli_epi64(lo, 26), mask));
+    h[2] = AVX2_ADD(h[2], _mm256_and_si256(
+               _mm256_or_si256(_mm256_srli_epi64(lo, 52),
+                               _mm256_slli_epi64(hi, 12)), mask));
+    h[3] = AVX2_ADD(h[3], _mm256_and_si256(_mm256_srli_epi64(hi, 14), mask));
+    h[4] = AVX2_ADD(h[4], _mm256_or_si256(_mm256_srli_epi64(hi, 40), hibit));
+}
+
+static __attribute__((target("avx2")))
+size_t poly_blocks_avx2(crypto_poly1305_ctx *ctx, const u8 *message,
+                        size_t nb_blocks)
+{
+    // powers of r
+    u32 r [5] = { ctx->r[0], ctx->r[1], ctx->r[2], ctx->r[3], 0 };
+    u64 r1[5], r2[5], r3[5], r4[5], h[5];
+    poly26_load(r1, r);
+    poly26_mul(r2, r1, r1);
+    poly26_mul(r3, r2, r1);
+    poly26_mul(r4, r2, r2);
+    poly26_load(h, ctx->h);
+
+    __m256i vh[5], vr[5], vs[5], pr[5], ps[5];
+    FOR (i, 0, 5) {
+        vr[i] = _mm256_set1_epi64x((long long)r4[i]);
+        vs[i] = _mm256_set1_epi64x((long long)(r4[i] * 5));
+        // final powers, lanes in block order 0, 2, 1, 3
+        pr[i] = _mm256_setr_epi64x((long long)r4[i], (long long)r2[i],
+                                   (long long)r3[i], (long long)r1[i]);
+        ps[i] = _mm256_add_epi64(pr[i], _mm256_slli_epi64(pr[i], 2));
+    }
+    FOR (i, 0, 5) {
+        vh[i] = _mm256_setr_epi64x((long long)h[i], 0, 0, 0);
+    }
+
+    size_t nb_groups = nb_blocks >> 2;
+    avx2_poly_add(vh, message);
+    FOR (i, 1, nb_groups) {
+        avx2_poly_mul(vh, vr, vs);
+        avx2_poly_add(vh, message + i * 64);
+    }
+    avx2_poly_mul(vh, pr, ps);
+
+    // sum the lanes, then carry
+    u64 lanes[4];
+    FOR (i, 0, 5) {
+        _mm256_storeu_si256((__m256i*)lanes, vh[i]);
+        h[i] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    h[1] += h[0] >> 26;  h[0] &= POLY_MASK26;
+    h[2] += h[1] >> 26;  h[1] &= POLY_MASK26;
+    h[3] += h[2] >> 26;  h[2] &= POLY_MASK26;
+    h[4] += h[3] >> 26;  h[3] &= POLY_MASK26;
+    h[0] += (h[4] >> 26) * 5;  h[4] &= POLY_MASK26;
+    h[1] += h[0] >> 26;  h[0] &= POLY_MASK26;
+    poly26_store(ctx->h, h); // h < 2^130 + 2^27, so ctx->h[4] <= 4
+
+    WIPE_BUFFER(r );  WIPE_BUFFER(r1);  WIPE_BUFFER(r2);  WIPE_BUFFER(r3);  WIPE_BUFFER(r4);
+    WIPE_BUFFER(h);
+    return nb_groups * 4;
+}
+#endif
+
+// Processes as many whole blocks as the available kernel can,
+// and returns how many.
+static size_t poly_simd(crypto_poly1305_ctx *ctx, const u8 *message,
+                        size_t nb_blocks)
+{
+#if defined(SIMD_X86)
+    if (nb_blocks >= POLY_SIMD_MIN_BLOCKS && __builtin_cpu_supports("avx2")) {
+        return poly_blocks_avx2(ctx, message, nb_blocks);
+    }
+#else
+    (void)ctx; (void)message; (void)nb_blocks;
+#endif
+    return 0;
+}
+
 // (re-)initialises the input counter and input buffer
 static void poly_clear_c(crypto_poly1305_ctx *ctx)
 {
@@ -428,9 +905,12 @@ void crypto_poly1305_update(crypto_poly1305_ctx *ctx,
     message      += aligned;
     message_size -= aligned;
 
-    // Process the message block by block
+    // Process the message 4 blocks at a time with SIMD if we can...
     size_t nb_blocks = message_size >> 4;
-    FOR (i, 0, nb_blocks) {
+    size_t nb_simd   = poly_simd(ctx, message, nb_blocks);
+    message += nb_simd * 16;
+    // ...then block by block
+    FOR (i, nb_simd, nb_blocks) {
         load32_le_buf(ctx->c, message, 4);
         poly_block(ctx);
         message += 16;
@@ -849,6 +1329,8 @@ typedef struct {
     block b;
     u32 pass_number;
     u32 slice_number;
+    u32 lane;
+    u32 nb_lanes;
     u32 nb_blocks;
     u32 nb_iterations;
     u32 ctr;
@@ -863,7 +1345,7 @@ static void gidx_refresh(gidx_ctx *ctx)
 {
     // seed the beginning of the block...
     ctx->b.a[0] = ctx->pass_number;
-    ctx->b.a[1] = 0;  // lane number (we have only one)
+    ctx->b.a[1] = ctx->lane;
     ctx->b.a[2] = ctx->slice_number;
     ctx->b.a[3] = ctx->nb_blocks;
     ctx->b.a[4] = ctx->nb_iterations;
@@ -881,10 +1363,13 @@ static void gidx_refresh(gidx_ctx *ctx)
 
 static void gidx_init(gidx_ctx *ctx,
                       u32 pass_number, u32 slice_number,
+                      u32 lane,        u32 nb_lanes,
                       u32 nb_blocks,   u32 nb_iterations)
 {
     ctx->pass_number   = pass_number;
     ctx->slice_number  = slice_number;
+    ctx->lane          = lane;
+    ctx->nb_lanes      = nb_lanes;
     ctx->nb_blocks     = nb_blocks;
     ctx->nb_iterations = nb_iterations;
     ctx->ctr           = 0;
@@ -901,7 +1386,9 @@ static void gidx_init(gidx_ctx *ctx,
     }
 }
 
-static u32 gidx_next(gidx_ctx *ctx)
+// Returns the reference block's index within its lane,
+// and the lane itself in ref_lane.
+static u32 gidx_next(gidx_ctx *ctx, u32 *ref_lane)
 {
     // lazily creates the offset block we need
     if ((ctx->offset & 127) == 0) {
@@ -912,16 +1399,30 @@ static u32 gidx_next(gidx_ctx *ctx)
     u32 offset = ctx->offset;       // save offset for current call
     ctx->offset++;                  // update offset for next call
 
+    // J1 selects the block, J2 the lane.  The first slice of the
+    // first pass can only reference its own lane.
+    u64 j1         = ctx->b.a[index] & 0xffffffff; // pseudo-random number
+    u32 j2         = (u32)(ctx->b.a[index] >> 32);
+    int first_pass = ctx->pass_number == 0;
+    u32 lane       = first_pass && ctx->slice_number == 0
+                   ? ctx->lane
+                   : j2 % ctx->nb_lanes;
+    *ref_lane = lane;
+
     // Computes the area size.
     // Pass 0 : all already finished segments plus already constructed
     //          blocks in this segment
     // Pass 1+: 3 last segments plus already constructed
     //          blocks in this segment.  THE SPEC SUGGESTS OTHERWISE.
     //          I CONFORM TO THE REFERENCE IMPLEMENTATION.
-    int first_pass  = ctx->pass_number == 0;
-    u32 slice_size  = ctx->nb_blocks >> 2;
+    // Other lanes only expose their finished segments, minus the
+    // last block if we are at the start of our segment.
+    u32 lane_size   = ctx->nb_blocks / ctx->nb_lanes;
+    u32 slice_size  = lane_size >> 2;
     u32 nb_segments = first_pass ? ctx->slice_number : 3;
-    u32 area_size   = nb_segments * slice_size + offset - 1;
+    u32 area_size   = lane == ctx->lane
+                    ? nb_segments * slice_size + offset - 1
+                    : nb_segments * slice_size - (offset == 0);
 
     // Computes the starting position of the reference area.
     // CONTRARY TO WHAT THE SPEC SUGGESTS, IT STARTS AT THE
@@ -929,31 +1430,88 @@ static u32 gidx_next(gidx_ctx *ctx)
     u32 next_slice = ((ctx->slice_number + 1) & 3) * slice_size;
     u32 start_pos  = first_pass ? 0 : next_slice;
 
-    // Generate offset from J1 (no need for J2, there's only one lane)
-    u64 j1  = ctx->b.a[index] & 0xffffffff; // pseudo-random number
+    // Generate offset from J1
     u64 x   = (j1 * j1)       >> 32;
     u64 y   = (area_size * x) >> 32;
     u64 z   = (area_size - 1) - y;
-    u64 ref = start_pos + z;                // ref < 2 * nb_blocks
-    return (u32)(ref < ctx->nb_blocks ? ref : ref - ctx->nb_blocks);
+    u64 ref = start_pos + z;                // ref < 2 * lane_size
+    return (u32)(ref < lane_size ? ref : ref - lane_size);
+}
+
+typedef struct {
+    block *blocks;
+    u32    nb_blocks;
+    u32    nb_iterations;
+    u32    nb_lanes;
+    u32    pass_number;
+    u32    segment;
+} argon2_ctx;
+
+// Fills one segment of one lane.  Segments of the same slice
+// are independent from each other.
+static void fill_segment(void *fill_ctx, u32 lane)
+{
+    const argon2_ctx *actx = (const argon2_ctx*)fill_ctx;
+    const u32 lane_size    = actx->nb_blocks / actx->nb_lanes;
+    const u32 segment_size = lane_size >> 2;
+    const u32 segment      = actx->segment;
+    const int first_pass   = actx->pass_number == 0;
+    block *lane_blocks     = actx->blocks + lane * lane_size;
+
+    block tmp;
+    gidx_ctx ctx; // public information, no need to wipe
+    gidx_init(&ctx, actx->pass_number, segment, lane, actx->nb_lanes,
+              actx->nb_blocks, actx->nb_iterations);
+
+    // On the first segment of the first pass,
+    // blocks 0 and 1 are already filled.
+    // We use the offset to skip them.
+    u32 start_offset  = first_pass && segment == 0 ? 2 : 0;
+    u32 segment_start = segment * segment_size + start_offset;
+    u32 segment_end   = (segment + 1) * segment_size;
+    FOR_T (u32, current_block, segment_start, segment_end) {
+        u32 ref_lane;
+        u32 reference_block = gidx_next(&ctx, &ref_lane);
+        u32 previous_block  = current_block == 0
+                            ? lane_size - 1
+                            : current_block - 1;
+        block *c = lane_blocks + current_block;
+        block *p = lane_blocks + previous_block;
+        block *r = actx->blocks + ref_lane * lane_size + reference_block;
+        if (first_pass) { g_copy(c, p, r, &tmp); }
+        else            { g_xor (c, p, r, &tmp); }
+    }
+    wipe_block(&tmp);
+}
+
+static void run_lanes(void *run_ctx, crypto_argon2_fill *fill,
+                      void *fill_ctx, u32 nb_lanes)
+{
+    (void)run_ctx;
+    FOR_T (u32, lane, 0, nb_lanes) {
+        fill(fill_ctx, lane);
+    }
 }
 
 // Main algorithm
-void crypto_argon2i_general(u8       *hash,      u32 hash_size,
-                            void     *work_area, u32 nb_blocks,
-                            u32 nb_iterations,
-                            const u8 *password,  u32 password_size,
-                            const u8 *salt,      u32 salt_size,
-                            const u8 *key,       u32 key_size,
-                            const u8 *ad,        u32 ad_size)
+void crypto_argon2i_lanes(u8       *hash,      u32 hash_size,
+                          void     *work_area, u32 nb_blocks,
+                          u32 nb_iterations,   u32 nb_lanes,
+                          const u8 *password,  u32 password_size,
+                          const u8 *salt,      u32 salt_size,
+                          const u8 *key,       u32 key_size,
+                          const u8 *ad,        u32 ad_size,
+                          crypto_argon2_run *run, void *run_ctx)
 {
     // work area seen as blocks (must be suitably aligned)
     block *blocks = (block*)work_area;
+    // Actual number of blocks: 4 segments per lane
+    const u32 lane_size = nb_blocks / (4 * nb_lanes) * 4;
     {
         crypto_blake2b_ctx ctx;
         crypto_blake2b_init(&ctx);
 
-        blake_update_32      (&ctx, 1            ); // p: number of threads
+        blake_update_32      (&ctx, nb_lanes     ); // p: number of threads
         blake_update_32      (&ctx, hash_size    );
         blake_update_32      (&ctx, nb_blocks    );
         blake_update_32      (&ctx, nb_iterations);
@@ -971,69 +1529,78 @@ void crypto_argon2i_general(u8       *hash,      u32 hash_size,
         u8 initial_hash[72]; // 64 bytes plus 2 words for future hashes
         crypto_blake2b_final(&ctx, initial_hash);
 
-        // fill first 2 blocks
+        // fill first 2 blocks of each lane
         block tmp_block;
         u8    hash_area[1024];
-        store32_le(initial_hash + 64, 0); // first  additional word
-        store32_le(initial_hash + 68, 0); // second additional word
-        extended_hash(hash_area, 1024, initial_hash, 72);
-        load_block(&tmp_block, hash_area);
-        copy_block(blocks, &tmp_block);
-
-        store32_le(initial_hash + 64, 1); // slight modification
-        extended_hash(hash_area, 1024, initial_hash, 72);
-        load_block(&tmp_block, hash_area);
-        copy_block(blocks + 1, &tmp_block);
+        FOR_T (u32, lane, 0, nb_lanes) {
+            store32_le(initial_hash + 64, 0   ); // first  additional word
+            store32_le(initial_hash + 68, lane); // second additional word
+            extended_hash(hash_area, 1024, initial_hash, 72);
+            load_block(&tmp_block, hash_area);
+            copy_block(blocks + lane * lane_size, &tmp_block);
+
+            store32_le(initial_hash + 64, 1); // slight modification
+            extended_hash(hash_area, 1024, initial_hash, 72);
+            load_block(&tmp_block, hash_area);
+            copy_block(blocks + lane * lane_size + 1, &tmp_block);
+        }
 
         WIPE_BUFFER(initial_hash);
         WIPE_BUFFER(hash_area);
         wipe_block(&tmp_block);
     }
 
-    // Actual number of blocks
-    nb_blocks -= nb_blocks & 3; // round down to 4 p (p == 1 thread)
-    const u32 segment_size = nb_blocks >> 2;
+    nb_blocks = lane_size * nb_lanes;
+    if (run == 0) {
+        run = run_lanes;
+    }
 
     // fill (then re-fill) the rest of the blocks
-    block tmp;
-    gidx_ctx ctx; // public information, no need to wipe
+    argon2_ctx actx;
+    actx.blocks        = blocks;
+    actx.nb_blocks     = nb_blocks;
+    actx.nb_iterations = nb_iterations;
+    actx.nb_lanes      = nb_lanes;
     FOR_T (u32, pass_number, 0, nb_iterations) {
-        int first_pass = pass_number == 0;
-
         FOR_T (u32, segment, 0, 4) {
-            gidx_init(&ctx, pass_number, segment, nb_blocks, nb_iterations);
-
-            // On the first segment of the first pass,
-            // blocks 0 and 1 are already filled.
-            // We use the offset to skip them.
-            u32 start_offset  = first_pass && segment == 0 ? 2 : 0;
-            u32 segment_start = segment * segment_size + start_offset;
-            u32 segment_end   = (segment + 1) * segment_size;
-            FOR_T (u32, current_block, segment_start, segment_end) {
-                u32 reference_block = gidx_next(&ctx);
-                u32 previous_block  = current_block == 0
-                                    ? nb_blocks - 1
-                                    : current_block - 1;
-                block *c = blocks + current_block;
-                block *p = blocks + previous_block;
-                block *r = blocks + reference_block;
-                if (first_pass) { g_copy(c, p, r, &tmp); }
-                else            { g_xor (c, p, r, &tmp); }
-            }
+            actx.pass_number = pass_number;
+            actx.segment     = segment;
+            run(run_ctx, fill_segment, &actx, nb_lanes);
         }
     }
-    wipe_block(&tmp);
-    // hash the very last block with H' into the output hash
+
+    // hash the xor of the last block of each lane with H'
+    // into the output hash
+    block final;
+    copy_block(&final, blocks + (lane_size - 1));
+    FOR_T (u32, lane, 1, nb_lanes) {
+        xor_block(&final, blocks + (lane * lane_size + lane_size - 1));
+    }
     u8 final_block[1024];
-    store_block(final_block, blocks + (nb_blocks - 1));
+    store_block(final_block, &final);
     extended_hash(hash, hash_size, final_block, 1024);
     WIPE_BUFFER(final_block);
+    wipe_block(&final);
 
     // wipe work area
     volatile u64 *p = (u64*)work_area;
     ZERO(p, 128 * nb_blocks);
 }
 
+void crypto_argon2i_general(u8       *hash,      u32 hash_size,
+                            void     *work_area, u32 nb_blocks,
+                            u32 nb_iterations,
+                            const u8 *password,  u32 password_size,
+                            const u8 *salt,      u32 salt_size,
+                            const u8 *key,       u32 key_size,
+                            const u8 *ad,        u32 ad_size)
+{
+    crypto_argon2i_lanes(hash, hash_size, work_area, nb_blocks,
+                         nb_iterations, 1,
+                         password, password_size, salt, salt_size,
+                         key, key_size, ad, ad_size, 0, 0);
+}
+
 void crypto_argon2i(u8   *hash,      u32 hash_size,
                     void *work_area, u32 nb_blocks, u32 nb_iterations,
                     const u8 *password,  u32 password_size,
@@ -1478,12 +2045,7 @@ void crypto_x25519(u8       raw_shared_secret[32],
     WIPE_BUFFER(e);
 }
 
-void crypto_x25519_public_key(u8       public_key[32],
-                              const u8 secret_key[32])
-{
-    static const u8 base_point[32] = {9};
-    crypto_x25519(public_key, secret_key, base_point);
-}
+// crypto_x25519_public_key() is with the Edwards code, see below
 
 ///////////////////////////
 /// Arithmetic modulo L ///
@@ -1908,8 +2470,20 @@ static int ge_r_check(u8 R_check[32], u8 s[32], u8 h_ram[32], u8 pk[32])
     return 0;
 }
 
-// 5-bit signed comb in cached format (Niels coordinates, Z=1)
-static const ge_precomp b_comb[16] = {
+// 5-bit signed combs in cached format (Niels coordinates, Z=1).
+// MONOCYPHER_COMB_TABLES combs of spacing 51 / MONOCYPHER_COMB_TABLES
+// cover the 255 bits of the scalar:  more tables mean fewer doublings
+// in ge_scalarmult_base(), at 1.9KB of table each.  1 is upstream
+// Monocypher; the tables are printed by gen_comb.c.
+// (extension, not part of upstream Monocypher)
+#ifndef MONOCYPHER_COMB_TABLES
+#define MONOCYPHER_COMB_TABLES 3
+#endif
+#define COMB_SPACING (51 / MONOCYPHER_COMB_TABLES)
+
+#if MONOCYPHER_COMB_TABLES == 1
+static const ge_precomp b_comb[1][16] = {
+  {
     {{2615675,9989699,17617367,-13953520,-8802803,
       1447286,-8909978,-270892,-12199203,-11617247,},
      {8873912,14981221,13714139,6923085,25481101,
@@ -2006,7 +2580,1977 @@ static const ge_precomp b_comb[16] = {
       -1572144,-41927,9269803,13881712,-13439497,},
      {-25233439,-9389070,-6618212,-3268087,-521386,
       -7350198,21035059,-14970947,25910190,11122681,},},
+  },
+};
+#elif MONOCYPHER_COMB_TABLES == 3
+static const ge_precomp b_comb[3][16] = {
+  {
+    {{-4669083,-583741,-13268794,-2145484,-7826595,
+      -7738999,20177361,5879077,-16006510,1541109,},
+     {29095935,2599207,1224862,3516382,27107368,
+      -11672506,-10865674,-6391587,-11737472,9537186,},
+     {-19333943,-8992897,21728753,2921115,18932952,
+      8250464,-2192335,7144860,32135559,316090,},},
+    {{-22523013,16070626,1705088,-5534619,19414593,
+      315705,-9967352,-4605590,-28540860,1048361,},
+     {-17204097,-10258459,-18397830,-13031022,-24764766,
+      -8976103,18115878,5661983,11028223,1502533,},
+     {-4343023,1347973,-28194644,3472753,8761119,
+      -2163259,25499862,3910752,-31420890,2101927,},},
+    {{-23288929,11852663,-9726166,2136889,-5611835,
+      -1787852,-17836291,7633760,-32359332,11484351,},
+     {-32209965,3439500,-14839166,-11670302,-15824721,
+      11658016,20061482,4105215,4517276,-5118933,},
+     {17788081,9415887,-32891142,3310605,30337931,
+      308093,-497572,-10182987,-7099934,-9969705,},},
+    {{-21086271,-3920456,-25636655,-10302648,-31304765,
+      -2824310,-6763216,15330286,26588490,11537991,},
+     {-17230461,14304356,-20797606,-9617491,-17953108,
+      10021440,-15901883,-13118364,9136141,-3375621,},
+     {4996030,-9345084,15098585,-8187786,19943707,
+      -6124416,15156164,-12047446,-7486984,-14224931,},},
+    {{11500626,-1961954,21048256,-12883012,-20286823,
+      9339417,-27715848,11719539,9845969,692816,},
+     {18709398,7567823,-1744909,942483,8459987,
+      12559161,-26822884,4141345,11500942,4179851,},
+     {-13086834,-978772,32287346,-968052,-23806459,
+      7787881,13641740,-10467899,-14988483,4027045,},},
+    {{-24599845,15473489,-8365154,-4094935,-31590841,
+      -9603738,20101848,-963062,-23789928,-15280410,},
+     {-31220703,-6963434,3374192,-7618084,11495627,
+      6365405,31012956,6106337,-3953180,15821748,},
+     {24647595,-8353442,33217283,1627064,12252784,
+      12005158,32018345,-4533728,-19727280,8652269,},},
+    {{13401778,1011997,-6054464,-16021161,10524051,
+      -13005629,-31787354,-2966003,-18023537,13592478,},
+     {-7873064,-15315948,25795419,-10240902,26418886,
+      -4174938,-12253076,13923336,21928027,-4948114,},
+     {-31013953,15865236,-1325835,-10176227,5308690,
+      2911773,-5265002,-4894405,31561164,-3458141,},},
+    {{9440699,12691537,32816700,1609003,8280828,
+      -10035513,-27294119,-440545,-9207271,15623194,},
+     {31668114,-15882030,-32331576,-8658508,-22052379,
+      12731616,32861290,-12048829,23902173,13543561,},
+     {31676284,-14273756,20896835,6172109,4876314,
+      -13023236,25356824,283320,-14118942,-3380586,},},
+    {{-2565084,-14165414,10195956,5860782,28924985,
+      -1960080,26293763,-3320845,-23925282,-14519919,},
+     {2620262,-7954362,12264565,3973150,8201326,
+      6929904,30450414,6470,-30509154,176792,},
+     {10146485,-3703652,16673247,-12907423,1867734,
+      1710276,27656907,-6696117,14066098,1292638,},},
+    {{-21990429,-13566458,20435765,-15455794,-21304419,
+      -11361212,15281878,8380648,7538637,16754445,},
+     {13875491,-372744,1674198,7648087,32192506,
+      -11126913,6039955,6793967,-31236035,10039385,},
+     {-7709448,2898167,4527902,5362476,-18045571,
+      3777106,-32713723,15220455,-3115441,10940016,},},
+    {{-1224262,-3157182,9084863,-6397907,28542225,
+      -11071282,-4851225,12189446,-26435167,3226428,},
+     {-25881635,-3523256,-2116975,11551659,32175456,
+      6461776,-14547008,6240158,20136724,-13968194,},
+     {27486644,9341204,-14929238,-7395579,31827282,
+      13828748,-28810980,-3694251,32909683,-4449837,},},
+    {{-22726890,12351384,17424827,-2905389,6782475,
+      7859579,-19303740,-4667441,19930749,-859497,},
+     {8791034,1475212,8038847,9500161,16881513,
+      -4762756,19344968,11314814,7847922,13001425,},
+     {30432475,-2499375,-16573914,-6647580,-15065480,
+      8994828,26439709,-798615,31402646,-1094544,},},
+    {{4344154,2817731,17335774,14945098,-32633265,
+      1712092,25560287,9534069,-27942383,8080733,},
+     {-3176451,-9193462,9619628,8509313,-19906885,
+      -13179952,-26276577,-1961906,-22449661,6468629,},
+     {-23245489,-11161074,2484100,-9575880,-16386044,
+      -16126947,33484075,9253188,9034591,-5665234,},},
+    {{31795813,2633658,-29015233,10462612,25373399,
+      16656024,-7791768,-3706954,-8273753,-702342,},
+     {-15014933,13959538,-29923369,4965785,-23845780,
+      14856094,-18498593,-448651,-11663707,8005068,},
+     {-19793987,-12005456,-32276395,-16690618,3371679,
+      14458500,-6982978,4149500,23448657,-1696289,},},
+    {{27343639,9845183,14191731,3788372,-19054765,
+      -3374495,18931560,7863046,-2977039,3687653,},
+     {6711018,-10898571,-25098346,13083564,-25395757,
+      -3410147,19822873,-11554801,-22507991,-11268067,},
+     {16987883,-13180175,24124297,-2385113,-18314526,
+      -8590819,-17869524,-6863047,25167792,528665,},},
+    {{-9686885,-5953207,3406725,-4194264,760439,
+      2067214,20189415,10386462,-5198432,-2366894,},
+     {26872511,8481265,28579897,-9728714,-8206893,
+      3707166,-9018395,12824779,-25817153,9595373,},
+     {27141749,-14931366,-2896321,12561449,21014233,
+      -15238375,16475923,-1033646,17775861,-1936569,},},
+  },
+  {
+    {{12921490,-14284992,32229833,13330149,-18404184,
+      -2689481,11026280,16176264,22181688,677770,},
+     {-10817046,10199553,17415150,696799,-3841064,
+      14143419,30530262,15615661,27385928,11099219,},
+     {4093709,-1480420,21910301,2845603,26255600,
+      13994959,-27789260,13800754,-28245519,-11763157,},},
+    {{-1761346,-15286956,4769569,-10668773,14738659,
+      5016068,27321381,12114206,16504152,-4541671,},
+     {16538534,7700102,-17666497,-1708738,29625012,
+      -3800609,-19163290,5703264,28580119,-15900272,},
+     {-3825979,12344022,25235090,-12510710,-22660792,
+      4282573,17164118,-10105762,6155294,159092,},},
+    {{-6524892,10429845,-9593489,-2521802,30868482,
+      4021966,31065074,-3106341,-24301180,-16650812,},
+     {1233233,14375589,10457119,149455,6559267,
+      2413925,17897956,-3428087,-6590234,-2292601,},
+     {9297824,-12572169,22728938,-520040,22976450,
+      -5511506,-1167775,9445339,6011801,-2299393,},},
+    {{30011619,3757695,-764830,725801,-14839862,
+      -839193,24199845,-14573789,-14759163,-2135452,},
+     {-27896787,-2200753,-24183257,12117093,-31905705,
+      15003075,3533183,937370,-26853761,4944771,},
+     {-21485466,14440243,14541600,-2825636,-15939626,
+      -3082415,8759191,-6183042,-20048076,-146103,},},
+    {{-32113651,-4913912,22700905,-5686594,9430213,
+      -2276913,13723705,-3757565,24912600,16267546,},
+     {-13853817,-16224606,-9856962,5425204,482781,
+      -2559909,26198198,-15289030,-23379326,3439707,},
+     {-16324697,-679868,23597367,5022197,10119648,
+      2677914,-16490842,4906855,-19323474,-5104220,},},
+    {{-6457827,8307020,2457295,13267688,14483574,
+      11839748,23129640,11321451,4227751,-2413500,},
+     {11294943,-5524082,16508193,5261190,7531761,
+      -15864482,-26225595,-16647303,27510239,7510607,},
+     {3537410,4839223,21673705,5249079,-13657654,
+      454118,-6597593,-7085610,3493881,3311229,},},
+    {{17704578,-13034068,32300599,-10883445,-23142237,
+      -4397680,26704037,9919013,27339228,2618517,},
+     {6867938,16331063,-7860480,-12786760,-23180745,
+      5200704,-2905320,3088236,15774563,9949705,},
+     {-7316929,-4323421,12302206,8004476,-19827487,
+      13156902,2284968,-4704851,-1823334,-1173740,},},
+    {{-5943609,-12254190,-2593811,-9627998,-10326242,
+      -15637794,-13336298,-15918071,1344900,-5091195,},
+     {32971366,3313882,8523995,13027643,-7020986,
+      -9373210,-31179648,6056347,26031124,-16233682,},
+     {-27830326,-6402725,-24609708,-7168187,-40400,
+      3032078,7190428,8373063,-19668456,-5780024,},},
+    {{-962186,6338549,15527067,-9358199,3898494,
+      11053349,-13849215,-4726350,20581648,4156500,},
+     {-24213952,-14806437,11250759,3997663,-18260389,
+      13983390,27011357,-7434764,634189,-15273492,},
+     {-22256455,-10650034,7201373,-10728555,26165126,
+      -10718615,22913121,16077360,-32377512,7264902,},},
+    {{-8715362,9389606,1468117,11397447,27035557,
+      2060765,-33295276,2956273,9554649,8536706,},
+     {-7824528,-1808029,17735163,9105262,32933479,
+      16243521,10296282,8578501,25916986,14440579,},
+     {21551345,-4248718,25229845,-3477499,-27622215,
+      -5026184,-20898972,-6877051,-31853523,12499523,},},
+    {{-28149838,15359658,3468671,-5016345,3672873,
+      10581694,-6366379,-1497825,10188891,14633320,},
+     {-23697663,-3365613,-14151678,13811551,7748355,
+      -11616338,8287986,-15518459,-3196620,-12260731,},
+     {31076686,13717250,-20355105,2415511,-26857386,
+      -9039613,30873833,1508875,-9493537,7416300,},},
+    {{-32501205,-13027826,13252148,10878150,-6507606,
+      4600307,-24708699,-9940196,16911305,7426730,},
+     {-5381166,10799828,2173439,14907849,3062469,
+      2921528,31338779,8400021,-4781196,-4178009,},
+     {-31781798,12591148,-23093549,5934151,24950403,
+      -6853386,26067500,-14899046,-16778781,-5366087,},},
+    {{-3910054,13602583,-12078820,268082,31994330,
+      7357280,-21810823,11253932,-30427087,-9023327,},
+     {16463369,-3000054,-28781322,-8169117,16777900,
+      6440315,16256916,-2560858,-17415009,15269464,},
+     {-32187119,-3841893,-5812210,-952005,20865211,
+      -16402427,-30369311,13510828,21393142,-5948621,},},
+    {{-8734319,396175,-12879738,15836254,5206224,
+      -15716106,-17921655,-5173431,-18315568,-1752415,},
+     {30736242,9164500,-9339994,-16154632,6611293,
+      16564611,22452709,-1292148,9743480,15281911,},
+     {-14957378,5729060,15200682,13573543,26561682,
+      7525538,25692231,-511875,23673642,-6616295,},},
+    {{-3511270,6710096,16192726,-15382889,19143867,
+      2297471,26531965,-16709504,26071533,-13014645,},
+     {-29332019,-14122626,-10463662,8191720,-4978857,
+      16338658,-9642957,-1009896,20553297,-4625345,},
+     {-16168625,16099140,21671277,11481920,-6141230,
+      9316268,29754308,-3161202,-4482152,15020956,},},
+    {{-30009955,13861726,-23983658,11578367,9309912,
+      7703052,11868007,-1907863,10333386,15931951,},
+     {22921705,-6123105,-21279616,-13697594,24141318,
+      -10314163,-4060037,-563553,20193791,-7709583,},
+     {-25439061,-7163232,13914817,10643018,12294260,
+      -12505346,-30964534,-1991706,-20061516,-12372014,},},
+  },
+  {
+    {{-27743468,-632109,-22589232,-33282,29599006,
+      13436512,-29700827,-4153719,-23272243,-741767,},
+     {-21793728,6048576,31631996,11162182,6102484,
+      8512836,17443890,16368918,-25901791,-13587136,},
+     {14265427,-10506289,-154669,-12821372,29943994,
+      5231000,23105730,2049453,22743277,-15977500,},},
+    {{13691193,-16774724,-3967634,-12670663,-6237911,
+      -13675495,-32712381,5136903,-30514321,-4460340,},
+     {10964901,-8933771,-10069638,9479422,17030860,
+      4310248,9635821,9078273,22879415,3434935,},
+     {-12765351,-4972633,-24571098,-4034257,-4067390,
+      -15938173,-19485277,-1477429,-8058225,-10957552,},},
+    {{23093012,7742194,-12967468,1737719,-31315483,
+      -14393912,6249915,-4836773,25120153,11778383,},
+     {-19182779,-650937,-2634241,16355388,-11385604,
+      8698115,-20013180,-16409250,28622734,-11409225,},
+     {28803358,-469520,14853652,-1474237,-13973850,
+      14878230,1523364,-8234162,11398405,11733084,},},
+    {{-1079114,-9420477,31019245,-8099601,-15100996,
+      10389776,30971395,10440128,-7525955,2576883,},
+     {10084476,2180421,7104785,-5062945,20775388,
+      -1882471,30473777,-12372852,29759386,10952075,},
+     {-13929295,-6121856,29874791,3803552,-10265176,
+      6771852,6770220,12234020,4758209,5079105,},},
+    {{12696329,-12071128,-6804023,-8385083,18042514,
+      -4482019,3455611,-5525445,-14538132,-1549592,},
+     {-13560829,14294376,-8857902,-10913923,-3879979,
+      10731206,140052,-3728771,-18382380,-15575768,},
+     {-10001263,2371672,-10189053,-3499421,32235974,
+      -497562,-16950960,3102036,17782859,-1576503,},},
+    {{-964408,-539566,-19618140,-7013733,-18667846,
+      -2330841,19010566,-10138094,-2138437,-3173965,},
+     {33347554,-12081059,6544885,-1301708,-29828548,
+      -9074015,-16437268,-13375608,-10482733,12550530,},
+     {-19517171,8141097,-6121265,3894612,176605,
+      1497639,19262698,12693900,-20928362,-4415524,},},
+    {{24056338,8270593,-33401100,-6090736,-5424045,
+      -2154597,26889830,-10110113,-22034716,1393958,},
+     {-29036038,3727318,26849708,1874207,16843947,
+      3976401,3264951,-12878887,22989601,5054370,},
+     {-19615078,7869674,11947961,943780,-12721325,
+      15748082,16758727,14751327,-5904346,-14576437,},},
+    {{-6809446,14029546,28084942,-6317995,20099052,
+      12388719,-5455609,-1023152,-4634686,621893,},
+     {-1421538,10866995,31817333,-1252526,17934868,
+      -11150228,18184385,-5424197,16499404,-6922828,},
+     {-12273860,3049945,6990463,-7911031,32714038,
+      -441039,-10634550,10038227,17714541,-2265413,},},
+    {{-6050114,1900448,-2011679,7874503,-16825934,
+      3510157,-24217445,-8440793,5527375,4431352,},
+     {14608280,16389,23458562,-1452295,10540977,
+      12155141,-11452440,-1293976,-19348101,5189223,},
+     {7229112,16715002,-2354686,15817526,2201137,
+      9527136,7336347,5120979,16365620,-13093892,},},
+    {{-7030694,15475749,20072283,12697688,20169115,
+      -787517,-19664577,-16087037,33226820,3589774,},
+     {-22101110,3106685,5830037,6553149,13140267,
+      13201973,29183204,-10712751,-13214088,6999179,},
+     {-13294591,16379726,8996378,7201065,5102559,
+      12318931,28330328,-6310218,-9167487,-12873183,},},
+    {{30456526,10752769,-25200100,-4380694,18935591,
+      -10301292,-19483538,-15357368,17104668,4091208,},
+     {-16888840,5935181,-18374612,-8313272,8400952,
+      16141485,-1770782,-3543708,-13471992,-11318082,},
+     {-2051981,5328348,-23579427,-2733848,195258,
+      -133260,23923494,-5663517,20591729,-15513538,},},
+    {{-3442508,5763198,28230708,5334493,21938616,
+      -13369853,-4520534,-13916223,33114479,4904580,},
+     {-29054898,11373653,22698798,6961429,-6335846,
+      11247132,-3183994,-10288070,-11046738,-975911,},
+     {-2192232,-1553568,32547590,-5049354,29538187,
+      -10787238,-18531451,-5590628,-126722,-11208338,},},
+    {{32999749,5782110,-7053297,-1072070,-4638535,
+      -8359305,-23627766,5133963,3391844,5904952,},
+     {103870,-135075,-19657278,6797166,5185896,
+      -9501487,4823693,1014700,-20618926,-12749180,},
+     {-21342619,12270040,-12185778,-7086460,-16836419,
+      -2732841,-22688812,5201964,-169956,-12867976,},},
+    {{10137703,1662036,-65720,15227963,19811644,
+      -12198429,-12358878,1065048,9265763,-9477836,},
+     {15038575,-9462177,-15048932,-2588894,-13417229,
+      -15271632,-16848970,-2439679,15684935,7839841,},
+     {-30542216,14587137,10732268,-4222219,2889772,
+      13176346,-19689623,-2870373,-29788595,14701972,},},
+    {{-5365177,-16033974,16057432,-6174965,26968532,
+      2758010,650058,-5988991,19362145,4365512,},
+     {31907071,11442095,22649942,-15758844,-4286966,
+      -6979734,-33230066,-1313925,7260698,-14068051,},
+     {4485309,-11647992,31744388,-6864782,-28217022,
+      -3468073,12063316,11466606,18603334,1219560,},},
+    {{14441819,-9604386,31547176,5080335,14969750,
+      8260383,29427501,-2658716,-24757485,-7683550,},
+     {-829217,-12717497,9303396,14106556,11976612,
+      -8690022,-11002657,16536404,-26224225,16483270,},
+     {-11517737,16632697,7042659,-11653157,-3652457,
+      13438516,717157,309961,15058205,-4843248,},},
+  },
+};
+#elif MONOCYPHER_COMB_TABLES == 17
+static const ge_precomp b_comb[17][16] = {
+  {
+    {{-29967551,-4339222,-12123472,3202764,-13629771,
+      12969268,-10528799,-9347834,-29621716,-545773,},
+     {-887574,-7066896,-14843888,14861103,27987164,
+      -8883315,28797607,-16721587,30728226,-8537558,},
+     {25002884,6854558,-28320338,813090,766039,
+      -9841964,20031627,6359691,18049507,5235366,},},
+    {{15946928,-8466037,-18281151,1070184,27169354,
+      6785317,-21938834,2020827,27034035,-10340666,},
+     {-25837897,15100061,25200467,-10087890,28172475,
+      -5747872,8351927,-4351256,-7941036,-12223907,},
+     {23855174,-16256356,-10981661,-12411124,24260221,
+      5268741,16998753,-15115203,17841773,-11246954,},},
+    {{-3538553,-3641068,3666582,4103032,-30610997,
+      12416873,-1943241,8119887,17817060,-8635925,},
+     {-19635990,14935273,14042988,6486711,-15241165,
+      -11517865,33498626,-10664397,1813708,-15247572,},
+     {14257160,-4416681,6760833,8697280,-19915909,
+      -4297650,16366037,1699915,10223595,12038901,},},
+    {{29037463,-16584465,27163188,10146260,-22556470,
+      -7161143,-24013225,14612157,21069619,-11910736,},
+     {-4752266,-8105634,8768517,-8204094,-989254,
+      -11462466,31236391,4256058,-14948256,6000183,},
+     {31608825,-5641787,2560011,-11988956,-13784232,
+      -6369441,11598180,2141345,-12157614,3437036,},},
+    {{-3387754,5959074,-20110624,-389890,-18770217,
+      16752562,28753910,-456913,-30408019,16192258,},
+     {22807261,-13280552,28857584,3032807,24103101,
+      6656141,28937211,5680632,-7042851,-735490,},
+     {9926840,-14375397,-1773092,1008916,32513975,
+      -6775036,14930675,-2194122,-747555,2629137,},},
+    {{19465314,12770403,-27114467,-16029964,22438875,
+      6742667,-15030292,-66984,26545699,4252391,},
+     {-28650243,-8571579,-1681792,-6480783,-9623673,
+      -3048424,-31154705,-3114135,17572247,3355486,},
+     {8261657,-12004953,22182716,3003579,13142453,
+      13006098,-28060956,-1159258,-2566875,6946893,},},
+    {{10521116,7076801,28581195,10455102,-5958533,
+      -14006616,22060096,4694317,-15858747,4131243,},
+     {-13835782,14470229,-15436696,-6897509,22706858,
+      11693519,31048219,-14022488,16936156,-12699118,},
+     {-33359262,16652154,13076860,-6321058,-12863225,
+      -468101,17953293,4632153,501128,12506091,},},
+    {{-9762051,-5515385,-3016443,11260109,2029551,
+      13179473,-1484836,14673303,-2430023,11885625,},
+     {16603530,-1071275,29421376,-4842535,-18272106,
+      9041961,2598619,13127891,5758722,1373096,},
+     {-14047808,-6789965,1086628,-14600065,31825888,
+      16025867,6793925,13263662,-18696211,15590840,},},
+    {{4348432,-1605796,11457970,6957326,-72894,
+      -1119148,-27841508,6922995,15542383,11054521,},
+     {21346939,3391569,5750545,8173724,4977909,
+      1028848,10825995,-11566532,-23450902,5644826,},
+     {9997383,-7727813,-29447016,-6157743,-11298551,
+      -1625879,-26334529,11664631,-32012790,1861642,},},
+    {{-11986436,-16470790,-26850496,-3644659,23332231,
+      9317192,28557382,-3660794,9449152,-12294513,},
+     {-4534574,-14593594,-8360397,-15081005,-8755201,
+      -13676904,-15303435,-14763817,-7524744,5617091,},
+     {6189711,-2922659,20376362,8988326,25178759,
+      -16252462,-7849190,14573532,-8923627,-12506670,},},
+    {{23327284,8698021,-5566749,-14342184,-10459519,
+      1672763,14653886,1061422,-5762674,-3064292,},
+     {3991717,-1277313,-25220974,5747322,-28342084,
+      -600651,-18438830,16586700,15569944,-6609906,},
+     {13607409,13671491,32875611,14997581,-1548355,
+      13609973,21242750,-15057844,367019,-13083315,},},
+    {{-13126889,16024309,1167292,-8079166,4291551,
+      1952785,-10065105,-452173,-3582528,16718706,},
+     {23850797,-6621272,-27959721,2610089,-22335325,
+      -15583616,27677302,11320014,15236900,12092706,},
+     {23032359,-14535644,-16173321,-4643676,-6745650,
+      10467626,8140077,-408918,4223938,7832514,},},
+    {{29638780,-13328024,28373936,15385889,9028505,
+      16382147,17347906,-8518445,-7320137,5173304,},
+     {-22886532,3085724,18803811,-9515786,7263443,
+      -11534309,10275631,-14962812,-24679962,-1402728,},
+     {12693757,-8342771,737776,15922524,2976658,
+      7002413,-7845503,4622585,-32247063,13522369,},},
+    {{-16820754,-15595336,19114975,5819783,-2753908,
+      -10728410,19304309,9468787,5203632,10588373,},
+     {28887328,-3923934,30365878,-4843728,-20664666,
+      2338775,21645324,1465455,13902683,13222593,},
+     {-19929553,9500433,23741806,14075650,-25476852,
+      758083,-20695422,14597190,-12397306,15795011,},},
+    {{-2105599,-4449008,2293747,-10996420,-4817311,
+      -14932242,31254474,-13350601,-9744884,14418037,},
+     {-18702087,713704,4128857,-9474225,31486861,
+      -3118337,29211111,2159443,-15748056,12184158,},
+     {20604083,-3675329,13522003,-10309422,-19315794,
+      -16091916,9584045,5490340,19861563,4659903,},},
+    {{25174277,16533181,-23783360,6398455,-10701218,
+      -12215121,-25706103,-3013531,-16007675,2162906,},
+     {-30843141,-2590682,-5469959,13837213,22864634,
+      -6909093,2219538,-15049944,4729109,-12196545,},
+     {-24118636,12785330,9901930,-12284694,32638308,
+      -3096391,-22691127,9894774,865940,-3673484,},},
+  },
+  {
+    {{-29438816,8145780,2376117,-15661973,26333302,
+      9684011,-18478532,9389136,10842534,15474130,},
+     {1489806,15919132,25139959,-14225393,16511361,
+      6696657,-27487291,-8245580,19268645,-8243847,},
+     {-29792493,11892205,29716617,-6106665,-28461962,
+      -2364930,-9582959,2354328,19120551,6963212,},},
+    {{-17183693,13655298,-20560603,-14172208,9311983,
+      9438712,986783,5506068,30160171,12706068,},
+     {-29439309,-15151590,310644,7077238,-5440362,
+      -2796650,-13025552,2550364,-26660320,-10227973,},
+     {21057430,-3709359,32306625,16481493,-18967228,
+      -8374974,-33039681,-6455949,27595860,-11788344,},},
+    {{17954141,-2260052,24306334,15694335,28006658,
+      1219558,-32463861,4875261,-17706591,7981076,},
+     {-5530294,14900353,-22822917,7740614,-31360388,
+      6685656,5040270,5604930,-17585200,10421168,},
+     {30929266,-15084810,-5681322,-5102833,13433136,
+      4410266,-25607346,-16252371,18831343,-9428955,},},
+    {{20811275,-106156,33370607,13216050,-31641018,
+      -15603280,-5754012,-15203222,14874021,1989778,},
+     {21757778,10912462,8192197,-7918037,6438221,
+      -7405331,16542358,-14969759,21214369,2064944,},
+     {-2211074,2393577,16295540,-10861049,-20232438,
+      5670408,-1759765,-14114667,-12391792,-7622334,},},
+    {{-28654509,-11275041,-3538008,-1709091,2135528,
+      -6236284,23264560,-4583711,18501784,-8723935,},
+     {-10981320,-15818198,23788955,-14893066,-2159797,
+      -13315003,-23345726,31258,22843627,4168360,},
+     {10262437,-14967918,5069589,10923648,-11498692,
+      5999461,1921549,-11559340,-14585269,13836590,},},
+    {{18311468,11893476,24660324,-11847559,-32320071,
+      -1052887,-3246031,4036920,2911969,2235505,},
+     {-12765819,-15985554,-16448789,-5785618,-19286379,
+      11897125,-26891131,-16019466,32424829,-3570612,},
+     {2969358,9746051,16096004,-16636308,-22781629,
+      -9584907,-232537,-8873154,29964486,-15156858,},},
+    {{-21378716,8924107,23779666,-16219248,-28778501,
+      -5299148,12787347,15747537,31855287,-12164517,},
+     {26972815,-644138,11702097,-10036501,16336058,
+      1855486,-32634162,-10776107,33051752,-2297860,},
+     {30658260,10930297,5840136,701135,26131511,
+      -16702591,24903832,-4558727,-11246376,-10571191,},},
+    {{-4419046,13152355,557347,-9484888,32894791,
+      11872455,-17156118,-5265277,-13553338,8140902,},
+     {-7100489,12383587,-7283393,-6758310,-570618,
+      -10638064,-33281650,16219217,14715130,13605262,},
+     {-971321,12375243,-4415094,7867384,-22235505,
+      1909698,-3720118,4136316,-14499172,9214750,},},
+    {{-24277289,-10655564,-3956940,-10860578,-7016601,
+      14938520,-9302976,11087650,32950255,-12991452,},
+     {18216537,-10049074,-7191651,12881976,-12753866,
+      6653902,13740447,9713638,2584054,14659691,},
+     {-7604864,1165041,-28441068,11025276,-19767433,
+      -1186757,-16432840,-9524595,-3060271,-9882305,},},
+    {{23579355,13115792,29370718,-9941329,15819178,
+      -7610179,-20866532,16207377,-29925672,2442785,},
+     {22156906,-7766980,-19176578,-7810451,20649708,
+      -14983077,7060674,-16450996,27349564,-12839563,},
+     {-27050177,11311322,10986971,9724503,24047473,
+      11129948,22801999,-12327822,-31763780,4398053,},},
+    {{-7330049,-4294964,-23630318,3744044,10880432,
+      10927468,-24164696,5382511,-8206847,-9584880,},
+     {-1260386,13761067,-5860957,14025985,-1896339,
+      -8784618,-7173365,4921551,-28100477,-289203,},
+     {19412915,7570846,28811777,3159015,5416013,
+      6828358,16649472,6871041,-15159873,-3298107,},},
+    {{-29283313,5491170,-29911820,1030693,-3190800,
+      -9648572,728668,16725066,6532812,3875375,},
+     {-1383620,12818286,-20554167,-15083785,13480368,
+      12884726,19640944,-14596617,5928085,8455150,},
+     {-19016348,-12701410,-2691196,-7277995,5609451,
+      1324764,-13540795,-7402560,-26259371,369130,},},
+    {{2391338,927542,26090305,-4157758,19733576,
+      -496873,25043582,11079177,2031579,-7606957,},
+     {-26304696,9138269,18231872,720554,19458714,
+      13097439,-37249,-11076834,14678185,8715073,},
+     {18959009,-13953426,14494547,8159690,4119341,
+      -5873356,16108909,3387493,-14638848,956700,},},
+    {{-4892742,-2112600,-25572085,10175433,33450573,
+      -14313198,28695505,-15730042,19013379,4105608,},
+     {23709431,6443600,10486732,-11721869,-29766369,
+      1439615,5818358,-6061981,30930798,12472413,},
+     {-10094981,10824888,7377170,14331931,-20706998,
+      5807657,-1073641,-9501585,-14269560,-14944265,},},
+    {{17854333,-11392293,-935182,13423190,8861438,
+      5932693,2698461,13687922,2176056,16175577,},
+     {22993385,12577079,-12938776,-12447312,14929887,
+      2893388,9004359,-15754387,26802910,907003,},
+     {-8388292,-7831208,-29538464,3335795,-7701654,
+      14142684,-27535161,8860228,2509550,-6484607,},},
+    {{28536703,15400367,-29704004,-15966509,-31630445,
+      9726004,33181908,-7531214,-13688408,-10784634,},
+     {-19717235,-5572897,14682681,-14134284,-19465336,
+      -8278018,-4986895,-9893008,22607829,6470948,},
+     {-19878127,5549750,22030039,8891830,9597515,
+      -6137853,-10066590,-4919415,6663601,3018410,},},
+  },
+  {
+    {{-25421138,1626149,-4068428,11883848,-6420824,
+      2679146,11502523,15425417,9037020,-2765801,},
+     {-15900387,380288,9841450,-16463705,14474307,
+      -8026985,-14374186,-14254470,-10568041,-11289543,},
+     {7235603,13531834,-7307668,12022634,-30633682,
+      3731418,18148521,6104039,11629616,-11204610,},},
+    {{22244365,-1515828,27233377,1219522,-17510188,
+      1320271,-26342806,-3510231,8105163,6403650,},
+     {28755646,3580639,26712471,-13221295,30999139,
+      -7695191,13249419,-15187396,22808325,1202098,},
+     {-13806902,-6319788,28496733,-14329832,30713037,
+      -15472992,9370768,7998551,-13168240,-10228843,},},
+    {{1318708,3286691,18821246,-3851632,-31285875,
+      4054913,-9373361,-12511625,16053502,5391351,},
+     {-9976153,-10730584,-11956642,-769985,-12129651,
+      -7129687,15939255,-10076970,-12183637,-1254273,},
+     {-29049432,9916871,15222389,16434212,32393386,
+      -3606537,-26737652,8627302,-883205,16561619,},},
+    {{32503912,-7426987,-33088753,-5505336,22157750,
+      -1264587,5292012,-9174652,-13253203,5127214,},
+     {-2414448,8863276,22344039,-16210161,-1180271,
+      9161974,-21171773,-14166701,5369847,16569941,},
+     {11007549,12727064,13313344,11590929,-29279025,
+      6846542,13115782,9690581,33427863,-5095481,},},
+    {{23820359,-597207,-10405149,-13326029,29716221,
+      -16293036,6225248,-13282449,28036900,15344388,},
+     {31705578,-8958580,-11390314,10858288,-31496697,
+      -6618639,-11570452,2551257,-7623473,13034900,},
+     {-4895457,12007729,-14708504,12547665,-15691954,
+      5853752,2302087,536405,7741742,7805601,},},
+    {{-6147743,9255206,1035263,-11356228,-31246138,
+      16693534,18081751,-3276345,18178337,-7627011,},
+     {-25531773,5028294,-16832835,-2732418,-26201749,
+      -11822021,112511,-16638008,30992883,-1804684,},
+     {19369710,-526022,-21347704,9021019,28425052,
+      -6283689,-6933706,-15755649,-2649412,-9473355,},},
+    {{-12262637,-9281277,9452261,-8565057,-24906594,
+      -7970,20452399,10047395,-31535545,-575711,},
+     {-3086829,-12391688,-8714661,-6654004,-19899,
+      4342711,-31967480,-1378055,23245594,-14522094,},
+     {6241563,8153994,12920593,4007264,9469728,
+      4176083,-27071148,-13679648,12021227,12587468,},},
+    {{-11746718,-3767852,8573509,7669856,-14812578,
+      -15275786,-8633856,12617072,605517,16357701,},
+     {32975841,13929267,15437336,10367769,-30273157,
+      13407166,-22036058,-9589031,-25821132,-15408872,},
+     {-23572654,7364821,-18041193,13208282,-779046,
+      -10538108,-11048737,8521237,-7804863,-3108879,},},
+    {{10552068,-15754616,-18402292,2658820,-21768919,
+      5902684,27579568,-10840794,25171661,-16302332,},
+     {4937965,6394320,-4041819,-8869758,11773925,
+      -15667597,32413983,1571559,-18682802,-13452267,},
+     {-22073472,-15953287,7945715,-3162743,-1248901,
+      3413998,29765266,791812,24205769,-3154072,},},
+    {{10542072,-1190509,12066146,-3905403,17428716,
+      16652202,32708485,13305948,19339452,7915920,},
+     {-3166524,-5891333,28050582,-10360466,-11245725,
+      15944520,3775470,-1363886,-9674931,8414167,},
+     {-24674089,9213136,25670761,9011396,-17459016,
+      -3551257,-8108015,-6362340,-29684096,-13212544,},},
+    {{27871215,13030480,-4676317,4826230,-13181746,
+      -4855140,9861418,-11050133,-3822118,-11602969,},
+     {23085884,-15948731,-25584262,9214823,-13274143,
+      7550017,15676713,1229114,27838707,1170541,},
+     {11371365,11695087,21963155,-6506472,25153231,
+      -14244672,-11866030,-16308628,918038,2694169,},},
+    {{-1892150,-6910637,9558512,13101053,-31382698,
+      3569965,2994990,-12009874,11404696,-8421138,},
+     {18631091,6348185,16396810,3848316,-3817596,
+      -13185226,-26560804,9223786,-20375629,13857896,},
+     {-20218350,-5816305,-30742116,1071855,14376158,
+      12109651,-14103721,-16354992,-5566869,-10625660,},},
+    {{-25911123,9275111,3993118,1180260,29443420,
+      1752887,28659614,-8623393,-7897458,1256584,},
+     {24410519,-2105020,-30724139,-6967432,-14300103,
+      -10166003,-15169663,-2246016,-7291737,-7110611,},
+     {-2141810,-7244547,22954377,3282127,31971450,
+      4077202,7659657,9343529,-7374928,-4722801,},},
+    {{-16994843,15884430,-25274384,-14224897,-13572316,
+      -10694371,-6880393,-9994089,12961924,5800050,},
+     {26677693,2467022,-18550163,-8320332,14754656,
+      -9669788,-33281613,3486027,32687326,4349828,},
+     {32969057,-12711535,26358780,12676251,12684003,
+      -14983119,-11017830,9438460,-10182939,-14629856,},},
+    {{-24402506,14048852,19062532,-1998585,11386129,
+      11088465,26249806,-9002091,22730432,-10913586,},
+     {-19306805,4516381,-30884514,-6970963,17924394,
+      5605137,-16943891,-1858490,22900434,-16096065,},
+     {30892087,14635370,-32889977,-9259161,10392721,
+      -825912,25426132,-9112079,-19742821,10494127,},},
+    {{-33503111,8173989,-4221086,-11406292,-19171472,
+      -1481652,-5755168,-7749422,-24653984,-7386626,},
+     {-6494147,-11340747,-27635358,-15258177,10476713,
+      12831016,1866696,-11295195,18595874,7808989,},
+     {-28739975,15720844,-19855410,10807231,-24141437,
+      -10422443,27045273,6616428,-23578497,11916991,},},
+  },
+  {
+    {{21717310,-15073504,4968785,-5613029,31984171,
+      4832288,31118609,11613384,-5906166,-16552502,},
+     {-31582222,10412093,-29246330,688486,-20525781,
+      14486484,25985778,-15798702,11981732,-6938379,},
+     {-16727722,-9531705,22900762,-4925134,-11859197,
+      1387841,-6684379,-7030335,26867226,14007470,},},
+    {{28855156,5637164,31077792,4870854,-25249645,
+      2320851,14865553,-9958586,-11243880,-11904989,},
+     {19896079,-2921614,21543642,7980010,30060648,
+      955168,-677365,5379293,-29714518,-4933560,},
+     {-19512883,4829581,-3231315,-12501570,4379952,
+      5253856,17691770,2081615,14543316,15568359,},},
+    {{-5665232,5772394,-5851811,-5736609,-8107389,
+      2323475,-4474444,14087270,-4121315,-14135711,},
+     {14607136,10462900,7843709,-16258598,-9533507,
+      -4882944,-17902846,-9297724,-18233161,-12027762,},
+     {14500297,-15185643,-15828063,569711,19674055,
+      -10150703,-31662338,-9008325,21549091,13212492,},},
+    {{21420597,2135298,18287760,12773278,-8205273,
+      -12237055,1026160,-4360198,-31861836,-14239193,},
+     {-4183442,6149513,27410472,-277461,-30105120,
+      16699402,26225312,2530911,-15486514,-1935000,},
+     {10297189,-3920834,6243990,6531550,4877267,
+      547629,2963870,-3577622,-13026879,7481267,},},
+    {{328792,1569527,8120754,16584640,26966509,
+      -5597206,-12963452,16724394,23584004,1174699,},
+     {19149054,11446333,-9806517,-9614935,-26262739,
+      -1799763,-29512555,774323,-10003855,-6175990,},
+     {-30585234,-5269881,-12776448,-3679920,-24012825,
+      14067247,9297310,-7570571,-6971016,9620376,},},
+    {{19232412,-16353388,-1080662,7009283,-23153440,
+      -7694282,-32804385,-16659814,3414172,4212425,},
+     {-10079921,-8856433,5489175,-14016041,21096971,
+      -931853,-18296186,13590301,-14517762,-15308052,},
+     {-18467536,11466858,32615126,6446713,20030166,
+      16167133,645799,745844,31237020,14783940,},},
+    {{-19732996,-16403571,-30418806,8254164,-19809333,
+      -5582828,-32721005,12598755,-21770328,-5396731,},
+     {-32742408,14697299,28696519,16387823,27612962,
+      -11711088,-3803313,6079570,1327193,1601166,},
+     {-23341547,-8978887,-29628499,-11697363,22621196,
+      -10368119,8541623,7994592,-9383736,-3739253,},},
+    {{-24970630,-9505865,-25917627,-10083666,27845079,
+      -14546105,32577076,11074262,-30540164,15968633,},
+     {6650735,14009667,-33105143,-10599359,-17409852,
+      7207677,-5016566,-76522,-11666514,10200715,},
+     {19510599,-12849479,-11461714,9660712,23951021,
+      1497623,-26399378,13027065,11600874,-10572908,},},
+    {{29853858,-14288872,-4960080,15004527,-22839756,
+      -13474836,-15429816,-13534237,17831372,-5730918,},
+     {-7311725,-8533026,-18554757,-6347749,-25339345,
+      10728698,2386148,-12727860,32614573,219231,},
+     {26308545,-12470258,16095059,6517702,22076719,
+      -11320038,-20180385,-7273907,-17625214,7890906,},},
+    {{-5402725,10809562,11049159,5531805,-28995341,
+      -944541,-20493142,-12562553,1230855,-7549132,},
+     {267931,5133192,-21453379,-16232805,-9128431,
+      -2209344,2780021,-4029712,-23948334,14972422,},
+     {6614978,16525235,-15665858,8087513,-2186086,
+      -14461808,-17453852,-2596706,-22616152,-11802499,},},
+    {{-14294010,-3879495,-30107200,15402105,6959772,
+      8266533,-30034385,-11400613,-613839,11071933,},
+     {12597369,-9415318,-5328951,9261258,-8282318,
+      14770160,17910135,2847376,-21337269,14759302,},
+     {21182041,-6158307,-6276729,-1040770,30546163,
+      9011770,-3427599,7820583,-17520779,2598607,},},
+    {{20643632,14191173,2938165,-11991497,15758675,
+      5612601,-17449885,4887642,-28548094,-8838505,},
+     {-13762835,-11281463,5276495,-2121253,19102884,
+      8587140,-23687507,-5613840,25010055,14795202,},
+     {-17854638,4429486,-29394536,-15542792,-26815669,
+      -2775538,-14438361,-12530288,-23965928,-13146020,},},
+    {{11410932,13824156,3765222,-10211374,-16135314,
+      -10272643,29173999,-14954208,-30243205,-2857708,},
+     {23602030,-5211282,-25370195,8962611,-3749043,
+      3064516,14411061,-12688524,30361412,13902269,},
+     {-4705495,12812695,-2898156,9760999,8429934,
+      16438023,11297634,-14921445,24609020,-11760989,},},
+    {{2086332,-4512826,22113881,14610436,20248786,
+      14157239,-7707433,-550497,4998630,-8051882,},
+     {16526584,8775295,-24727637,-2043306,-23348165,
+      -6822858,13614641,-14404511,22078797,-2488459,},
+     {-9079613,-14480657,5167198,9829104,-23554487,
+      1843542,23362434,-10272758,13872263,10618008,},},
+    {{-29032494,13555125,-24157244,4624002,966665,
+      15472303,-994472,-1986224,28996706,16562854,},
+     {17148680,-1832574,10810551,56829,19097724,
+      4167600,-18428425,11106079,33549194,10320734,},
+     {27088409,707683,-16503465,14166633,15687971,
+      9409932,-17024730,10880086,-20452408,-11479030,},},
+    {{-13760504,-3817934,14091568,-15495530,-515755,
+      14726831,21795847,7566254,-32980702,-14536992,},
+     {-18492170,4704295,-31416046,-645232,11831018,
+      -14351244,-30507271,-11108754,-6383702,-15365783,},
+     {-32291942,-7699012,1871619,14107032,-4402799,
+      -5412165,-25342491,-4853731,-16543763,13178195,},},
+  },
+  {
+    {{-3239078,12540307,12405593,-1308544,-231868,
+      9928380,7647444,-7963369,-13007670,-12984303,},
+     {-31755533,2245361,11796865,-12501589,20779597,
+      -3730448,32775112,-4824773,16240991,14776182,},
+     {1446045,13908966,4359511,-15793651,24439540,
+      -5553579,22273530,14635030,-4319418,15395875,},},
+    {{30586262,-15628654,-12131985,11213115,-28307891,
+      7474357,-27435953,-10216384,3594462,-7270472,},
+     {-2968996,-4664830,-8638528,3804431,-6851872,
+      -6265543,-8120433,-10737905,13270982,12078409,},
+     {7629103,-581030,26256083,-13811939,-31089977,
+      -5617786,-8502734,-4524127,-15720086,13706611,},},
+    {{-8693316,-6252581,28662271,-10970428,-9796616,
+      -440912,-2117741,-15733254,28808456,11369632,},
+     {17182425,-6608717,-3769954,-8082220,-29611757,
+      1683449,2304261,9041459,30120589,-2780558,},
+     {26005032,-12342021,28683764,-9949887,30923533,
+      -1453472,-25409083,10590148,-31212223,12478388,},},
+    {{-25146057,-10311856,3433355,6690981,24437010,
+      3116602,-15288293,769103,11798305,-5622092,},
+     {18865888,6166734,31616562,-16464893,24237584,
+      -14614522,-16341469,-12836036,-7671736,7305957,},
+     {-23815803,-1546360,20031053,1806624,26580392,
+      8835365,5606842,-10322920,33191417,13113168,},},
+    {{18958640,-1037495,-22194149,12517826,7913204,
+      8306890,-21999472,-15323278,-10512885,7983569,},
+     {-18865917,15863005,-28090709,15327332,27471323,
+      502506,-4010771,-10847011,7767593,-12965527,},
+     {9666029,-5984725,-17610091,-8360079,-13830025,
+      -11447581,4158066,12621978,-2826863,-11877547,},},
+    {{25393141,-4453592,2709930,8841065,-28322580,
+      9625066,-26902260,-560092,32883490,-13064864,},
+     {-28104743,9269006,-1518916,-634669,-10330581,
+      -14474116,6980421,10732448,9680318,4256780,},
+     {-5713823,-7438435,29549486,-5658209,-16803258,
+      9664364,-17631993,9187508,30686192,-10745618,},},
+    {{12172378,15666088,-13523291,-10854444,-17914165,
+      16377719,-5793773,12436189,12287381,-1541906,},
+     {17966994,4569255,-7139571,-7575551,7870572,
+      -13451516,-28879992,-6805737,-9901366,3253817,},
+     {-28068767,3258511,-6043427,4011627,17599542,
+      13257590,18216899,-2851742,-32684422,7493325,},},
+    {{-8550759,-4447558,-11319256,-16268956,13462653,
+      -13666377,-24060244,-15489443,-27297308,-9060708,},
+     {27941446,-12951250,-5602933,-8431362,10938350,
+      16328956,-1368369,1750794,26268604,13192383,},
+     {-17442106,9200830,931091,-1838997,-15984649,
+      15688841,8434807,-12976112,15678408,-5514978,},},
+    {{19203210,8830858,-9756328,-15783710,5266073,
+      10726810,-26605613,3602551,-22726326,-7527839,},
+     {21244913,-8081364,-12112922,6696471,8690845,
+      -12078680,22409805,-8634611,-14835557,5881732,},
+     {32360534,-6507695,20054749,-9660280,-10226533,
+      -4150944,24633488,-8299409,14653423,15480664,},},
+    {{-21058689,-6378520,-15775314,-633212,26969537,
+      -8497747,-11075996,16074249,-11688055,-9633094,},
+     {7111652,4055575,-20041817,12486908,1439461,
+      -15079652,-547658,-5286515,3396596,-12018802,},
+     {-13610912,10627339,29296535,12816970,5694357,
+      -8209006,-9463678,10977622,-4394613,-390704,},},
+    {{-10687491,-6251882,12692108,10218898,-17620211,
+      -3202702,-2235558,-3740561,3169167,-5271323,},
+     {-27323849,10184108,18420333,3305212,20076218,
+      6563136,18046269,-8497371,-27449791,-8392266,},
+     {4955969,-8572788,-5697863,6781187,2175951,
+      16082196,26997733,-14579906,8693638,8478938,},},
+    {{2393944,9893618,5318471,-10249867,-11818158,
+      -15267179,-1506224,15314376,-2824330,-12272952,},
+     {31692545,-696793,10416493,-2833535,10569526,
+      10597284,-6565692,5892351,4223539,13682916,},
+     {-6831481,-3908970,20399475,12878718,-16963149,
+      -513252,9970569,2385764,-11851672,5510159,},},
+    {{-19028586,9198142,-11837854,-9303297,15200219,
+      5085757,27286067,-10432587,18430527,9936605,},
+     {-22279621,8981909,27173729,-15365941,2611230,
+      16075367,-19673911,-9583731,-17806566,15160046,},
+     {-18200017,13084766,17292891,-14277644,-29523827,
+      4905743,-13171587,-11966177,-11299567,-14955226,},},
+    {{5577893,13886974,15766736,14050503,6282016,
+      -1853148,1127349,13681205,22868297,-11643818,},
+     {-16184592,-14839726,-17785951,-10223142,-28031728,
+      10880499,-2280775,-14404460,-18509245,-2380930,},
+     {28424626,-15658880,-10046190,6831456,22656094,
+      -355618,29338454,13158213,20783288,-4612824,},},
+    {{14367056,-10684688,-3282200,2307957,7119291,
+      2392398,19465691,-6082873,2828995,-2047464,},
+     {-16007090,6242143,32987962,8628473,-6748848,
+      -5097052,12800344,-9857590,8907847,14720411,},
+     {-5825227,1290569,7408691,12639623,-21326870,
+      8555331,-2115894,-7239924,313648,-6964555,},},
+    {{19899148,-1436313,-1631153,13899813,31148797,
+      -16348711,17553413,-245416,-31072950,-7919217,},
+     {28260776,-12033979,14909325,-13393960,-27802543,
+      -16195099,-16782978,-10132924,-7703689,8832663,},
+     {-16406488,-14247357,-32980278,14634118,-20443235,
+      284803,-10825927,5691195,-8994221,-6528035,},},
+  },
+  {
+    {{-23984900,16048409,-25380975,-15047372,-28460364,
+      -9918701,-7715111,5269706,22464753,7793769,},
+     {-11427306,14506168,-4344771,10520405,-9497840,
+      10915170,-15234893,-10860827,26504030,1965711,},
+     {-19491252,-9402638,17298164,10376527,-6176507,
+      942822,-26953942,-6778306,13074418,-12252734,},},
+    {{3597755,-1368759,3512929,7146365,-1637442,
+      -1319232,-30507031,-10536935,3889501,-2719123,},
+     {-15397904,4347103,10098260,-5441493,31027362,
+      10769167,-6363673,12977608,32225044,-4819883,},
+     {2362218,5467793,-24482842,-5433097,21961225,
+      7014894,26040836,-15333925,13740039,-16092801,},},
+    {{9910903,-2772022,-8143845,13267372,-11765054,
+      446184,1181116,8383055,-3361094,8403239,},
+     {-24374738,-16535718,-6097954,1848035,32889808,
+      7699889,6638325,-9324303,-29575082,-6647201,},
+     {20680471,-588876,-31892696,-4461799,-16782704,
+      -12572977,-11517333,437557,4943255,3836644,},},
+    {{860151,10210126,20602743,-5214665,20149668,
+      11254055,-18910201,-7902327,-29537379,11819350,},
+     {-24184432,14831143,24022302,298167,32656095,
+      -10754056,171341,-7506413,18879272,-5132866,},
+     {7396787,14908118,13479889,12603541,22692087,
+      -12344612,16220299,-2112902,24743466,9580336,},},
+    {{-2577177,8229473,7734323,-4172038,17686190,
+      5780190,-11342388,5448069,28970865,8007467,},
+     {-3866699,-7151491,21783182,-3099519,9339533,
+      -11513621,-29739405,8049252,13543973,9402806,},
+     {-30898029,9613751,20827939,-10062581,-6042370,
+      -4301198,32312973,2718314,31333668,4400359,},},
+    {{12568089,-2480889,26429516,-8530516,-1796951,
+      -2221274,-7036484,-15701590,10336451,-10080024,},
+     {23946548,-88801,1575222,-1295302,33063658,
+      11799670,-9929509,2424512,17934602,13860145,},
+     {-19513831,-3395357,-14062338,-11417443,21036836,
+      1771354,23595324,-7418091,659190,-3280815,},},
+    {{30239072,12912715,17353627,11162747,293528,
+      10694422,-23607913,-14333327,-22226540,12790333,},
+     {19868060,13445260,20713311,-8856531,-5679480,
+      7281638,-22738198,12950615,8090404,8243220,},
+     {-12329387,5997534,-4609283,11052694,-20601110,
+      -14086585,2326554,-10966818,-3458865,5133633,},},
+    {{-29942932,16204679,-4165103,5063816,-25357186,
+      16068287,18728017,-12487864,-20863472,-10630152,},
+     {-24066815,-10786451,-30644479,-13529088,28251039,
+      16418066,-19880504,4816097,-4074813,8955791,},
+     {32449902,4521379,-24176707,12574240,27712102,
+      -7128547,-28327733,-10587177,1851783,1479426,},},
+    {{10021708,-9398679,-3404801,7434119,-22181775,
+      -989461,9092345,-10578353,-21497012,-4729228,},
+     {-10321492,-3509878,21503724,6419812,29890621,
+      7458722,-2228745,1707643,23822088,-9872371,},
+     {849733,10895001,-26212791,13784167,-8196121,
+      11725188,4720986,7857492,15901648,11185790,},},
+    {{-13575830,11990564,-26177407,7763174,5382648,
+      -4476466,5994886,4561029,27616629,9022742,},
+     {-32504839,1879181,-30737405,1430495,-19989735,
+      -15729436,-24086746,4102678,-32271989,9470272,},
+     {-11331905,-2016,-11615026,14149464,-17437538,
+      1187838,-4496238,-11870100,29854543,10395278,},},
+    {{31826839,2752208,-22837050,524265,15297997,
+      -16436559,-9406090,-9302568,13469899,-5951295,},
+     {29099713,15070274,16700404,-9438262,30897871,
+      10445596,-28803331,-448225,24838249,-1660418,},
+     {-8743245,-3324206,20375191,-6654763,24556338,
+      -8885711,2448792,-5298730,-13869009,-3164383,},},
+    {{-1624701,2202829,-24863824,-11055793,11586416,
+      -9145300,12952030,13970502,6690622,-9685812,},
+     {18467434,641296,-21678791,15345638,13100812,
+      7640683,-4249980,618342,6726151,16447087,},
+     {-25790507,-13444785,20916014,-4021293,8987150,
+      -15454776,2137821,-5602484,-5213526,-2563243,},},
+    {{-25223272,3868888,7572099,-4078016,-9841512,
+      -8151031,-6648136,-4993552,-20537267,8691123,},
+     {-33077266,15355130,-9189296,-10921106,-7274123,
+      -13749272,31492974,11421267,-8164043,533700,},
+     {-8335102,12284874,-16065444,-4496236,-5998925,
+      10186958,18311256,2934860,32929341,-7426434,},},
+    {{6412376,8353798,6784418,13563206,5409357,
+      -4876574,7407942,-4342563,-33206562,-3411057,},
+     {29722925,-13558707,-6194566,-2386825,-11864557,
+      -3231998,9642533,-11825332,-8704327,-2374107,},
+     {11302321,-10099391,18818745,5112478,-27398344,
+      8335587,-21753754,10285393,-26197603,6273768,},},
+    {{31364719,1950175,-13305748,8576563,13441,
+      -3368057,22581505,-15428400,-9323490,-2245359,},
+     {-4472758,-10581487,17388246,15006821,16187615,
+      -5412739,-31564293,9341675,29030851,7212904,},
+     {-9211358,4479273,3100877,7730913,-19851690,
+      3888571,-14276201,-13090135,26737277,-11115582,},},
+    {{-18057081,-10504221,-32342318,13816471,9556940,
+      -4886876,29958291,12703653,-10570949,13279188,},
+     {-29200485,-14364038,30205456,10716759,25171954,
+      8905562,-24537904,-6432391,6252421,-6437439,},
+     {-23884668,12126262,17818511,-1987449,-14928303,
+      9092374,31212794,-7551372,12540266,3865690,},},
+  },
+  {
+    {{-16941800,-14078152,-23704257,1726326,4589899,
+      -6400016,-3397914,14697682,-19206405,-6870473,},
+     {28283652,-10527829,-19459407,-8168926,-4778432,
+      -16106070,-3670918,7705007,-26316818,-10929173,},
+     {871015,-975632,-27124714,-8572114,-4768044,
+      -11216895,22035179,1891017,14817218,1908435,},},
+    {{24075059,9475774,-18476485,10181879,-31945944,
+      12356426,12061007,-4035774,12151292,-5108105,},
+     {-19987503,-9547786,23976434,-11617903,-30027581,
+      671235,-4490837,5536278,13680869,-4153219,},
+     {-13398171,9253810,22343555,-2513245,-1378735,
+      -501929,32459707,-11402840,-6091345,15442342,},},
+    {{15452705,-3581718,2383046,-4339529,31550266,
+      -7086890,-10780042,2486100,9093315,-2391774,},
+     {27729817,8543849,23759138,-3598212,19294903,
+      4024587,8922326,6549416,-8556092,-10264813,},
+     {33184488,-12194376,14134652,10720306,-17570771,
+      1883571,-1325422,-14151329,11534988,14403334,},},
+    {{-9934842,-12413475,-10734081,-1571502,-30700372,
+      -9720830,4350897,16361178,27076636,15147667,},
+     {-20315969,15791525,11912542,-186919,-10244582,
+      13821755,22000224,-15241983,21144720,611000,},
+     {4669482,932443,-15794500,-3194877,-32850098,
+      -14190093,4218431,5453468,-5540759,4170363,},},
+    {{-13544189,16392257,-15303475,2724571,23555587,
+      11077131,-5234565,928894,6474709,11091155,},
+     {5638838,-2739478,23314260,6759595,-13412092,
+      -13617029,-29058353,16323836,-21167565,6321914,},
+     {2437443,1945870,31274453,4291766,-7793462,
+      11266183,-13759404,12314559,33189377,-14791883,},},
+    {{-1549766,-4442898,-25996554,-296040,6769752,
+      -3777801,-26710542,14437214,-15740749,-4031398,},
+     {-4673346,3057909,23662355,-11775503,2221780,
+      -8419728,-19009310,-13099623,16357016,9072513,},
+     {10741411,8885244,-30004813,10384789,-11456735,
+      7645841,-2076346,-3767176,-16646018,-10442046,},},
+    {{-12825959,5282051,33545975,-13175976,-23116882,
+      -5354679,3805676,-10667361,32895987,10679491,},
+     {18044169,-4483041,-2659365,-2204625,-10495145,
+      -4043584,-6602460,8809865,-171970,-8829423,},
+     {-18667454,-5011837,14125177,-15291113,3528798,
+      15601106,1867832,15388902,1230190,13854866,},},
+    {{15998190,-15525683,861432,15868595,32461878,
+      -14378090,-10953957,-7538970,-23482937,15253878,},
+     {-27309549,-5854165,-13643941,-2047373,8097720,
+      -12183832,29888250,-3240349,31700751,1419611,},
+     {33352922,3091703,-663782,-2366073,-5875142,
+      3519075,5182807,15129402,-20395567,-11545626,},},
+    {{-16319095,13948639,12192073,-11425888,10074774,
+      -5153214,5165847,8332544,7189372,16191664,},
+     {-11121932,6559411,10528187,-3587301,-32875702,
+      -7225133,8375824,2058626,-369580,-3514442,},
+     {28023080,-10567318,-14440896,1989320,-28986919,
+      997250,-28149064,-11273316,16455789,-2385444,},},
+    {{-12398445,-16095867,20770489,-15704347,26193215,
+      5531710,32039405,-155140,-10838154,-5084878,},
+     {27049119,1235520,-16209036,-11172392,3910037,
+      192286,-30809959,1765185,-9177139,-15288210,},
+     {33543240,-2947043,-14561058,1404218,13489220,
+      -3932771,11586371,-15597745,12773293,-7701970,},},
+    {{-1533413,11998124,-14964332,-9913895,-12699642,
+      14254236,20719484,-7640682,6622144,-2334600,},
+     {-27608552,-13478739,23740346,-5518702,21712101,
+      6870332,-28635801,5769031,-11493319,16175470,},
+     {30213171,12292162,-18927158,3556036,-8334300,
+      -2591927,27479773,-11541038,-21755245,-9464584,},},
+    {{28095513,-6779948,32895572,-5470496,9474714,
+      1923415,-19043289,8571660,27227119,-2503557,},
+     {-3219381,-14408362,-10126599,-4428619,-7108760,
+      8033943,5043047,6127564,-24509536,-6844583,},
+     {-17454544,12315006,16710597,10455822,-10950346,
+      -11582261,13731766,10358568,-6828937,5405579,},},
+    {{-29491160,-6032531,-10517993,-10363501,-22177309,
+      1641611,-30339543,-4929437,-29996623,-14872642,},
+     {24002603,-10892124,-377180,13775264,-31060852,
+      -13717791,16831600,-4148599,13948100,331582,},
+     {4047888,-6963462,32730546,15294590,-15332037,
+      12324876,18131002,11269119,10668016,-4272146,},},
+    {{-3815787,2429463,-22132958,4191106,7055907,
+      15957852,-20296179,-7523442,-8348678,3235527,},
+     {-27992561,-1133744,1258603,-8418553,29159634,
+      9248648,32638676,9087979,-28448172,-16126987,},
+     {26669637,3763021,33178541,11954195,-11921471,
+      3606603,-323649,16380531,16030655,-14403039,},},
+    {{18841151,-16358847,-25117049,-6580095,-8194285,
+      13597289,18651190,-9471480,-21903705,7427084,},
+     {-30372212,-8787434,-11627214,11406573,-12476849,
+      15856731,-8722146,5457535,-16054073,-1768473,},
+     {-30010319,-2513291,12154837,1987514,-25927352,
+      -4686163,1302429,8260785,-12034249,7276668,},},
+    {{-7505718,-16103646,24775813,14587605,-13026685,
+      5567700,16787613,15130093,22653371,-784207,},
+     {-23133513,416481,-21208203,-13429663,-27453398,
+      12087448,31983685,15952734,1003692,-7897189,},
+     {-863895,-15326967,1368949,14274246,-1261429,
+      -7396108,-13158881,16719933,-18561474,13854631,},},
+  },
+  {
+    {{-11701680,-2966396,-4724526,1951353,6363511,
+      5833367,-12100856,-1196248,-20251528,16469643,},
+     {-9119217,-7706548,11233430,3029977,1135249,
+      6884724,-2495021,13169614,-18368367,9927157,},
+     {-33345133,4497850,-18362043,-8748942,18590705,
+      -5322413,19773237,837909,31541378,4291275,},},
+    {{-6455666,4502636,18931619,14666851,-17227469,
+      1150171,-15318791,-1870699,-15404095,14456507,},
+     {26821409,-14227146,17743515,-10435254,-21075355,
+      -15068156,-33497161,5407613,32062434,-9709826,},
+     {-19829899,14192409,-24579904,-12915754,1264648,
+      4506910,7412986,-13900014,13864697,-16688963,},},
+    {{20707175,-7085058,-16726986,10647236,-32936541,
+      -2801811,-16812078,14583310,-20186823,-9740446,},
+     {-4183237,7769564,22993044,-16119135,-982618,
+      -4010647,17526045,15970486,30279398,-13520187,},
+     {23293111,-14286887,23483456,14218337,2256136,
+      -14025809,25369985,-12901019,9642614,7068813,},},
+    {{-11200753,12334287,24699464,-7630961,19265711,
+      10571379,5537826,-11490604,-25737824,-15844711,},
+     {-8288139,5897826,-2762940,-9575365,33175561,
+      14651673,-20969799,6909831,11881139,-15946888,},
+     {-25798601,7873769,-24081606,-15168114,-1809963,
+      -14335650,-32449227,-5329789,19118074,4250853,},},
+    {{12265969,577045,-4176383,13463860,20602308,
+      14468961,6565038,-11224816,7352619,-14468678,},
+     {18882835,-8574474,29510238,-4893192,25823782,
+      2692763,3029200,7988389,-14432187,-8550302,},
+     {13283055,14038328,29530661,-7182822,-18081200,
+      1463433,-764590,-8388915,-4971217,1581178,},},
+    {{-1772188,-7640024,26714455,8335304,-6538540,
+      6985586,-19784746,-9024008,21699402,6776169,},
+     {-31975125,-9711721,-3932828,-9060597,-9347198,
+      -4291837,30943288,-3139557,-14620263,-3031190,},
+     {-19852264,2832214,-12368089,7126867,31366903,
+      -223785,7125817,-10932512,15077594,2435511,},},
+    {{29308823,-5670001,20365626,16635071,22575870,
+      354558,-22799934,-13508034,-28798515,11597089,},
+     {-22811296,-13563582,21686163,-999598,-9308301,
+      -6487301,-21637681,-14632242,23601108,-16563488,},
+     {20994791,-4679117,20573106,-4552220,-19219485,
+      -3812931,-11841491,-1686294,1167527,11449625,},},
+    {{25810822,-1906802,-4069911,-8311356,6246976,
+      -2455258,-33018177,5893270,21668537,-15045700,},
+     {-28823364,12665478,13554185,2509450,-17151474,
+      -10802348,-5723387,10242479,-23062743,-4538866,},
+     {-11492276,6633441,-18546733,2332649,-23729953,
+      9337823,-13118990,-10130548,27958987,8864397,},},
+    {{-3886359,-2553468,20051449,3833850,6791930,
+      14892798,11538616,-2338548,28860221,-16391691,},
+     {-14529821,-5293812,30458135,-4171424,32003522,
+      -3577743,-5909642,-16549362,18367415,1085844,},
+     {29121302,-5529475,-1822777,5659325,9380286,
+      -9276342,24818552,-14366834,17784657,-2610695,},},
+    {{7526739,-12203913,19040034,-4266939,11568847,
+      -4995481,24639108,-4436430,-5390531,-9292833,},
+     {10591488,13237118,3710979,14448964,-31382880,
+      -6512685,23225649,-5741307,-17326610,-9656016,},
+     {11004063,2412067,31964161,-14733349,21299225,
+      -15923490,20823683,-6118132,17975471,7324646,},},
+    {{-1073539,11191737,21747122,15344175,21381921,
+      -10026317,-27930188,-13176218,1031848,10772009,},
+     {3837838,-3241776,-6100875,700037,11602221,
+      -11636327,11596956,14003762,28167703,-8735012,},
+     {22037798,11825321,-18268738,-6548899,-4294053,
+      -1705796,-6661019,-8270587,-30498733,15611265,},},
+    {{-19908899,-12652263,-15868818,-16032877,13932221,
+      8875486,18825781,16310228,-18141066,-1916453,},
+     {31211134,-3615137,-6506478,-16063838,2378838,
+      -8251664,-2515327,-3355611,22048492,-2629942,},
+     {31191217,361481,-15537320,14860514,13756726,
+      7051774,-1890749,-2626713,14586620,16445896,},},
+    {{-23944048,15085857,24809189,-2566565,26996355,
+      4640509,8673241,14993789,-28784624,10517699,},
+     {3182204,5809013,-4887528,-6435941,15154572,
+      582861,30123680,16240158,-10626436,-3780557,},
+     {11305520,9855903,-21456144,1735761,-6541998,
+      11080360,-3298820,-10053050,26725588,-2398457,},},
+    {{-1852552,11662105,18703308,-3489331,-1819823,
+      8868291,1042798,-8159413,21750956,2506357,},
+     {-31667759,-13461595,-1600298,-9698458,-29973944,
+      -7844718,-7172305,8392255,11998366,-4245819,},
+     {2504251,554921,-17697771,4657929,20447356,
+      -4171740,21221143,2067747,-22754452,-12287955,},},
+    {{-17322479,617433,-21209582,7344850,25725732,
+      -12604768,24152413,-6807759,23306469,-7850351,},
+     {6165410,-9809069,-25150778,-4433705,24502084,
+      -364508,-5468953,-11258796,25283780,2445890,},
+     {-7106597,-13896752,11996240,6666374,-17043383,
+      3845576,-5379857,11740082,-24208638,13498295,},},
+    {{26825749,13373634,-22323565,-12815638,4546392,
+      -43555,19291911,7584689,-29242962,-10092081,},
+     {29944478,3059616,18197746,-16593009,-9817369,
+      16108160,5241088,-10890380,13607076,-7974041,},
+     {-25379868,-15557043,29462140,1733606,24516605,
+      3156840,-23301890,-14574054,29441261,3530369,},},
+  },
+  {
+    {{32703173,6714548,29809087,11826025,-13084433,
+      12588398,8104886,-1601802,-24891046,-1219577,},
+     {14281461,7812689,-26653271,-5221400,-3318029,
+      -16064480,23694776,-13039055,-2354479,4180136,},
+     {-18309309,3855137,27118732,4235117,-4290741,
+      4632457,-4055096,-7896699,-30127514,-3827903,},},
+    {{-28784248,11225800,-7181950,-11711480,-16261251,
+      3301003,18605234,-10147536,14452368,707164,},
+     {4486457,11601865,-10818202,2082352,-14631826,
+      -11556875,-26907413,5535899,-26757856,1474875,},
+     {-7041244,-12230096,-23676130,-9680205,-25745449,
+      64962,-7285341,12754051,-27338094,-16652303,},},
+    {{191574,12889408,9635268,1764076,5201861,
+      -12450078,-3191587,4561244,22261485,4081863,},
+     {12102623,-3569680,16321335,8407883,22770940,
+      10785445,-30008265,-8122985,-6885613,4594111,},
+     {-17310414,-15093357,4959517,-15071700,-5618439,
+      -14958239,-26729510,12359905,14144965,-11630995,},},
+    {{-16964921,534600,-31326266,-16572383,31823151,
+      2134838,25988414,10495189,-2726487,11478156,},
+     {-17560447,16667248,16860935,6407391,-4792903,
+      5260658,16849089,4516575,1555885,-1130031,},
+     {1218844,-16467506,-3230610,979851,22839490,
+      8467619,10701606,2467659,-24318152,14338652,},},
+    {{-18379162,-12441343,-26970680,-16705070,11366444,
+      -12656210,24847180,1816830,-5887019,13960859,},
+     {-16337278,13522154,-10849396,9577000,-4417780,
+      -12200647,33234706,-2594720,22759360,434891,},
+     {-31010088,-15695800,-19889281,9030401,-19532543,
+      8579472,16028249,13446551,16917744,2172434,},},
+    {{-11478178,-9063291,-28988839,8057839,30463162,
+      -15029024,-30287948,-7592070,-25727339,13991243,},
+     {-32803952,-10716405,-24552460,-7838274,3319695,
+      1517415,26876976,14421728,20320196,-3609056,},
+     {-26634535,-2253068,13594579,-5071720,-4120818,
+      -14611596,-5028156,-7920000,4066689,6194514,},},
+    {{-20715450,12868210,22631657,8329380,-16720758,
+      -3293151,-5533844,-1478796,-3939483,-8497575,},
+     {14562031,-16204,12229155,-13846154,-6711227,
+      -3840426,9215285,13811463,-7062594,-15032809,},
+     {-22939492,-2777572,26214377,1476257,13551385,
+      -13614369,13151722,-10675073,17684371,-6953235,},},
+    {{-30037838,2005448,5223628,-12459958,-6876716,
+      -8242954,-614492,-13397499,9486896,-16192867,},
+     {4744388,-122880,-7185982,15957983,22893469,
+      -13324232,-7516001,-2070052,872399,-6175550,},
+     {-13166711,-14605267,-3791035,16418891,21597923,
+      -6342418,25163331,-12673962,26433418,-10484179,},},
+    {{8356640,6987374,11587028,-9345585,7152284,
+      6955038,29858922,-5622229,-25883343,943756,},
+     {-7194871,2230468,-9717290,-1599095,-27817409,
+      -2119259,30017197,-1011127,-5030938,8394131,},
+     {3497560,-14434454,-15427109,-8436953,9668415,
+      7049045,-22063101,4785586,-1273910,4194941,},},
+    {{16548755,3011495,-4777936,-3006480,-8761525,
+      -1685931,-15311764,-14612331,11619355,-8953384,},
+     {-26114725,8810223,2672530,-1069611,-21423065,
+      -11226572,-27756205,15552323,-32292038,3177339,},
+     {10164865,-4992707,-19037344,11736631,-16740283,
+      12555880,-27848240,15272335,11195755,-13582145,},},
+    {{-29352174,1017114,10514475,-9580887,29499384,
+      1016121,28929362,2564357,20283661,16561867,},
+     {30501363,-11698716,-29656725,2536135,-31523665,
+      -2008107,14399498,5127017,2652606,14420407,},
+     {19703761,-5404,12914584,8231660,-12161002,
+      -14889247,32785028,-9333324,8466969,11519522,},},
+    {{15121301,3821664,-1739587,-14296960,-10391120,
+      -4267497,-15073219,-3150209,-19854605,10174598,},
+     {-20788309,-10635089,26962900,-12087723,-2057612,
+      -1694037,26381215,8847084,16052990,15357199,},
+     {7152936,-8983974,-29902766,-4454956,-3694060,
+      -9908575,-12753554,-7914339,14119848,-11214083,},},
+    {{-32070920,-8928351,-19778355,-9684002,22236585,
+      16734556,22228218,-11562849,-17689204,436962,},
+     {-26863406,7126106,-13909803,-13752911,-14504078,
+      -14783766,-6616953,-12806418,-29401001,-10858429,},
+     {-6700499,-14543038,-27029088,-16509516,-5737348,
+      658742,-12260403,15956942,9439636,-1458218,},},
+    {{-5208200,8083775,-26868910,14449327,11417717,
+      13129875,-22700318,16273213,-5197107,15906123,},
+     {-32327147,-7015870,22191365,-6759312,-18148124,
+      4264822,-14317486,13053625,30091772,-6686589,},
+     {-7107473,-12634746,-7407918,13243562,-5100278,
+      -13995658,24562184,5831770,6039310,12583578,},},
+    {{18718763,-12849005,24082001,-9878329,-2118255,
+      -10214140,23758439,-4943486,-2376259,10452214,},
+     {18652342,-16343731,-24204043,-15344738,18824565,
+      -2580009,4060641,-10141347,18719299,-15986347,},
+     {-29810451,3973180,8644202,-1255075,-17797741,
+      -3739785,5471639,-4673191,-1704220,5864458,},},
+    {{-20348465,10585017,-8182043,-3632480,10987184,
+      -1415399,12659515,14344376,-1646278,553885,},
+     {-23801087,-9453159,-8024987,-13935876,17913827,
+      -5199334,-22453192,-1093456,-1283086,15440791,},
+     {5662307,13627394,-9401178,10261717,-28626894,
+      -16734583,12411536,9625065,20166444,-8229985,},},
+  },
+  {
+    {{9355414,-4037821,-8912945,13834798,-421974,
+      -16767073,-8575388,8569717,106382,-4779904,},
+     {-15848522,-15628126,-4487494,-5333605,23687909,
+      5914333,-5574061,-2261617,7600879,-16608163,},
+     {3217742,-10647902,33504097,-10717952,-5281549,
+      11022504,19789593,-5734978,14236662,-656827,},},
+    {{-9211339,15414256,28420531,-13169305,-23515614,
+      4553714,-12660668,-8434530,14275199,15615864,},
+     {2387846,10692424,-21438311,9860152,-8612302,
+      -4112348,20996764,8906582,20972826,-14195976,},
+     {28780448,-724966,-20656540,-15920877,-4759361,
+      1764583,-12099946,4080382,-30597465,-9865021,},},
+    {{2429734,7363990,-1194693,11080912,-32510368,
+      7883471,-9577907,3207564,3067543,-10953549,},
+     {8134901,12688927,-31358564,6063149,25063089,
+      5426279,601597,14285160,-15648922,-13000754,},
+     {31301950,11105350,-4585508,-5044404,31231025,
+      15575228,10740631,-12756331,16467533,-10773847,},},
+    {{5233061,-4233042,-10136247,13117063,-27044510,
+      -15627554,-14769588,-8699198,-23781989,14861133,},
+     {-31695910,8184351,-22438423,-9250912,-17813253,
+      -5399947,15233825,-2291444,23882501,3767358,},
+     {-27783417,-5014441,-17123670,141222,19579316,
+      -8550321,-19842774,-12481841,6493969,5203749,},},
+    {{-6169981,2301199,6782399,5720877,10258193,
+      241494,20149269,-6620680,-20819722,4844100,},
+     {-21301287,5758558,-27541114,-14640574,-528799,
+      -2972821,-3847566,-9256799,13183306,1752000,},
+     {-4280628,4247678,13767168,1401005,21301846,
+      1005158,-33530621,-14702326,4844018,-11839012,},},
+    {{7909302,9656424,-27358081,6789294,-8756086,
+      -14852035,1976378,8798412,-24755248,7245396,},
+     {31627816,-867437,-24253960,-689809,6006031,
+      9592215,24035616,-12762329,4894417,-16430948,},
+     {29143012,-307972,31996964,-4054198,23001959,
+      -11192598,-8551662,14683825,968164,10472455,},},
+    {{-2783093,-12709181,10273200,-7399538,31033640,
+      -15284838,30385601,2971214,22710439,16526647,},
+     {-16959689,9048998,25027207,14337919,31477241,
+      -5296090,31206153,-16650934,30996541,11320049,},
+     {-15714167,9319991,30116625,9180908,27819931,
+      -7124853,30039105,-9928944,2374709,615519,},},
+    {{-21546704,3949052,-7892306,5140007,20045214,
+      14873308,-10691474,-4729187,22155474,9291832,},
+     {7869787,-1868082,30543946,-14172230,-27983505,
+      4849919,-7431747,4650077,-11147680,10786912,},
+     {-31456612,10237954,-31699477,-7073411,3920250,
+      -16108817,17113486,-2351927,3210536,-4980519,},},
+    {{2981034,-4944038,16170023,2358605,-24448111,
+      11298081,20901972,5277117,20759924,-871308,},
+     {-22432783,7958530,-7952926,-6922314,17778201,
+      -10772919,24751141,-11793358,7354403,-1978266,},
+     {-13007784,-6037357,27795796,6141886,-31515828,
+      -2810671,-27178753,-11276242,-4022651,9841031,},},
+    {{-6335720,-2178869,12251126,-8146335,12696154,
+      13481005,32581419,-5608816,29323760,799723,},
+     {19816446,3655189,18841617,-9093586,24105451,
+      -11792842,-11942044,-5341343,14590389,-2618856,},
+     {29288073,9092583,8820725,4957924,29872055,
+      -8061142,30103127,-6253760,-8445247,6545536,},},
+    {{-24880800,-6244528,-27746945,2277521,856789,
+      10371792,28303167,10521620,11115262,13443697,},
+     {29677455,15426131,-6861238,2231150,8324297,
+      -14850558,8705462,-5108108,-24750493,-630877,},
+     {14974741,1803242,12669780,4420962,-935409,
+      5695575,-25813123,13840262,14730084,-13467161,},},
+    {{-28300576,-7504097,-10007129,8438860,-13956717,
+      -8720726,-8141063,-5555541,-30458159,4129351,},
+     {19080208,10401106,20405781,-9070502,27751912,
+      -8741951,-8897939,11418231,-18067857,12709420,},
+     {15281626,-8698840,24708826,-2138132,-1002880,
+      -2253615,-10940999,-16623524,-4708121,-1229415,},},
+    {{28846536,2310310,19415574,-7656216,-3887015,
+      -7376670,-20484230,-6325264,-17289226,15950652,},
+     {-12807462,-16048380,-22257267,-5182051,-28381770,
+      -9256833,-30005115,-3970901,26891790,15391831,},
+     {-8568730,14021470,-19848288,13958414,-6489138,
+      -14488813,18256705,7389453,10944478,-12570924,},},
+    {{8883473,14899473,23978070,-14979723,-33259857,
+      2852143,27982011,7771650,26303573,-12457854,},
+     {-24037177,1092426,-32668099,14296214,-18333537,
+      2470917,-24477239,-5364862,-12767322,2651674,},
+     {-11609694,15131156,-14707425,343279,19432677,
+      13671493,-20058201,7775942,-28156819,-13715243,},},
+    {{-8823272,-15950382,-22475029,5587400,-2036946,
+      -2986972,-17389263,-10614192,-3666786,8330529,},
+     {32264650,-16150374,-4915361,-8517578,4365324,
+      1277907,9641652,-3869285,18683682,-6032306,},
+     {15437741,-7981743,-5045204,-7230388,13482100,
+      -15446360,-18616912,-11816846,32595995,-6304635,},},
+    {{29793069,10912554,-2293074,-15634643,-14927901,
+      -4727874,-6546913,2734948,18392066,5002924,},
+     {1152381,16159216,-4940350,6825574,-5134755,
+      -11686542,-12146598,-4727436,31915648,5162889,},
+     {32124651,-3329031,8306521,13476115,7187814,
+      -620737,-31604816,-5252129,-7471496,2519190,},},
+  },
+  {
+    {{-600377,-1769240,-31504758,-13377420,11915604,
+      9491575,30719094,769885,-24035454,-14395526,},
+     {-28111445,-14953207,-32782124,3289667,8361231,
+      -4353115,1694073,-1547857,20810106,13583238,},
+     {714022,-16534592,-22302496,-7046749,33172496,
+      -12500663,-12405040,-8826847,23946342,-10468336,},},
+    {{-14723230,-7439492,-21384386,-16445616,21961188,
+      7397911,-30271096,-9419215,19536491,-2405538,},
+     {15446026,-7124044,194042,11602716,27502973,
+      6982014,20813531,-2216724,-10620251,-10746636,},
+     {-18359284,7175992,4643652,11962148,-4776459,
+      -5040482,11511800,-2079179,29204564,-9761435,},},
+    {{8474532,6914006,25701160,-7975530,-7319230,
+      -12859833,5453568,5413272,16055205,8094616,},
+     {-14672198,10595225,-19458734,-14710462,-1015821,
+      -13242180,-29582693,-15626878,-19271393,14178869,},
+     {11619775,-11893310,-26657849,14649781,-212400,
+      -4429495,20002521,10219547,2670067,5911691,},},
+    {{-14812468,-2732311,28601645,383546,-21334497,
+      1929061,12775590,12298966,-27877144,-2099688,},
+     {16040222,10747168,-23062385,-2864922,-5429130,
+      -4260628,28341947,14096469,3540156,15196056,},
+     {-21632844,13958345,-4761744,2677221,5982458,
+      13370108,22821124,9066974,-9397370,3289727,},},
+    {{-29988270,5808837,-7746811,3615727,-10173180,
+      6704031,21344886,2142207,3784951,2945162,},
+     {7928707,-15858126,20800375,5911380,-2183037,
+      10683041,-1429111,-2356379,-31978684,760054,},
+     {-32637396,-14079269,19935700,13704656,14411364,
+      3484417,-30742297,-15718995,-25087835,6595435,},},
+    {{-28829575,-2764095,7162587,-14009225,-26232530,
+      -8450926,-16544656,12473618,5057176,7519902,},
+     {-28183181,-14670385,-13022323,9857106,-467787,
+      6900090,31201049,-7143981,26423381,-4899908,},
+     {4437188,5451099,22629803,220650,-107988,
+      -8540455,3734463,8863010,19759058,13415800,},},
+    {{25059876,9421271,-13804736,-8471254,-31135097,
+      -4829742,-19717890,3620931,-22652432,3736586,},
+     {-8321210,12659960,27095335,67395,12768688,
+      4657250,-15091458,-14277874,-30796856,-1686209,},
+     {33231870,-2958067,-1217795,12270180,-12425350,
+      -4339832,-16245561,11796865,23664605,7661549,},},
+    {{-20877321,10216910,17640140,9488607,-3109601,
+      2271585,11334196,312299,-31577008,-14492893,},
+     {-20077793,-8108239,-60047,14781123,22045098,
+      589795,22275585,-3625188,-4752246,9727786,},
+     {15487337,-11391851,26726775,15785416,-20752364,
+      10321972,-21151248,-1153535,-3417964,2634944,},},
+    {{-30716840,5808800,-32554980,16378618,-8219481,
+      16076556,26561419,-13349581,15542700,-11383583,},
+     {30448571,-3280093,-24778420,1175803,15580622,
+      -1790532,-17795635,-3847535,29738454,-10813516,},
+     {-1699550,3084920,9012786,-315125,9526537,
+      5750949,-12499175,1117644,-29222767,11179103,},},
+    {{18442456,-2207676,26612418,16616523,493264,
+      16183619,10132335,-12945549,-750895,-15903906,},
+     {-8476526,7652681,-6391195,6815642,-13549238,
+      -5168247,-1083321,15793211,-29327539,13307731,},
+     {33196808,-12035886,12380411,-15873110,-20618816,
+      -2480848,33402595,13884186,-9749530,-13828033,},},
+    {{-28585946,14260994,13859608,16246106,19442935,
+      -16488883,13034400,-3442710,28535183,-3640020,},
+     {5363318,-13384516,-9008885,11169965,15746066,
+      6950851,15606840,-9417938,31153596,8075712,},
+     {5486036,-2774178,26625208,-3289924,-14962913,
+      -5277957,9041075,2441787,1254194,-1613605,},},
+    {{19987325,1544144,-19353602,-15051869,-11684173,
+      9353119,26865011,-931216,-18775533,16039725,},
+     {63098,-1585908,17063623,437769,23544951,
+      7909278,-11620448,3127664,-6488974,-11684538,},
+     {-7785029,16772539,9233833,-5144938,19672595,
+      -14358694,7259825,-12916225,31863421,-11929012,},},
+    {{30661262,6995479,695460,-14352383,-17099176,
+      -4652472,-11616355,16207545,8585351,-7112029,},
+     {14688010,3784594,-12513612,-13020986,-7555210,
+      -1142103,29880748,-12107766,4559943,4728849,},
+     {-16591601,-722147,-25992282,838287,-28091363,
+      -6712296,-8950493,16002469,-11543576,-5056561,},},
+    {{-16894785,-16297028,20028583,5729982,-19292979,
+      -14712242,27985632,-6945802,27814135,-11861317,},
+     {1335789,-14571147,9951906,-9010528,-5035255,
+      -2718696,-19137818,-162353,20951985,13466054,},
+     {28876027,2817220,14591654,2030190,-12100493,
+      -13176311,6612036,1222762,22434583,8515105,},},
+    {{-11117748,10055855,31495208,3604866,9886703,
+      3807055,-15985175,16121660,18072050,12238503,},
+     {-20704738,-206875,22231589,-12954179,3065592,
+      -2526602,16540741,-4707497,-11638324,2149412,},
+     {-20405560,-14459772,-7038117,14606951,-13261075,
+      -1485183,-30246329,2229804,-1569255,7602270,},},
+    {{25547067,-5416752,-28955713,13300357,13883896,
+      -8349323,21407236,7921610,-5224360,-12194902,},
+     {-1428902,306977,19977294,-13137418,19537380,
+      2344674,13417149,-5684746,9189678,6525836,},
+     {31427125,-16568217,-31536808,-366051,19202661,
+      13876218,8807264,5537019,25588545,8902966,},},
+  },
+  {
+    {{-13380971,6232285,29628002,12570188,8397502,
+      10006914,4787127,-12884918,-16039149,-6694334,},
+     {-32329070,6640986,-24312554,5622909,3575728,
+      -14141443,18002710,-2629352,-29302090,-8077672,},
+     {2533764,-3049154,10014359,-2560018,-25596084,
+      -15427587,3843287,3548713,32069752,-8595895,},},
+    {{12318550,-1807939,-5582722,12918572,-9441502,
+      2005034,3390104,42675,22107667,1561084,},
+     {12592331,-11033374,4985821,4279316,-11237809,
+      -3740520,-257126,11182113,-23762116,-3183553,},
+     {23819492,-13993395,-20598285,6190949,15139252,
+      -10227805,-5945109,-13924765,9069983,10484108,},},
+    {{22509794,4173026,-1896394,-1150995,-4653946,
+      -9058725,-22366962,-10349742,-27067737,2254532,},
+     {19663551,-7330267,-20503925,-8318951,-10101094,
+      10764540,-18378278,-1455979,32777339,-5878699,},
+     {-8210564,13272245,-7973729,5067888,-28683382,
+      6492289,4650135,6353891,-13567776,-458142,},},
+    {{4720726,-10848882,-21804617,5049124,13108242,
+      16504928,-4356348,179157,22948374,13626261,},
+     {23249631,6632498,13893553,-8577186,-23399595,
+      7186709,16272986,-2603856,26926527,4301561,},
+     {29708056,-12847254,23343085,14643167,13805774,
+      -14853795,29078694,6026028,-8422888,-7390314,},},
+    {{-32184562,6140266,23393746,-15023325,-26295183,
+      -2344627,23823541,-13978788,18961577,619919,},
+     {18726172,-15551155,-13892693,16152851,31261041,
+      6357572,13366066,1395790,-6327985,-8491833,},
+     {-5751645,-9428108,-12795680,1896737,24353431,
+      -9494809,-10700168,10169027,-32060063,11389179,},},
+    {{6587926,11803293,28552523,-10048874,29979624,
+      14474624,16069398,-5333655,11186550,2295191,},
+     {-11863708,-75823,1791862,-8910038,-23984472,
+      -1610899,-10939000,-3610053,28040521,3729819,},
+     {-17530564,867593,24012435,-4374251,31023274,
+      -10263831,-32009393,-89819,-3056009,8831097,},},
+    {{-798700,-15840064,-28729186,6447817,13615742,
+      -5649727,9476799,-10899759,-21136157,8171266,},
+     {-30920661,-6321165,-17303965,-15811495,29895572,
+      8283488,-17682177,-11784115,-19415643,-10416399,},
+     {-11114706,-13884223,10421031,-12594659,-26418204,
+      -12439021,32268553,10491317,-9408582,-4575481,},},
+    {{-14551705,-3661178,-6221411,-6857803,11297119,
+      10652612,28067980,-2532100,12332523,-2375211,},
+     {20857095,-303984,-9264085,-4676087,31177979,
+      10202431,13276471,-16180398,32567007,-13081993,},
+     {-12257357,-6977221,-6346199,-16011072,4350452,
+      10352763,-19421901,-15438619,-10945091,-3296723,},},
+    {{-26778125,-16304828,-1531256,-14435808,-25743759,
+      -14584952,30182660,-7121139,-22501635,-10346190,},
+     {-14065750,4569150,-4890841,-7771159,-9386758,
+      -290489,7478633,-14732174,3459161,-5456134,},
+     {21282602,-15629380,21529167,-10367433,-15485250,
+      13382727,-26618445,-5758365,25466142,10324760,},},
+    {{-24873474,3869745,6606568,-3354531,22783564,
+      -4913925,28907953,6564495,13181974,-4072021,},
+     {-3203961,3590906,-28827723,-10954969,-814346,
+      16262815,18396819,-1017983,-29639908,4612071,},
+     {6012844,-3209463,2168871,4846919,11334983,
+      -2271440,14366149,6747476,11159705,4793848,},},
+    {{15073042,8834456,28462830,-5498082,14356650,
+      15206390,14197695,-6135940,-28560801,-11525100,},
+     {-26109624,-4364052,11974229,-13253249,-10408340,
+      -1357371,-7809480,-14856271,1394094,-11651564,},
+     {32805471,12461879,27735774,-634584,-7839302,
+      -13382185,-27221763,-14187682,-20947688,-11999543,},},
+    {{23065340,-280349,32053135,-11637291,-29476042,
+      5652196,-13306326,-15552573,-32992378,-11235395,},
+     {8776637,-15702291,-13012078,778000,15086219,
+      -13269610,-32278085,4639557,1245491,11043568,},
+     {18516864,12982300,21344354,-2854811,8591056,
+      -514354,27982703,441610,-31404500,5364625,},},
+    {{16575335,-15463832,20572307,-3955377,-11983904,
+      15294904,-230970,-14935809,-18531713,370083,},
+     {24844130,-7931793,24753322,-8388659,1218028,
+      -16356721,-20714745,2965827,-11342555,12552886,},
+     {-15778995,-9061354,-10661284,-11748491,24831707,
+      -4638994,-10164376,-14131101,-30779495,-7387123,},},
+    {{-31370641,-9815402,22277391,7595835,289099,
+      -5192908,-27798979,-5257561,-439006,8879360,},
+     {2453819,12720787,-24421835,-13088621,-1639383,
+      12674845,-27760404,12222710,-5606988,6864063,},
+     {-6893204,-13826815,13610019,16462557,-15389373,
+      2449955,15526119,-8525832,-31193390,13520143,},},
+    {{-19701361,2851167,26606506,-794123,11571633,
+      3456347,-33461083,-9905004,7668172,-9800683,},
+     {-6717587,-14357770,-13811168,6248745,-7406293,
+      -4492755,-9318027,-9393164,25174017,15328382,},
+     {-13140392,9444811,33276711,4507670,16862441,
+      4818859,18783003,9161501,-13005589,10947191,},},
+    {{8953500,5108674,8229633,-2364623,1184554,
+      -13618241,10770421,175765,-30936146,264586,},
+     {32030271,-3654935,-16545433,-11165519,-26253209,
+      6457502,-7246148,-4895490,16011956,6928338,},
+     {26547088,-10737905,-17977618,-9142790,17850607,
+      9935404,25526251,-5422593,-14268112,11111285,},},
+  },
+  {
+    {{12101714,16125417,1949401,577469,-12653926,
+      8180172,-17165987,-14814268,30885943,8586323,},
+     {-15668368,16669512,5337263,-16154467,-14126467,
+      -8100914,-729646,-10929219,1752181,12951188,},
+     {21374509,-13105787,32438873,9962641,25347899,
+      -1423471,21984167,7998092,9335912,-5639857,},},
+    {{-16852831,-15264488,-22667196,8938145,-15425492,
+      -9991216,-18346815,7638726,26791115,-6172995,},
+     {-31936492,2748950,-8119154,15393923,-7350466,
+      7189589,24593558,-10955316,19066384,-10505652,},
+     {29075944,7946345,-18617923,11581951,7647238,
+      14007697,-28509922,2094542,-30185497,8135765,},},
+    {{-4838298,-3223240,-33057610,7968057,4651110,
+      -7497358,21883844,9965713,-4751912,11056569,},
+     {9029139,12060460,21714140,6052208,-25274284,
+      -13522522,-26484779,4267002,-13324763,-87606,},
+     {-11572502,-5391709,-28076020,13648569,-15647399,
+      -5243767,-4859254,-11096912,-12931334,-12554307,},},
+    {{4516374,5961206,11740930,15611445,15255580,
+      1785607,-8800747,15344368,24876957,13564772,},
+     {17579471,10648261,-14197492,-3484033,19589441,
+      -4873631,-24291401,-8726309,-6190750,2183528,},
+     {20476441,-8094977,-17697448,16549473,18441093,
+      -2537853,7628718,9291881,29939364,-8959281,},},
+    {{-1363545,14224378,-30490647,14251680,12753948,
+      -16110028,-14340140,637447,8627866,12363281,},
+     {-11643087,-16664837,-12830099,-5472569,-8560754,
+      -8158996,-4895142,-7275081,-15672957,8772593,},
+     {-2315563,6469209,-11975236,8556174,-6742727,
+      -10130428,15967065,-4745912,-10666338,10256878,},},
+    {{1976641,3543370,-18439784,-2651881,27349524,
+      7454210,-9266872,-6588262,6464587,-10105281,},
+     {13749234,11017665,2692234,15448736,-25943570,
+      3320462,20352760,-12026656,3369842,7801613,},
+     {29160654,-6151683,25285239,-3576138,-32788383,
+      1467585,-12571959,-6854784,8087536,-12228632,},},
+    {{-30498367,-16239654,-13482687,-14980685,-1945236,
+      -531179,-27284599,-15066400,18788684,8439,},
+     {-32281948,16207942,-5146075,-7774194,29042306,
+      10147686,12594552,-12217655,-22335282,-10310410,},
+     {21562328,-12998069,-17054123,-13031669,-13609530,
+      5482997,2422755,12682549,4362838,-803285,},},
+    {{-4390455,-5686607,-31002349,16502650,9513350,
+      13614448,3738823,-2894918,27307899,-8333917,},
+     {-4790887,15781028,8854369,3469621,12615222,
+      9370060,18589642,9192187,3422621,-12552904,},
+     {22337720,-5900749,-6069871,-7551608,-15714998,
+      6346895,2049890,-8369920,13710283,11119138,},},
+    {{-33401600,-2242184,20447053,-14141832,27661663,
+      12723459,10578033,7409161,29860300,4975652,},
+     {18471528,11516071,27680391,-14259259,25382587,
+      -9397217,9448794,6440954,4819473,8803092,},
+     {-32031252,-13636867,14501033,-13208002,31523823,
+      -16123936,1434969,-12518384,-13167568,-9705622,},},
+    {{12815352,-9441321,15125724,-15581552,-7878588,
+      5916880,-5725941,-1494895,32037217,4589219,},
+     {-26596563,3204731,18930865,12093321,2712210,
+      13683956,14666967,2220788,-5397550,8792823,},
+     {3087485,11946902,-4399909,-10760064,-3272774,
+      -15692386,-31887096,1119800,-25602420,-16683080,},},
+    {{22010938,3966787,-31023955,-5892961,-22008525,
+      13940284,29390878,-494117,-16327413,1420573,},
+     {-12411496,6196335,20213845,10724679,-18672636,
+      9814998,23352792,-1098475,30043696,13334929,},
+     {-15138805,11003814,2390067,7484488,16871866,
+      -8408643,-21570028,808344,1458439,-11708838,},},
+    {{-18922858,-10842555,6158722,14663828,-31541601,
+      -13766285,22377393,13780303,10580295,-1182963,},
+     {10316790,-5935606,8059990,16102608,-593709,
+      13525401,-20775885,-14693860,-6985955,16007260,},
+     {11239305,9236919,-17323264,-15795853,12890247,
+      14428900,22290239,-13386460,-31502710,6922193,},},
+    {{12539770,3514455,-17541647,-15602826,17834765,
+      -7194438,32013862,3529195,-32521533,-8045868,},
+     {31918539,-14686429,-20999810,15473196,-5596371,
+      -2742686,28160480,10503877,13157081,12778063,},
+     {-14370663,-14881601,-5058184,7733718,-344732,
+      8228644,-23155461,-9148712,3284630,-6508674,},},
+    {{12650443,-4842676,8324204,15919626,7906735,
+      12477914,21277191,-9531891,-25029478,10825944,},
+     {-2852691,-6534556,3225115,15651136,18666543,
+      16745105,-24810243,12942611,16004085,4899899,},
+     {-18160411,14284392,7201815,1995094,30041984,
+      -325823,-4975577,9545009,-12001988,-210532,},},
+    {{18763001,12232655,23650433,-2214106,27382805,
+      -14056363,8947229,-16769648,6793104,-10940358,},
+     {-33227636,9467717,26335227,11638039,9889744,
+      -11418914,-25745567,11794645,13523237,-2831582,},
+     {4555486,8691437,861057,6469965,-22780666,
+      7600118,545293,-3354406,10783479,9645376,},},
+    {{-19931887,-10447851,26059922,-2637821,28388058,
+      7511050,21956566,-2785398,-21048924,10329256,},
+     {31774562,11288239,-23722803,4954822,6722337,
+      16579017,4211827,-11855650,20653031,1602436,},
+     {28467856,16100133,-28683428,-7991593,16420656,
+      -4040537,-28804779,9072396,1823354,431755,},},
+  },
+  {
+    {{8623171,7157749,18676308,-14165195,-22299350,
+      13487167,-21862851,1950629,-28583771,1106728,},
+     {24623269,-2927064,2016604,-12903755,-10054247,
+      -8342462,-10101391,8232713,24204125,-2938377,},
+     {33403106,11859731,10295088,-7117265,-27583363,
+      16110125,7006944,4395924,-10748895,-14771496,},},
+    {{21644464,9264081,31491524,14240362,-27129830,
+      712337,1699254,9637448,-665582,-10621141,},
+     {9800702,-679826,30385096,-15931216,-29968329,
+      16064619,11111919,4755356,-257416,12823982,},
+     {-17507235,10524959,29776339,-5585306,-9986278,
+      1832709,15757102,12970175,1595049,-3738927,},},
+    {{11529276,-4062889,23252850,-16615823,18754455,
+      -1312552,23364218,8048962,12984452,9703564,},
+     {20328584,-12576142,-21051941,-16022763,-9996464,
+      -2193993,-20430538,-12255292,-28069373,8802297,},
+     {7814706,-7300800,-7990028,-7112735,-13881932,
+      -15050823,12522604,-12418836,-7145651,-4030832,},},
+    {{11506318,12049589,-17053828,-3984033,33109537,
+      -508269,-25954903,2502331,-2259831,-7814648,},
+     {27314081,6844131,19654387,-14730088,-18484964,
+      6475393,3549019,12949062,-1497540,9388618,},
+     {10777743,-1275325,10728284,-12304771,4545555,
+      -14442844,16345110,-419267,10433743,16707977,},},
+    {{-18042103,16542776,-14630291,-14922654,26466667,
+      12674225,-29656074,-227769,7396067,-7128860,},
+     {-5012836,-12896769,26318432,14297955,-7713560,
+      -13234771,8147425,-1119948,-9608493,8087251,},
+     {15022309,-2441205,19674566,-14121689,1545097,
+      9225242,-20230686,-662024,-1059051,2252552,},},
+    {{9862347,16671633,16936835,13906119,31065973,
+      -14462523,-19300559,9028721,12722875,-6444809,},
+     {12625816,1521539,2901921,11809967,27812247,
+      -6725846,-32501008,-14276575,-7623524,15967274,},
+     {26403255,9136762,-3982116,2335427,7754687,
+      7911527,33446152,-10360420,27426086,3509014,},},
+    {{7594374,-5494435,31076992,7512191,33383603,
+      -1586950,32355565,4115637,-1674108,-15611930,},
+     {28828105,9068057,-24477304,-11090977,28121702,
+      -2203302,-10156460,4342250,23097380,11732493,},
+     {-12355520,-4256475,-16518461,14040794,-23111338,
+      51191,7346684,-6794113,2924005,15809230,},},
+    {{-12680738,7011269,2351849,-3221968,28800049,
+      -2812231,8877125,-8978683,-6760505,-33273,},
+     {-29739428,813086,-27919667,-6996946,12098955,
+      10972788,-23096276,-15052559,515266,-14409825,},
+     {19607699,10576891,30404294,-9611462,-20928193,
+      -11025686,15568019,-14532701,-25673116,13132900,},},
+    {{17070290,-9562880,4782821,-5690335,16251089,
+      9270072,16863479,1866288,12037864,6346966,},
+     {-3136178,10967832,11440770,14638514,3144693,
+      2128404,30713800,12091671,16958441,10762840,},
+     {-23109741,4002075,-15711767,-7996484,6658117,
+      11088448,-19203905,-3036949,24727729,-12980347,},},
+    {{-19547306,-9635317,-6581486,4976449,-24389734,
+      1864396,-19606639,14254182,-33375264,-12062674,},
+     {33104149,2996738,7774026,-7247117,2915505,
+      3439391,-28783239,4131771,10002292,-4028560,},
+     {8733045,-7609733,4128360,3029538,-26474851,
+      5960288,-14755165,-12221011,20631818,-9623164,},},
+    {{-9242612,8000270,12512975,5286111,-15984474,
+      1904712,9445736,14391484,-21152248,6945352,},
+     {21345955,11855099,1174085,-491934,11427177,
+      3647471,4115045,15911279,31762177,-7780288,},
+     {-26127689,-1085951,5731558,-9504353,29255748,
+      -11715651,13238230,11643400,-10381819,14157524,},},
+    {{-21402576,9780961,-10329622,-5003133,21771104,
+      6745342,17300407,6916620,-16374337,11130529,},
+     {-30006843,14884304,8589225,-9585493,-1462094,
+      -140096,23103224,-6516917,15626140,7584441,},
+     {-1506280,877671,24912328,5509493,14795563,
+      -2726749,-12100997,5686072,5081462,-11099937,},},
+    {{958131,-10984785,-26329100,-5227537,32109253,
+      -2218115,23470419,15757336,27007409,8481515,},
+     {-15128159,-169124,12887003,-11197001,-1500229,
+      10105529,10325058,1146213,24302106,8232165,},
+     {19469692,12552151,-977375,3580232,3244850,
+      -16318623,-16560990,-12444106,-19023132,5504841,},},
+    {{24857221,16215912,-6202523,-125251,11400564,
+      -11414879,21491011,15243139,-18187979,-3242819,},
+     {23356687,-2475500,-9420531,-1284888,7768946,
+      -13794709,-9626611,-16117356,-26923026,-5258650,},
+     {29412338,-10746451,-14871812,-6148725,26331815,
+      -8000486,-30191825,3445392,3629640,3113268,},},
+    {{-14195887,5579571,-23677783,-7841432,15893333,
+      938224,1168703,-10636828,6122957,10345122,},
+     {8640408,-16757367,-31573737,12710213,19228672,
+      -1175571,-3540199,-7216751,-14808348,6237473,},
+     {9204394,1070408,-15517942,-16015412,21265508,
+      6758647,3970587,7136316,-2177153,-16416521,},},
+    {{26649400,-7330370,20246960,3525916,-33196620,
+      -13216720,-6343578,-12738841,19092698,9575949,},
+     {-24584710,-11511946,-21568993,-8737542,-19485079,
+      2177298,-10014921,-16277024,-22314805,-863090,},
+     {6853997,-6390426,11640241,13334317,27007356,
+      -5457182,17979186,10915533,20026879,12863242,},},
+  },
+  {
+    {{9159752,6628060,-1213123,5307728,-16529947,
+      -947937,-20776161,6766131,-21407341,11125370,},
+     {-9026633,14469026,10347024,-13592935,-9062203,
+      -4981622,-17264207,10606488,-20639846,-8605408,},
+     {-13033345,3573868,-11315220,6330044,13859985,
+      15921030,-25457023,5725423,-12259429,1105228,},},
+    {{-4047018,-3389298,-18863324,2861151,-26415159,
+      -3093520,-31146801,-4510223,13264512,-6981405,},
+     {-30390895,12467738,6265327,-3445779,-23538552,
+      6049404,12569657,-1075238,-31913720,11450129,},
+     {15157102,-4079152,-25389971,-14945538,-646259,
+      -12099370,14266836,-5582373,-5626733,-8655682,},},
+    {{-10705709,8803049,12186519,12412498,9676180,
+      11524680,2143660,4260304,-19528233,15900975,},
+     {4669193,11106168,-28221262,-8408522,18536066,
+      -15186330,-16903122,-12731579,-24582149,-8473150,},
+     {-7493950,1094019,-31055930,-14691046,-10686185,
+      13500699,33515699,14893859,-12870436,-14198576,},},
+    {{24655587,7529551,24761086,8877337,-4233728,
+      -4088293,-2084261,5204810,-27910402,10258484,},
+     {-13944406,839095,5605026,-15008153,9237331,
+      14029569,-7970629,14004053,10035582,11353846,},
+     {1784360,-11544769,23954994,5783467,32921960,
+      -6888304,12881025,14378008,-19356789,4605305,},},
+    {{11008416,-10652462,11262804,-4935135,16685338,
+      15158213,10837019,7363942,30761482,-10380627,},
+     {-12145404,-9709418,18051848,-7771061,3812957,
+      -15950460,-27677988,-7212504,12150466,16700301,},
+     {-13399744,-5129608,10434835,16573537,-261451,
+      -2923949,-5105183,12916821,22687739,5931455,},},
+    {{-28615773,14657268,-1487043,15882378,-5688140,
+      2272731,-10346967,-11291251,30531833,-12072192,},
+     {-9076549,9379126,-14450563,2323176,17705053,
+      -10560410,-5652837,-5377992,32541557,2041145,},
+     {10321026,9152778,-19313789,3709359,25233354,
+      -11195592,-17631998,-12851793,-11351650,14091547,},},
+    {{-14609008,-11022976,30352890,-9951242,-4262050,
+      1930188,-25948789,9256969,19062229,-14053615,},
+     {-30612581,3716472,-20647463,-368326,20930614,
+      1944566,-5637466,1756011,127281,-1097724,},
+     {308487,7174384,-29544336,-4074724,-30361081,
+      7771324,-22254327,-4940288,-6925889,-3599717,},},
+    {{-19349283,-10727482,-33319587,4665965,5637417,
+      553899,-15613817,-12226575,22033911,16600860,},
+     {32695586,-13228509,19332787,-14853575,-29468378,
+      -13910259,-4771864,495635,-31206061,-12628368,},
+     {14707046,959278,-19840878,-12673846,19788935,
+      12318084,-19508319,13454142,-2446687,9670262,},},
+    {{-26788853,-14590593,5727264,5559061,-17088408,
+      16367968,8159890,12229415,31767935,-1855533,},
+     {-27809224,-12455795,11084125,-13047051,-19018068,
+      16489321,17094269,14147711,13848862,-11377397,},
+     {23088941,-7004291,-7098304,14412415,-10259300,
+      -7926553,15543961,-7293257,-8263684,731520,},},
+    {{2828470,14311206,-20563213,4026638,-4494687,
+      16314277,21703972,-5453782,-23080829,5380219,},
+     {17597471,5343534,-32011056,-2640398,-7538324,
+      3728032,-4326281,-3516974,24038490,-11735291,},
+     {3578154,-14409508,14775084,12134045,-2886990,
+      1299234,-8228136,12053635,-344390,13645541,},},
+    {{-31481298,-15946994,-9991724,9156727,7695795,
+      -13851169,33372294,-3140893,-4960471,8215815,},
+     {14342958,-13528788,25266759,11535677,-8250115,
+      -13213582,-4789589,8999719,-18712226,13796196,},
+     {2049114,-6593902,4863802,-5975015,-11179998,
+      8617977,-15180281,16334982,5282949,8068842,},},
+    {{-13698359,10241299,-19330451,9871110,-22081604,
+      -1620674,9564766,-16511995,-1525121,11887501,},
+     {-13276066,8897619,-13497287,-362687,-22466903,
+      -8707079,32969728,12041349,15970900,-10143112,},
+     {-617179,9441985,-10834128,-15165735,21730289,
+      6974635,-24058644,-7902596,11598020,6051730,},},
+    {{-27939165,4466371,19737115,-13673948,-33286984,
+      -1173735,29995359,-2484675,-24130109,-2223882,},
+     {3337754,-6216264,6173931,6910276,23319698,
+      -9417725,32122321,-7263629,29639699,12065915,},
+     {7470662,-8781681,13077973,-10994264,-25169746,
+      -13959854,21341780,-5373162,-22933089,-9863913,},},
+    {{13623115,6782805,-14478065,-15179081,-32612308,
+      11781494,-4485179,1290416,9696255,-9563175,},
+     {-10930660,-2220003,18917157,-5555350,5854683,
+      16287550,-12882733,-4078006,116121,15629819,},
+     {15318160,12227690,27065168,2468745,4125200,
+      14277201,-20676525,-14251736,-25043599,16344772,},},
+    {{3761900,-10848807,-25836375,-6879831,-9146245,
+      -11750903,-21486308,14415075,-15336742,-14009677,},
+     {2459031,7098332,-22511637,4968374,28259658,
+      -4778343,33398032,-810257,3434971,5089079,},
+     {-17254957,9005536,-19960741,-2475684,-3794924,
+      -172955,33178584,7702157,-14592051,-11282112,},},
+    {{-32072783,-15123586,-28785224,-1533060,-33025455,
+      2400665,2683958,-8678099,-6449201,-1510116,},
+     {10458813,1356702,17497919,12670208,-13963300,
+      -14834364,-23695154,7860780,-4312578,-4470703,},
+     {2298807,8650323,2941942,-13840041,-11924434,
+      579144,-5162866,-14564085,-11723357,-4688168,},},
+  },
+  {
+    {{24424960,-9713155,30202285,-9385391,-17209464,
+      2651887,1623798,15231134,15279470,15034119,},
+     {3236966,-7150100,12784440,-6944248,14695109,
+      12389392,-30013971,-14376802,-23426419,7126224,},
+     {-31918303,-13898115,2693587,-10930747,-32695725,
+      -8637661,-19295344,391982,29027854,-1338394,},},
+    {{-6328345,-3903746,20971670,531440,-6061112,
+      7868932,-31667196,6062028,-26103422,-6666868,},
+     {-11714529,-9244643,-15659575,16182270,33462024,
+      -11784616,6147977,-6783042,-24205162,9358629,},
+     {4502625,7374378,17930892,-8233057,-3266213,
+      -13717446,-28365617,4998557,-22113287,-3316030,},},
+    {{16256141,-5419368,27750965,-4363173,-12187164,
+      -13547375,993079,7295146,2619270,-8675160,},
+     {27746174,-15716313,29902373,-14257169,-3600958,
+      14275162,26512490,233638,9073436,-9736048,},
+     {2647109,-15499700,15244241,397094,24571085,
+      2231010,1235264,-13675816,-1024890,5644324,},},
+    {{14803088,4697796,928037,-602333,-8527641,
+      10690825,20192531,12563190,-32038090,-8973570,},
+     {26944451,-11977563,13511787,-12858202,-1573812,
+      -4243330,-28941663,13743775,-17749921,11068602,},
+     {11369926,3076508,30892828,7419861,11433675,
+      -4183907,17508291,-8076595,15616511,-1010712,},},
+    {{21029253,522449,29750798,-1899854,11127339,
+      -13832537,-10433460,-7339962,25121150,-11974113,},
+     {-22611565,4022074,-31595301,-16379226,-26744463,
+      8061304,-21894689,13286266,22215235,3803657,},
+     {29424039,8586988,-9890138,-11186776,18243921,
+      13861200,-7273703,-11459190,27795665,-456387,},},
+    {{-7732395,-13706275,16726248,8724371,26696068,
+      -8001865,26432727,6355639,18452607,-3415301,},
+     {16348413,15407103,26434529,922393,-31977439,
+      -5126385,-25115195,12723156,-32810447,8762143,},
+     {-11287260,5582566,22385190,15171356,-21276042,
+      14888517,-4861197,4649752,-23633483,-2047353,},},
+    {{20591186,-8850207,12099530,15970189,-19197648,
+      -186260,15162031,-14236512,15615916,-14831882,},
+     {12874396,-522271,-25229046,-15049972,29544824,
+      -12242216,-18892527,-6064228,-11495520,1435840,},
+     {-5883697,-1523973,8481848,-15283893,13098622,
+      10739616,24662579,9732710,-11443561,-13760620,},},
+    {{-17476539,-2435998,4940963,2818858,20136113,
+      9373176,-28305076,-1879298,21885346,11054990,},
+     {-15654011,-12477186,-21724784,-770304,-10882291,
+      -14624130,3504526,4974304,-19132436,3455048,},
+     {14766116,-14015471,-18708104,-15131308,30207321,
+      16112224,10666864,1321048,-28591445,-8678368,},},
+    {{25847139,10915184,-32334778,22349,-15033921,
+      13153109,-20745986,-15589058,-14367896,-501450,},
+     {-17134524,-3111974,-4588383,-574469,-29258611,
+      -1877624,-22125118,-10430909,-4475361,12674086,},
+     {18847597,3817901,1776882,-1305167,22399039,
+      13996727,-31225131,10340700,6512965,-4225977,},},
+    {{-2919083,-1657363,-25912343,-7562851,-8427741,
+      6835347,-1653146,-755637,-8140940,-4574651,},
+     {8752237,-796793,-19803107,-11126440,19179880,
+      -10232144,-32978970,1724603,-13067973,-694118,},
+     {-23156514,-10940433,-4932209,-14701010,28068614,
+      8040906,28527918,-13710660,-12358882,-4137873,},},
+    {{-25827,11185272,19489439,-16466781,-18847775,
+      -12961200,-19550425,3651647,6544959,1366395,},
+     {27695470,7585429,-29871802,-12054328,17271174,
+      16669592,29900143,-15423828,-22332661,-6518721,},
+     {-32724562,5407079,32935103,-4833085,16871672,
+      -6459221,11958553,7039703,-32706260,-3861323,},},
+    {{8318852,15726431,24620155,16368515,19239902,
+      -16612711,32638141,-15030417,-13419977,-213019,},
+     {22469521,4994434,-15598273,-15521578,-4789104,
+      10519085,1937400,5233943,-19451139,16167264,},
+     {14582723,12010301,-32114897,-4021355,17657864,
+      4255944,-18478294,11266915,23223463,14191630,},},
+    {{6344047,-13502512,-15338664,-7173364,16675520,
+      3646784,-32456601,2392311,22671849,13485714,},
+     {-28313401,5877349,-8712264,1309580,-15451457,
+      8982624,-9296609,6244000,2042230,2515080,},
+     {23346098,-7284454,4471924,-7553188,13726830,
+      -3029115,-3007895,-4904812,-11621694,-12909576,},},
+    {{-31819411,9838613,6765588,9338336,-172432,
+      -15969813,-3647860,-13981542,-19718180,10333554,},
+     {-18874743,8505649,30376261,-5944105,-11176329,
+      15767529,-10262837,-10199496,-1740954,-10269030,},
+     {19673223,-6902246,-1109130,8046483,26988608,
+      -15441841,21324189,-15879077,-12562978,15620930,},},
+    {{-1588888,2657524,15448537,-438181,-2922238,
+      1432303,33196503,13266637,-20190142,-3923130,},
+     {-29424661,-12627161,-15619487,9409320,-1156184,
+      -4577885,3566965,-9218334,-17569679,11170862,},
+     {-21879984,10118973,8067267,14166310,-30412210,
+      9473132,-24514475,207940,-31653719,-2010894,},},
+    {{173803,1647730,-17873170,13216448,-14933420,
+      13619554,-24140559,-687231,15985036,-151773,},
+     {536017,-10982227,-5890043,5050182,1887387,
+      -10438552,-32305748,-15136049,448981,12743270,},
+     {32299306,9182221,-27984620,6308285,-21981823,
+      -1293156,-22965419,370994,4000166,-5009661,},},
+  },
+  {
+    {{27187878,-9361641,13806711,-4162789,-5757233,
+      -3143788,-21806093,-13871845,-1546181,-12281353,},
+     {22505416,-3450885,14290458,-7120830,24755591,
+      4248735,-17802109,-7251749,4658617,-6417427,},
+     {-25994168,-12371936,6786865,14275916,-21532889,
+      -10563284,-16265517,6753068,-21702338,-4344439,},},
+    {{-14709556,-10930439,33435253,11876327,-26814894,
+      -1826301,32264554,12918666,24579122,15956419,},
+     {30629199,10076364,-9126731,3557125,917600,
+      11520297,-26182004,12661052,-7978840,-15760987,},
+     {-32683490,3481755,-14343467,-4387469,32506197,
+      -9684051,27206725,-5118598,18380589,-6699525,},},
+    {{16282217,-5271971,-10943240,15557327,-1739456,
+      -8125351,-5521929,-6355765,-32406076,5408682,},
+     {-8721688,6542173,-11785635,1137479,13406307,
+      15189028,1306482,2487762,-4857134,-12632558,},
+     {-24335203,4430808,7102816,-10935438,15087627,
+      -10223406,-23347810,15206698,-16263890,-3242921,},},
+    {{-9023861,1022195,7024055,4926798,7049476,
+      -5028387,-8931006,-2867570,-333813,13938362,},
+     {10402745,-3053502,7769185,-7795924,-19951324,
+      6368830,-30259016,16170148,-13936254,-13306014,},
+     {3835431,12932028,5996642,-2841426,-27919698,
+      -758138,-31306907,6869290,4548100,15592632,},},
+    {{5840289,-2756451,-10983025,552953,-32943215,
+      8069537,-16898943,9275861,-31371168,6676992,},
+     {15692292,4724963,9824570,-4825676,16431125,
+      -3843919,-13045475,-15198754,10104577,5186051,},
+     {6171822,1422177,3502345,-8361165,-19627537,
+      9597893,547168,-83692,20056043,-8621238,},},
+    {{13920374,-5944132,-27901588,9944823,1888381,
+      -15099795,-5418321,-9777360,7985891,-9805984,},
+     {8345952,10309054,-1548556,-12682789,-2570065,
+      -12409880,-25003777,6023632,30918414,9755746,},
+     {-22979972,1660827,-19774834,12620555,23324837,
+      3712476,-23854751,-13091100,-10041090,10763982,},},
+    {{-16592345,-16089531,17159529,-16655260,-30208351,
+      -16546560,14251996,4367187,-7322696,-15138171,},
+     {-24510979,-14515221,-21344157,11843284,17376966,
+      913593,10736653,-13268380,-12859651,77232,},
+     {-12847723,-2943097,26167932,9624984,-4320929,
+      8676250,-26480459,-2320930,28608488,12312142,},},
+    {{-16330180,-848138,11705134,-4004387,-1921884,
+      1838242,8096452,8547152,-24318417,9102025,},
+     {28571351,7023772,-3626768,-8571430,-15922501,
+      -12443822,6221966,-11862296,1621021,-5368168,},
+     {10108233,10754255,-2032185,-13020546,-9750,
+      3202985,25325193,-560508,8002528,-293234,},},
+    {{-14673672,-8626606,31517660,15628504,-15556811,
+      -2570794,7936558,4976739,-11108379,-8518619,},
+     {15527540,-3453275,3305995,13777705,-32566256,
+      -12241675,-15792608,6844059,-27687850,-11280870,},
+     {31510211,12539103,24933848,10635468,16699452,
+      5065284,30045693,7058626,3663140,16223223,},},
+    {{-11067131,15676662,-1050195,-3784009,-23575898,
+      -13654153,28090013,-1092956,-23436066,-9746214,},
+     {-27536707,-10652241,8823605,12954633,-19292427,
+      -7846676,-29742648,8116401,24589865,-5140294,},
+     {-9937394,-9682961,21588505,-14902702,-9914888,
+      -11565830,11063652,960592,-28443050,16158607,},},
+    {{-30395479,-10534596,-14478860,11425967,27522446,
+      -12174595,3500350,2822164,-28448840,-6129848,},
+     {-8804675,7486005,-2774154,-2359049,-6463282,
+      -3691516,11367344,2933748,15699012,-15693775,},
+     {3094277,-9762885,19773120,9284961,-9519992,
+      8672889,12487865,5514644,7233014,-4863315,},},
+    {{20243706,16751566,-3554294,8615187,11486323,
+      12707706,584424,11799398,32360505,15664784,},
+     {19922440,15087595,21060926,-142026,-12999057,
+      -3856137,-26128818,10807348,-6808878,564750,},
+     {-11615294,14202797,21902859,11455789,6158251,
+      -3289291,29439306,16673716,-13387589,-3600450,},},
+    {{5937648,-10346162,10350010,-1934397,-18167515,
+      12108327,3303652,-9848573,-16274747,-7083076,},
+     {-19033291,-1799676,15492961,7731684,-26387682,
+      -4612733,-436187,-8350529,-4798147,-9581718,},
+     {2255633,14287825,-8607860,-13031855,-29741821,
+      -15521343,-18342261,-4536573,16060354,6377250,},},
+    {{-1634881,-16560918,14155277,7082120,30677974,
+      11421307,-19880144,8718575,-12399644,-8358710,},
+     {14042364,2474277,-26516725,3887691,-9772477,
+      13849906,-15234233,-11267870,-3253192,-5843349,},
+     {21928915,11110586,-15047058,-14618155,-9390086,
+      7081657,12822300,10473690,-33355710,-9119172,},},
+    {{-1863734,-5702833,-26802658,7187228,23600120,
+      9545864,8000255,13565873,28466369,-12044218,},
+     {10882378,944280,14583853,11207151,-7238248,
+      3878496,-3169317,-13753585,-22675308,-5459101,},
+     {4595531,1500503,32510143,12272602,-17881274,
+      3715733,-30786005,-11840434,-30303376,8432279,},},
+    {{17863685,15230098,-15916638,486313,-26685056,
+      -16070351,21431164,-5248101,-33474456,4283579,},
+     {-19013986,-2901274,-15679996,-11185040,-32575898,
+      7658330,-11392083,9431378,-27489094,-5259875,},
+     {-32521759,9356161,-16189083,14830059,-25623,
+      -3356848,-16673937,12458779,-24635731,13942601,},},
+  },
 };
+#else
+#error "MONOCYPHER_COMB_TABLES must be 1, 3 or 17"
+#endif
 
 
 // p = [scalar]B, where B is the base point
@@ -2033,36 +4577,64 @@ static void ge_scalarmult_base(ge *p, const u8 scalar[32])
     ge dbl;   // temporary for doubling
     ge_precomp comb;
     ge_zero(p);
-    for (int i = 50; i >= 0; i--) {
-        if (i < 50) {
+    for (int i = COMB_SPACING - 1; i >= 0; i--) {
+        if (i < COMB_SPACING - 1) {
             ge_double(p, p, &dbl);
         }
-        fe_1(comb.Yp);
-        fe_1(comb.Ym);
-        fe_0(comb.T2);
-        u8 teeth = (u8)((scalar_bit(s_scalar, i)           ) +
-                        (scalar_bit(s_scalar, i +  51) << 1) +
-                        (scalar_bit(s_scalar, i + 102) << 2) +
-                        (scalar_bit(s_scalar, i + 153) << 3) +
-                        (scalar_bit(s_scalar, i + 204) << 4));
-        u8 high  = teeth >> 4;
-        u8 index = (teeth ^ (high - 1)) & 15;
-        FOR (j, 0, 16) {
-            i32 select = 1 & (((j ^ index) - 1) >> 8);
-            fe_ccopy(comb.Yp, b_comb[j].Yp, select);
-            fe_ccopy(comb.Ym, b_comb[j].Ym, select);
-            fe_ccopy(comb.T2, b_comb[j].T2, select);
+        FOR (k, 0, MONOCYPHER_COMB_TABLES) {
+            int b = i + (int)k * 5 * COMB_SPACING;
+            fe_1(comb.Yp);
+            fe_1(comb.Ym);
+            fe_0(comb.T2);
+            u8 teeth = (u8)((scalar_bit(s_scalar, b                   )     ) +
+                            (scalar_bit(s_scalar, b +     COMB_SPACING) << 1) +
+                            (scalar_bit(s_scalar, b + 2 * COMB_SPACING) << 2) +
+                            (scalar_bit(s_scalar, b + 3 * COMB_SPACING) << 3) +
+                            (scalar_bit(s_scalar, b + 4 * COMB_SPACING) << 4));
+            u8 high  = teeth >> 4;
+            u8 index = (teeth ^ (high - 1)) & 15;
+            FOR (j, 0, 16) {
+                i32 select = 1 & (((j ^ index) - 1) >> 8);
+                fe_ccopy(comb.Yp, b_comb[k][j].Yp, select);
+                fe_ccopy(comb.Ym, b_comb[k][j].Ym, select);
+                fe_ccopy(comb.T2, b_comb[k][j].T2, select);
+            }
+            fe_neg(n2, comb.T2);
+            fe_cswap(comb.T2, n2     , high);
+            fe_cswap(comb.Yp, comb.Ym, high);
+            ge_msub(p, p, &comb, a, n2); // reuse n2 as temporary
         }
-        fe_neg(n2, comb.T2);
-        fe_cswap(comb.T2, n2     , high);
-        fe_cswap(comb.Yp, comb.Ym, high);
-        ge_msub(p, p, &comb, a, n2); // reuse n2 as temporary
     }
     WIPE_CTX(&dbl); WIPE_CTX(&comb);
     WIPE_BUFFER(a); WIPE_BUFFER(n2);
     WIPE_BUFFER(s_scalar);
 }
 
+// Same as crypto_x25519(public_key, secret_key, 9), in Edwards space:
+// fixed base comb instead of a ladder.  The trimmed scalar is a
+// multiple of the cofactor, so [scalar]B has no low order component,
+// and u = (1 + y) / (1 - y) is the X25519 public key.
+// (extension, not part of upstream Monocypher)
+void crypto_x25519_public_key(u8       public_key[32],
+                              const u8 secret_key[32])
+{
+    u8 scalar[32];
+    ge pk;
+    fe t1, t2;
+    COPY(scalar, secret_key, 32);
+    trim_scalar(scalar);
+    ge_scalarmult_base(&pk, scalar);
+    fe_add(t1, pk.Z, pk.Y);
+    fe_sub(t2, pk.Z, pk.Y);
+    fe_invert(t2, t2);
+    fe_mul(t1, t1, t2);
+    fe_tobytes(public_key, t1);
+    WIPE_BUFFER(scalar);
+    WIPE_CTX(&pk);
+    WIPE_BUFFER(t1);
+    WIPE_BUFFER(t2);
+}
+
 void crypto_sign_public_key_custom_hash(u8       public_key[32],
                                         const u8 secret_key[32],
                                         const crypto_sign_vtable *hash)
@@ -200,6 +200,25 @@ void crypto_argon2i_general(uint8_t       *hash,      uint32_t hash_size,// >= 4
                             const uint8_t *key,       uint32_t key_size,
                             const uint8_t *ad,        uint32_t ad_size);
 
+// Argon2i with several lanes (extension, not part of upstream Monocypher)
+// Lanes of the same slice are independent: run() must call
+// fill(fill_ctx, lane) once for each lane < nb_lanes, possibly in
+// parallel, and return when they are all done.  run may be NULL, in
+// which case the lanes are computed one after the other.
+typedef void crypto_argon2_fill(void *fill_ctx, uint32_t lane);
+typedef void crypto_argon2_run (void *run_ctx, crypto_argon2_fill *fill,
+                                void *fill_ctx, uint32_t nb_lanes);
+
+void crypto_argon2i_lanes(uint8_t       *hash,      uint32_t hash_size,// >= 4
+                          void          *work_area, uint32_t nb_blocks,// >= 8 * nb_lanes
+                          uint32_t       nb_iterations,                // >= 1
+                          uint32_t       nb_lanes,                     // >= 1
+                          const uint8_t *password,  uint32_t password_size,
+                          const uint8_t *salt,      uint32_t salt_size,// >= 8
+                          const uint8_t *key,       uint32_t key_size,
+                          const uint8_t *ad,        uint32_t ad_size,
+                          crypto_argon2_run *run,   void *run_ctx);
+
 
 // Key exchange (x25519 + HChacha20)
 // ---------------------------------
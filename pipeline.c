@@ -0,0 +1,456 @@
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "pipeline.h"
+#include "stats.h"
+#include "utils.h"
+#include "monocypher/monocypher.h"
+
+enum {
+    SLOT_FREE,
+    SLOT_READY,
+    SLOT_BUSY,
+    SLOT_DONE,
+};
+
+struct pipeline {
+    pl_fn            process,
+                     consume;
+    pl_flush_fn      flush;
+    void            *arg;
+
+    struct pl_slot  *slots;
+    int             *state;
+    size_t           nslots,
+                     in_cap,
+                     out_cap;
+    struct pl_arena *arena;
+
+    pthread_t       *workers;
+    size_t           nworkers;
+    pthread_t        writer;
+    int              has_writer;
+
+    pthread_mutex_t  lock;
+    pthread_cond_t   cond;
+    uint64_t         submitted, // slots handed to the pipeline
+                     claimed,   // slots picked up by a worker
+                     consumed;  // slots given back by the writer
+    int              closed,
+                     failed;
+};
+
+static void *pl_worker(void *arg)
+{
+    struct pipeline *pl = arg;
+    pthread_mutex_lock(&pl->lock);
+    for (;;) {
+        while (!pl->failed && !pl->closed && pl->claimed == pl->submitted)
+            pthread_cond_wait(&pl->cond, &pl->lock);
+        if (pl->failed || pl->claimed == pl->submitted)
+            break;
+
+        size_t i = pl->claimed++ % pl->nslots;
+        pl->state[i] = SLOT_BUSY;
+        pthread_mutex_unlock(&pl->lock);
+
+        int err = pl->process(pl->arg, &pl->slots[i]);
+
+        pthread_mutex_lock(&pl->lock);
+        if (err)
+            pl->failed = 1;
+        pl->state[i] = SLOT_DONE;
+        pthread_cond_broadcast(&pl->cond);
+    }
+    pthread_mutex_unlock(&pl->lock);
+    return NULL;
+}
+
+static void *pl_writer(void *arg)
+{
+    struct pipeline *pl = arg;
+    pthread_mutex_lock(&pl->lock);
+    for (;;) {
+        size_t i = pl->consumed % pl->nslots;
+        while (!pl->failed && pl->state[i] != SLOT_DONE
+                && !(pl->closed && pl->consumed == pl->submitted))
+            pthread_cond_wait(&pl->cond, &pl->lock);
+        if (pl->failed || pl->state[i] != SLOT_DONE)
+            break;
+
+        // every slot done so far, in order
+        size_t count = 1;
+        while (pl->consumed + count < pl->submitted
+                && pl->state[(i + count) % pl->nslots] == SLOT_DONE)
+            count++;
+        pthread_mutex_unlock(&pl->lock);
+
+        int err = 0;
+        for (size_t k = 0; k < count && !err; k++)
+            err = pl->consume(pl->arg, &pl->slots[(i + k) % pl->nslots]);
+        if (!err && pl->flush != NULL)
+            err = pl->flush(pl->arg);
+
+        pthread_mutex_lock(&pl->lock);
+        if (err)
+            pl->failed = 1;
+        for (size_t k = 0; k < count; k++)
+            pl->state[(i + k) % pl->nslots] = SLOT_FREE;
+        pl->consumed += count;
+        pthread_cond_broadcast(&pl->cond);
+    }
+    pthread_mutex_unlock(&pl->lock);
+    return NULL;
+}
+
+static uint8_t *buf_new(struct pipeline *pl, size_t cap)
+{
+    if (pl->arena != NULL)
+        return pl_arena_get(pl->arena);
+    uint8_t *buf = malloc(cap);
+    if (buf != NULL)
+        st_buffers((int64_t) cap);
+    return buf;
+}
+
+static void buf_free(struct pipeline *pl, uint8_t *buf, size_t cap)
+{
+    if (buf == NULL)
+        return;
+    if (pl->arena != NULL) {
+        pl_arena_put(pl->arena, buf);
+    } else {
+        st_buffers(-(int64_t) cap);
+        _free(buf, cap);
+    }
+}
+
+// Buffers the slots own: in place, out points into in
+static uint8_t *slot_out(const struct pipeline *pl, size_t i)
+{
+    return pl->out_cap > 0 ? pl->slots[i].out : NULL;
+}
+
+static void pl_free(struct pipeline *pl)
+{
+    if (pl->slots != NULL) {
+        for (size_t i = 0; i < pl->nslots; i++) {
+            buf_free(pl, pl->slots[i].in, pl->in_cap);
+            buf_free(pl, slot_out(pl, i), pl->out_cap);
+        }
+        free(pl->slots);
+    }
+    free(pl->state);
+    free(pl->workers);
+    pthread_mutex_destroy(&pl->lock);
+    pthread_cond_destroy(&pl->cond);
+    free(pl);
+}
+
+struct pipeline *pl_new(size_t nworkers,
+                        size_t in_cap, size_t out_cap,
+                        struct pl_arena *arena,
+                        pl_fn process, pl_fn consume, pl_flush_fn flush,
+                        void *arg)
+{
+    if (arena != NULL && (in_cap  > pl_arena_buf_size(arena)
+                       || out_cap > pl_arena_buf_size(arena)))
+        return NULL;
+    struct pipeline *pl = calloc(1, sizeof(*pl));
+    if (pl == NULL)
+        return NULL;
+
+    pl->process = process;
+    pl->consume = consume;
+    pl->flush   = flush;
+    pl->arg     = arg;
+    pl->in_cap  = in_cap;
+    pl->out_cap = out_cap;
+    pl->arena   = arena;
+    pl->nslots  = nworkers <= 1 ? 1 : 2 * nworkers + 2;
+    pthread_mutex_init(&pl->lock, NULL);
+    pthread_cond_init(&pl->cond, NULL);
+
+    pl->slots = calloc(pl->nslots, sizeof(*pl->slots));
+    pl->state = calloc(pl->nslots, sizeof(*pl->state));
+    if (pl->slots == NULL || pl->state == NULL)
+        goto error;
+    for (size_t i = 0; i < pl->nslots; i++) {
+        pl->slots[i].in = buf_new(pl, in_cap);
+        if (pl->slots[i].in == NULL)
+            goto error;
+        if (out_cap > 0) {
+            pl->slots[i].out = buf_new(pl, out_cap);
+            if (pl->slots[i].out == NULL)
+                goto error;
+        }
+    }
+
+    if (nworkers <= 1)
+        return pl;
+
+    pl->workers = calloc(nworkers, sizeof(*pl->workers));
+    if (pl->workers == NULL)
+        goto error;
+    for (; pl->nworkers < nworkers; pl->nworkers++)
+        if (pthread_create(&pl->workers[pl->nworkers], NULL, pl_worker, pl) != 0)
+            goto error_threads;
+    if (pthread_create(&pl->writer, NULL, pl_writer, pl) != 0)
+        goto error_threads;
+    pl->has_writer = 1;
+    return pl;
+
+error_threads:
+    pl->failed = 1;
+    pl_finish(pl);
+    return NULL;
+
+error:
+    pl_free(pl);
+    return NULL;
+}
+
+struct pl_slot *pl_acquire(struct pipeline *pl)
+{
+    struct pl_slot *slot = NULL;
+    pthread_mutex_lock(&pl->lock);
+    size_t i = pl->submitted % pl->nslots;
+    while (!pl->failed && pl->state[i] != SLOT_FREE)
+        pthread_cond_wait(&pl->cond, &pl->lock);
+    if (!pl->failed)
+        slot = &pl->slots[i];
+    pthread_mutex_unlock(&pl->lock);
+    return slot;
+}
+
+int pl_submit(struct pipeline *pl, struct pl_slot *slot)
+{
+    // inline mode
+    if (pl->workers == NULL) {
+        if (pl->failed
+                || pl->process(pl->arg, slot) != 0
+                || pl->consume(pl->arg, slot) != 0
+                || (pl->flush != NULL && pl->flush(pl->arg) != 0)) {
+            pl->failed = 1;
+            return -1;
+        }
+        pl->submitted++;
+        pl->consumed++;
+        return 0;
+    }
+
+    pthread_mutex_lock(&pl->lock);
+    int rv = pl->failed ? -1 : 0;
+    if (rv == 0) {
+        pl->state[slot - pl->slots] = SLOT_READY;
+        pl->submitted++;
+        pthread_cond_broadcast(&pl->cond);
+    }
+    pthread_mutex_unlock(&pl->lock);
+    return rv;
+}
+
+int pl_finish(struct pipeline *pl)
+{
+    pthread_mutex_lock(&pl->lock);
+    pl->closed = 1;
+    pthread_cond_broadcast(&pl->cond);
+    pthread_mutex_unlock(&pl->lock);
+
+    for (size_t i = 0; i < pl->nworkers; i++)
+        pthread_join(pl->workers[i], NULL);
+    if (pl->has_writer)
+        pthread_join(pl->writer, NULL);
+
+    int rv = pl->failed ? -1 : 0;
+    pl_free(pl);
+    return rv;
+}
+
+
+//
+// Arena
+//
+#define ARENA_SLAB  (1 << 16) // bytes mapped at a time, at least one buffer
+#define ARENA_ALIGN 64
+
+struct pl_slab {
+    struct pl_slab *next;
+    void           *base;
+    size_t          size;
+};
+
+struct pl_arena {
+    size_t           buf_size,
+                     per_slab;
+    pthread_mutex_t  lock;
+    uint8_t         *free;   // free buffers, linked through their first bytes
+    struct pl_slab  *slabs;
+};
+
+struct pl_arena *pl_arena_new(size_t buf_size)
+{
+    struct pl_arena *ar = calloc(1, sizeof(*ar));
+    if (ar == NULL)
+        return NULL;
+    if (buf_size < sizeof(uint8_t *))
+        buf_size = sizeof(uint8_t *);
+    ar->buf_size = (buf_size + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+    ar->per_slab = ar->buf_size < ARENA_SLAB ? ARENA_SLAB / ar->buf_size : 1;
+    pthread_mutex_init(&ar->lock, NULL);
+    return ar;
+}
+
+size_t pl_arena_buf_size(const struct pl_arena *ar)
+{
+    return ar->buf_size;
+}
+
+// Maps one more slab and adds its buffers to the free list
+static int arena_grow(struct pl_arena *ar)
+{
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0)
+        page = 4096;
+    size_t size = (ar->per_slab * ar->buf_size + (size_t) page - 1)
+                & ~(size_t) (page - 1);
+
+    struct pl_slab *slab = malloc(sizeof(*slab));
+    if (slab == NULL)
+        return -1;
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        free(slab);
+        return -1;
+    }
+    // best effort: past RLIMIT_MEMLOCK the buffers are only unlocked
+    int saved_errno = errno;
+#ifdef MADV_DONTDUMP
+    madvise(base, size, MADV_DONTDUMP);
+#endif
+    mlock(base, size);
+    errno = saved_errno;
+
+    slab->base = base;
+    slab->size = size;
+    slab->next = ar->slabs;
+    ar->slabs  = slab;
+    st_buffers((int64_t) size);
+
+    for (size_t i = ar->per_slab; i-- > 0;) {
+        uint8_t *buf = (uint8_t *) base + i * ar->buf_size;
+        memcpy(buf, &ar->free, sizeof(ar->free));
+        ar->free = buf;
+    }
+    return 0;
+}
+
+uint8_t *pl_arena_get(struct pl_arena *ar)
+{
+    uint8_t *buf = NULL;
+    pthread_mutex_lock(&ar->lock);
+    if (ar->free != NULL || arena_grow(ar) == 0) {
+        buf = ar->free;
+        memcpy(&ar->free, buf, sizeof(ar->free));
+        crypto_wipe(buf, sizeof(ar->free));
+    }
+    pthread_mutex_unlock(&ar->lock);
+    return buf;
+}
+
+void pl_arena_put(struct pl_arena *ar, uint8_t *buf)
+{
+    if (buf == NULL)
+        return;
+    crypto_wipe(buf, ar->buf_size);
+    pthread_mutex_lock(&ar->lock);
+    memcpy(buf, &ar->free, sizeof(ar->free));
+    ar->free = buf;
+    pthread_mutex_unlock(&ar->lock);
+}
+
+void pl_arena_free(struct pl_arena *ar)
+{
+    if (ar == NULL)
+        return;
+    while (ar->slabs != NULL) {
+        struct pl_slab *slab = ar->slabs;
+        ar->slabs = slab->next;
+        munmap(slab->base, slab->size);
+        st_buffers(-(int64_t) slab->size);
+        free(slab);
+    }
+    pthread_mutex_destroy(&ar->lock);
+    free(ar);
+}
+
+
+struct pl_for_ctx {
+    pthread_mutex_t lock;
+    size_t          next,
+                    ntasks;
+    pl_task_fn      fn;
+    void           *arg;
+    int             failed;
+};
+
+static void *pl_for_worker(void *arg)
+{
+    struct pl_for_ctx *ctx = arg;
+    for (;;) {
+        pthread_mutex_lock(&ctx->lock);
+        size_t i = ctx->next++;
+        int stop = ctx->failed || i >= ctx->ntasks;
+        pthread_mutex_unlock(&ctx->lock);
+        if (stop)
+            break;
+        if (ctx->fn(ctx->arg, i) != 0) {
+            pthread_mutex_lock(&ctx->lock);
+            ctx->failed = 1;
+            pthread_mutex_unlock(&ctx->lock);
+        }
+    }
+    return NULL;
+}
+
+int pl_for(size_t nworkers, size_t ntasks, pl_task_fn fn, void *arg)
+{
+    if (nworkers > ntasks)
+        nworkers = ntasks;
+    if (nworkers <= 1) {
+        for (size_t i = 0; i < ntasks; i++)
+            if (fn(arg, i) != 0)
+                return -1;
+        return 0;
+    }
+
+    pthread_t *threads = calloc(nworkers, sizeof(*threads));
+    if (threads == NULL)
+        return -1;
+
+    struct pl_for_ctx ctx = {
+        .next   = 0,
+        .ntasks = ntasks,
+        .fn     = fn,
+        .arg    = arg,
+        .failed = 0,
+    };
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    // the calling thread works too
+    size_t started = 0;
+    for (; started < nworkers - 1; started++)
+        if (pthread_create(&threads[started], NULL, pl_for_worker, &ctx) != 0)
+            break;
+    pl_for_worker(&ctx);
+    for (size_t i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+
+    pthread_mutex_destroy(&ctx.lock);
+    free(threads);
+    return ctx.failed ? -1 : 0;
+}
@@ -0,0 +1,61 @@
+#ifndef KURV_PIPELINE
+#define KURV_PIPELINE
+
+#include <stddef.h>
+#include <stdint.h>
+
+// An ordered chunk pipeline: the caller fills slots in order,
+// `process` runs on a pool of workers, and `consume` is called
+// on a single writer thread in the order the slots were submitted.
+// The writer takes every slot that is ready at once, and calls
+// `flush` (if not NULL) after consuming them, before the slots are
+// reused: consume may keep pointers into a slot until then.
+// With nworkers <= 1 everything runs inline on the caller's thread.
+// If in_cap == out_cap, process may swap the in and out buffers.
+// With out_cap == 0 slots have no out buffer: process works in place
+// and points out into in.  Buffers come from arena if not NULL.
+
+struct pl_slot {
+    uint8_t  *in;
+    size_t    in_size;
+    uint8_t  *out;
+    size_t    out_size;
+    uint64_t  index;
+    uint8_t   nonce[24];
+    uint8_t   digest[64]; // of the chunk, for LS_DIGEST_TREE
+};
+
+// Return 0 on success, anything else aborts the pipeline.
+typedef int (*pl_fn)(void *arg, struct pl_slot *slot);
+typedef int (*pl_flush_fn)(void *arg);
+
+struct pipeline;
+struct pl_arena;
+
+struct pipeline *pl_new(size_t nworkers,
+                        size_t in_cap, size_t out_cap,
+                        struct pl_arena *arena,
+                        pl_fn process, pl_fn consume, pl_flush_fn flush,
+                        void *arg);
+// Next free slot, or NULL if the pipeline has failed.
+struct pl_slot *pl_acquire(struct pipeline *pl);
+int pl_submit(struct pipeline *pl, struct pl_slot *slot);
+// Wait for all submitted slots to be consumed, then free the pipeline.
+int pl_finish(struct pipeline *pl);
+
+// A pool of chunk buffers of one size, shared by the pipelines of a
+// run.  They are mapped in slabs, locked in memory when RLIMIT_MEMLOCK
+// allows and left out of core dumps, wiped when put back, and handed
+// out again for the next chunks and messages.  Thread safe.
+struct pl_arena *pl_arena_new(size_t buf_size);
+// A buffer of at least buf_size bytes, or NULL if out of memory.
+uint8_t *pl_arena_get(struct pl_arena *ar);
+void     pl_arena_put(struct pl_arena *ar, uint8_t *buf);
+size_t   pl_arena_buf_size(const struct pl_arena *ar);
+// Every buffer must have been put back.
+void     pl_arena_free(struct pl_arena *ar);
+
+// Run fn(arg, i) for every i < ntasks on up to nworkers threads.
+typedef int (*pl_task_fn)(void *arg, size_t i);
+int pl_for(size_t nworkers, size_t ntasks, pl_task_fn fn, void *arg);
+#endif
@@ -0,0 +1,132 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "stats.h"
+
+int      st_enabled;
+uint64_t st_counters[ST_COUNTERS];
+
+static uint64_t        st_wall[ST_PHASES];
+static uint64_t        st_cpu [ST_PHASES];
+static struct timespec st_begin;
+
+static const char *const PHASE_NAMES[ST_PHASES] = {
+    "pdkf", "kx", "stream", "hash", "io",
+};
+
+static const char *const COUNTER_NAMES[ST_COUNTERS] = {
+    "bytes_in", "bytes_out", "reads", "writes", "chunks", "payload",
+    "slots", "keys", "buffers", "buffers_peak",
+};
+
+// IO is timed around every small stdio call: it only gets the cheap
+// clock, and its CPU time is reported as null.
+static int has_cpu(enum st_phase phase)
+{
+    return phase != ST_IO;
+}
+
+static clockid_t cpu_clock(enum st_phase phase)
+{
+    return phase == ST_HASH
+        ? CLOCK_THREAD_CPUTIME_ID
+        : CLOCK_PROCESS_CPUTIME_ID;
+}
+
+static uint64_t elapsed_ns(const struct timespec *from, const struct timespec *to)
+{
+    return (uint64_t) (to->tv_sec - from->tv_sec) * 1000000000u
+         + (uint64_t) to->tv_nsec - (uint64_t) from->tv_nsec;
+}
+
+void st_enable(void)
+{
+    if (!st_enabled)
+        clock_gettime(CLOCK_MONOTONIC, &st_begin);
+    st_enabled = 1;
+}
+
+void st_enable_from_env(void)
+{
+    const char *env = getenv("ICHI_STATS");
+    if (env != NULL && env[0] != '\0' && strcmp(env, "0") != 0)
+        st_enable();
+}
+
+void st_start(enum st_phase phase, struct st_timer *t)
+{
+    if (!st_enabled)
+        return;
+    clock_gettime(CLOCK_MONOTONIC, &t->wall);
+    if (has_cpu(phase))
+        clock_gettime(cpu_clock(phase), &t->cpu);
+}
+
+void st_stop(enum st_phase phase, const struct st_timer *t)
+{
+    struct timespec wall, cpu;
+    if (!st_enabled)
+        return;
+    clock_gettime(CLOCK_MONOTONIC, &wall);
+    __atomic_fetch_add(&st_wall[phase], elapsed_ns(&t->wall, &wall), __ATOMIC_RELAXED);
+    if (!has_cpu(phase))
+        return;
+    clock_gettime(cpu_clock(phase), &cpu);
+    __atomic_fetch_add(&st_cpu [phase], elapsed_ns(&t->cpu,  &cpu),  __ATOMIC_RELAXED);
+}
+
+uint64_t st_wall_ns(enum st_phase phase)
+{
+    return __atomic_load_n(&st_wall[phase], __ATOMIC_RELAXED);
+}
+
+uint64_t st_cpu_ns(enum st_phase phase)
+{
+    return __atomic_load_n(&st_cpu[phase], __ATOMIC_RELAXED);
+}
+
+void st_buffers(int64_t size)
+{
+    if (!st_enabled)
+        return;
+    uint64_t now = __atomic_add_fetch(&st_counters[ST_BUFFERS], (uint64_t) size,
+                                      __ATOMIC_RELAXED);
+    uint64_t peak = __atomic_load_n(&st_counters[ST_BUFFERS_PEAK], __ATOMIC_RELAXED);
+    while (now > peak
+           && !__atomic_compare_exchange_n(&st_counters[ST_BUFFERS_PEAK], &peak, now,
+                                           1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+void st_report(FILE *fp, const char *name)
+{
+    struct timespec now, cpu;
+    struct rusage ru;
+    if (!st_enabled)
+        return;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    long rss = getrusage(RUSAGE_SELF, &ru) == 0 ? ru.ru_maxrss : -1;
+
+    fprintf(fp, "{\"stats\": \"%s\", \"wall_ns\": %llu, \"cpu_ns\": %llu, "
+                "\"peak_rss_kb\": %ld, \"phases\": {",
+            name,
+            (unsigned long long) elapsed_ns(&st_begin, &now),
+            (unsigned long long) cpu.tv_sec * 1000000000u + (unsigned long long) cpu.tv_nsec,
+            rss);
+    for (int i = 0; i < ST_PHASES; i++) {
+        fprintf(fp, "%s\"%s\": {\"wall_ns\": %llu, \"cpu_ns\": ",
+                i ? ", " : "", PHASE_NAMES[i],
+                (unsigned long long) st_wall_ns(i));
+        if (has_cpu(i))
+            fprintf(fp, "%llu}", (unsigned long long) st_cpu_ns(i));
+        else
+            fprintf(fp, "null}");
+    }
+    fprintf(fp, "}");
+    for (int i = 0; i < ST_COUNTERS; i++)
+        fprintf(fp, ", \"%s\": %llu", COUNTER_NAMES[i],
+                (unsigned long long) __atomic_load_n(&st_counters[i], __ATOMIC_RELAXED));
+    fprintf(fp, "}\n");
+}
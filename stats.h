@@ -0,0 +1,73 @@
+#ifndef KURV_STATS
+#define KURV_STATS
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+// Run statistics for --stats (or $ICHI_STATS): wall and CPU time per
+// phase, and counters.  Nothing is collected until st_enable(); after
+// that every update is an atomic add, so the hooks in lock_stream.c,
+// utils.c and pipeline.c can run on any thread.  libichi users read
+// st_counters[] or call st_report() the same way.
+//
+// PDKF, KX and STREAM are timed around whole steps, with the CPU time
+// of the process.  HASH and IO are timed per call, HASH with the CPU
+// time of the calling thread and IO with wall time only: with several
+// jobs they add up the time of every thread, and both overlap STREAM.
+enum st_phase {
+    ST_PDKF,    // Argon2i (ls_pdkf_key)
+    ST_KX,      // key exchanges and trying recepient slots
+    ST_STREAM,  // the chunk loop
+    ST_HASH,    // BLAKE2b of messages and files
+    ST_IO,      // blocked in reads and writes
+    ST_PHASES,
+};
+
+enum st_counter {
+    ST_BYTES_IN,     // bytes read
+    ST_BYTES_OUT,    // bytes written
+    ST_READS,        // reads: stdio calls, or read(2) on unmapped input
+    ST_WRITES,       // writes: stdio calls, or writev(2)
+    ST_CHUNKS,       // lock stream chunks locked or unlocked
+    ST_PAYLOAD,      // bytes in them, as locked (compressed for Z)
+    ST_SLOTS,        // recepient slots tried (ls_kx_unwrap)
+    ST_KEYS,         // keys scanned for a signature
+    ST_BUFFERS,      // bytes of chunk and input buffers held now...
+    ST_BUFFERS_PEAK, // ...and at most
+    ST_COUNTERS,
+};
+
+struct st_timer {
+    struct timespec wall;
+    struct timespec cpu;
+};
+
+extern int      st_enabled;
+extern uint64_t st_counters[ST_COUNTERS];
+
+void st_enable(void);
+// Turns stats on if $ICHI_STATS is set to anything but "" or "0"
+void st_enable_from_env(void);
+
+void st_start(enum st_phase phase, struct st_timer *t);
+void st_stop (enum st_phase phase, const struct st_timer *t);
+// Time spent in phase so far, in nanoseconds
+uint64_t st_wall_ns(enum st_phase phase);
+uint64_t st_cpu_ns (enum st_phase phase);
+
+static inline void st_add(enum st_counter c, uint64_t n)
+{
+    if (st_enabled)
+        __atomic_fetch_add(&st_counters[c], n, __ATOMIC_RELAXED);
+}
+
+// Buffers of size bytes allocated (size > 0) or freed (size < 0)
+void st_buffers(int64_t size);
+
+// One JSON object on fp, for the run of the tool called name:
+//   {"stats": NAME, "wall_ns": T, "cpu_ns": T, "peak_rss_kb": M,
+//    "phases": {PHASE: {"wall_ns": T, "cpu_ns": T}, ...},
+//    COUNTER: N, ...}
+void st_report(FILE *fp, const char *name);
+#endif
@@ -55,3 +55,350 @@ setup() {
     run ichi-lock -D -p <(echo abc) -o test/dec test/enc
     [ "$status" != 0 ]
 }
+
+@test 'password lanes' {
+    for lanes in 1 3 16; do
+        ichi-lock -E -l "$lanes" -p <(echo 123) -o test/enc README.md
+        ichi-lock -D -p <(echo 123) -o test/dec test/enc
+        [ "$(cat test/dec)" = "$(cat README.md)" ]
+    done
+
+    run ichi-lock -E -l 0 -p <(echo 123) README.md
+    [ "$status" != 0 ]
+    run ichi-lock -E -l 17 -p <(echo 123) README.md
+    [ "$status" != 0 ]
+}
+
+@test 'parallel encryption + decryption' {
+    ichi-keygen -L -b test/a
+    head -c 1000000 /dev/urandom > test/plain
+
+    for jobs in 1 4; do
+        ichi-lock -E -j "$jobs" -r test/a.lock.pub -o test/enc test/plain
+        ichi-lock -D -j "$jobs" -k test/a.lock.key -o test/dec test/enc
+        cmp test/dec test/plain
+    done
+
+    # truncated streams are rejected
+    head -c 500000 test/enc > test/trunc
+    run ichi-lock -D -j 4 -k test/a.lock.key -o test/dec test/trunc
+    [ "$status" != 0 ]
+
+    run ichi-lock -E -j 0 -r test/a.lock.pub test/plain
+    [ "$status" != 0 ]
+}
+
+@test 'chunk size' {
+    ichi-keygen -L -b test/a
+    head -c 300000 /dev/urandom > test/plain
+
+    for shift in 8 15 20; do
+        ichi-lock -E -c "$shift" -r test/a.lock.pub -o test/enc test/plain
+        ichi-lock -D -k test/a.lock.key -o test/dec test/enc
+        cmp test/dec test/plain
+    done
+
+    run ichi-lock -E -c 30 -r test/a.lock.pub test/plain
+    [ "$status" != 0 ]
+}
+
+@test 'fast stream' {
+    ichi-keygen -L -b test/a
+    head -c 300000 /dev/urandom > test/plain
+
+    for jobs in 1 4; do
+        ichi-lock -E -f -j "$jobs" -r test/a.lock.pub -o test/enc test/plain
+        ichi-lock -D -j "$jobs" -k test/a.lock.key -o test/dec test/enc
+        cmp test/dec test/plain
+    done
+
+    ichi-lock -E -f -p <(echo 123) -o test/enc test/plain
+    ichi-lock -D -p <(echo 123) -o test/dec test/enc
+    cmp test/dec test/plain
+}
+
+@test 'tagged recepients' {
+    ichi-keygen -L -b test/x
+    ichi-keygen -L -b test/a
+    ichi-keygen -L -b test/b
+    ichi-keygen -L -b test/c
+
+    ichi-lock -E -t -r test/a.lock.pub \
+                    -r test/b.lock.pub \
+                    -k test/x.lock.key \
+                    -o test/enc \
+                    README.md
+
+    for key in a b; do
+        ichi-lock -D -v test/x.lock.pub \
+                     -k "test/${key}.lock.key" \
+                     -o test/out \
+                     test/enc
+        [ "$(cat test/out)" = "$(cat README.md)" ]
+    done
+
+    run ichi-lock -D -k test/c.lock.key test/enc
+    [ "$status" != 0 ]
+}
+
+@test 'many recepients' {
+    args=()
+    for i in $(seq 1 20); do
+        ichi-keygen -L -b "test/r$i"
+        args+=(-r "test/r$i.lock.pub")
+    done
+
+    ichi-lock -E -j 4 "${args[@]}" -o test/enc README.md
+    for i in 1 20; do
+        ichi-lock -D -k "test/r$i.lock.key" -o test/dec test/enc
+        [ "$(cat test/dec)" = "$(cat README.md)" ]
+    done
+}
+
+@test 'range decryption' {
+    ichi-keygen -L -b test/a
+    head -c 300000 /dev/urandom > test/plain
+
+    for flags in "" "-f" "-c 8"; do
+        ichi-lock -E $flags -r test/a.lock.pub -o test/enc test/plain
+        for range in 0:100 32760:20 65536:32768 299990:100 400000:5 0:300000; do
+            offset="${range%:*}"
+            length="${range#*:}"
+            ichi-lock -D -k test/a.lock.key --range "$range" -o test/dec test/enc
+            tail -c +"$((offset + 1))" test/plain | head -c "$length" | cmp - test/dec
+        done
+    done
+
+    # the end of the stream is still checked
+    head -c -1 test/enc > test/bad
+    run ichi-lock -D -k test/a.lock.key --range 0:10 test/bad
+    [ "$status" != 0 ]
+
+    # needs a seekable input
+    run sh -c 'cat test/enc | ichi-lock -D -k test/a.lock.key --range 0:10'
+    [ "$status" != 0 ]
+}
+
+@test 'library' {
+    ichi-keygen -L -b test/x
+    ichi-keygen -L -b test/a
+    # several MB: update output was once sized for empty contexts only
+    head -c 3000000 /dev/urandom > test/plain
+
+    for flags in "" "-f" "-t"; do
+        # one context, several messages, both ways
+        libichi_test -E $flags -r test/a.lock.pub test/e1 test/e2 < test/plain
+        libichi_test -E $flags -k test/x.lock.key -r test/a.lock.pub test/e3 < test/plain
+        for enc in test/e1 test/e2; do
+            ichi-lock -D -k test/a.lock.key -o test/dec "$enc"
+            cmp test/dec test/plain
+        done
+        ichi-lock -D -v test/x.lock.pub -k test/a.lock.key -o test/dec test/e3
+        cmp test/dec test/plain
+
+        ichi-lock -E $flags -k test/x.lock.key -r test/a.lock.pub -o test/e4 test/plain
+        libichi_test -D -v test/x.lock.pub -k test/a.lock.key test/e3 test/e4 > test/dec
+        cat test/plain test/plain | cmp - test/dec
+    done
+
+    run libichi_test -D -v test/x.lock.pub -k test/a.lock.key test/e1
+    [ "$status" != 0 ]
+    head -c -1 test/e1 > test/bad
+    run libichi_test -D -k test/a.lock.key test/bad
+    [ "$status" != 0 ]
+}
+
+@test 'batch encryption' {
+    ichi-keygen -L -b test/x
+    ichi-keygen -L -b test/a
+    mkdir -p test/src/sub
+    for i in 1 2 3; do
+        head -c "$((i * 40000))" /dev/urandom > "test/src/f$i"
+    done
+    cp README.md test/src/sub/readme
+
+    ichi-lock -E -j 2 -r test/a.lock.pub -O test/out test/src/f1 test/src/f2
+    ichi-lock -E -j 2 -k test/x.lock.key -r test/a.lock.pub -O test/dir \
+        --list <(find test/src -type f)
+    for f in test/src/f1 test/src/f2; do
+        ichi-lock -D -k test/a.lock.key -o test/dec "test/out/$f"
+        cmp test/dec "$f"
+    done
+    for f in $(find test/src -type f); do
+        ichi-lock -D -v test/x.lock.pub -k test/a.lock.key -o test/dec "test/dir/$f"
+        cmp test/dec "$f"
+    done
+
+    ichi-lock -E -p <(echo 123) -O test/pw test/src/f1 test/src/f3
+    ichi-lock -D -p <(echo 123) -o test/dec test/pw/test/src/f3
+    cmp test/dec test/src/f3
+
+    run ichi-lock -E -r test/a.lock.pub -O test/out ../escape
+    [ "$status" != 0 ]
+    run ichi-lock -E -r test/a.lock.pub -O test/out test/src/missing
+    [ "$status" != 0 ]
+    [ ! -e test/out/test/src/missing ]
+}
+
+@test 'agent' {
+    ichi-keygen -L -b test/a
+    ichi-keygen -L -b test/x
+    ichi-keygen -S -b test/s
+    head -c 300000 /dev/urandom > test/plain
+
+    ichi-agent -k test/a.lock.key -r test/a.lock.pub -r test/x.lock.pub \
+               -s test/s.sign.key -p test/s.sign.pub test/sock 3>&- &
+    agent=$!
+    for i in $(seq 50); do [ -S test/sock ] && break; sleep 0.1; done
+
+    ichi-lock -E -A test/sock -o test/enc test/plain
+    ichi-lock -D -k test/x.lock.key -o test/dec test/enc
+    cmp test/dec test/plain
+    cat test/enc | ichi-lock -D -A test/sock > test/dec
+    cmp test/dec test/plain
+
+    ichi-sign -A test/sock -o test/signed test/plain
+    ichi-sign -V -p test/s.sign.pub test/signed
+    ichi-sign -A test/sock -d -o test/sig test/plain
+    ichi-sign -V -A test/sock -s test/sig test/plain
+
+    head -c -1 test/enc > test/bad
+    run ichi-lock -D -A test/sock test/bad
+    [ "$status" != 0 ]
+    run ichi-sign -V -A test/sock -s test/sig README.md
+    [ "$status" != 0 ]
+
+    # only a socket is replaced
+    echo keep > test/file
+    run ichi-agent -k test/a.lock.key test/file
+    [ "$status" != 0 ]
+    [ "$(cat test/file)" = keep ]
+
+    # streams come from a new key unless -S
+    run ichi-lock -D -v test/a.lock.pub -k test/x.lock.key test/enc
+    [ "$status" != 0 ]
+
+    kill "$agent"
+    wait "$agent" || true
+    [ ! -e test/sock ]
+
+    ichi-agent -k test/a.lock.key -r test/x.lock.pub -S test/sock 3>&- &
+    agent=$!
+    for i in $(seq 50); do [ -S test/sock ] && break; sleep 0.1; done
+    ichi-lock -E -A test/sock -o test/enc test/plain
+    ichi-lock -D -v test/a.lock.pub -k test/x.lock.key -o test/dec test/enc
+    cmp test/dec test/plain
+    kill "$agent"
+    wait "$agent" || true
+}
+
+@test 'agent chunk size' {
+    ichi-keygen -L -b test/a
+    head -c 3000000 /dev/urandom > test/plain
+
+    # frames are smaller than chunks: each chunk is completed by one
+    ichi-agent -k test/a.lock.key -r test/a.lock.pub -c 20 test/sock 3>&- &
+    agent=$!
+    for i in $(seq 50); do [ -S test/sock ] && break; sleep 0.1; done
+
+    ichi-lock -E -A test/sock -o test/enc test/plain
+    ichi-lock -D -k test/a.lock.key -o test/dec test/enc
+    cmp test/dec test/plain
+    ichi-lock -D -A test/sock -o test/dec test/enc
+    cmp test/dec test/plain
+
+    kill "$agent"
+    wait "$agent" || true
+}
+
+@test 'stats' {
+    ichi-keygen -L -b test/a
+    head -c 300000 /dev/urandom > test/plain
+
+    ichi-lock -E -r test/a.lock.pub --stats -o test/enc test/plain 2> test/stats
+    grep -q '"stats": "ichi-lock"' test/stats
+    grep -q '"chunks": [1-9]' test/stats
+    ICHI_STATS=1 ichi-lock -D -k test/a.lock.key -o test/dec test/enc 2> test/stats
+    cmp test/dec test/plain
+    grep -q '"slots": 1,' test/stats
+
+    ichi-lock -D -k test/a.lock.key -o test/dec test/enc 2> test/stats
+    [ ! -s test/stats ]
+}
+
+@test 'compression' {
+    ichi-keygen -L -b test/a
+    seq 1 100000 > test/plain
+    head -c 100000 /dev/urandom >> test/plain
+
+    for opts in "-z" "-z -f" "-z -j 4 -c 12"; do
+        ichi-lock -E -r test/a.lock.pub $opts -o test/enc test/plain
+        [ "$(stat -c %s test/enc)" -lt "$(stat -c %s test/plain)" ]
+        ichi-lock -D -k test/a.lock.key -j 2 -o test/dec test/enc
+        cmp test/dec test/plain
+    done
+
+    head -c 100000 /dev/urandom > test/plain
+    ichi-lock -E -z -p README.md -o test/enc test/plain
+    ichi-lock -D -p README.md -o test/dec test/enc
+    cmp test/dec test/plain
+    run ichi-lock -D -p README.md --range 0:10 test/enc
+    [ "$status" != 0 ]
+}
+
+@test 'rekey' {
+    ichi-keygen -L -b test/a
+    ichi-keygen -L -b test/b
+    ichi-keygen -L -b test/c
+    ichi-keygen -L -b test/s
+    head -c 300000 /dev/urandom > test/plain
+
+    for opts in "" "-t -f" "-z -c 12"; do
+        ichi-lock -E -k test/s.lock.key -r test/a.lock.pub -r test/b.lock.pub \
+                  $opts -o test/enc test/plain
+        ichi-lock -K -k test/b.lock.key -v test/s.lock.pub -r test/c.lock.pub \
+                  -o test/rekeyed test/enc
+        ichi-lock -D -k test/c.lock.key -o test/dec test/rekeyed
+        cmp test/dec test/plain
+        run ichi-lock -D -k test/a.lock.key test/rekeyed
+        [ "$status" != 0 ]
+        # the new key block is not from s
+        run ichi-lock -D -v test/s.lock.pub -k test/c.lock.key test/rekeyed
+        [ "$status" != 0 ]
+    done
+
+    # from a pipe, and tagged
+    cat test/enc | ichi-lock -K -k test/a.lock.key -r test/b.lock.pub -t > test/rekeyed
+    ichi-lock -D -k test/b.lock.key -o test/dec test/rekeyed
+    cmp test/dec test/plain
+
+    run ichi-lock -K -k test/c.lock.key -r test/b.lock.pub test/enc
+    [ "$status" != 0 ]
+    run ichi-lock -K -k test/a.lock.key -v test/c.lock.pub -r test/b.lock.pub test/enc
+    [ "$status" != 0 ]
+    ichi-lock -E -p README.md -o test/enc test/plain
+    run ichi-lock -K -k test/a.lock.key -r test/b.lock.pub test/enc
+    [ "$status" != 0 ]
+}
+
+@test 'tree digest' {
+    ichi-keygen -L -b test/a
+    head -c 300000 /dev/urandom > test/plain
+
+    for opts in "" "-f -j 4" "-z -c 12 -j 2"; do
+        ichi-lock -E -r test/a.lock.pub --digest tree $opts -o test/enc test/plain
+        ichi-lock -D -k test/a.lock.key -j 3 -o test/dec test/enc
+        cmp test/dec test/plain
+    done
+
+    # libichi computes the same digest, one chunk at a time
+    ichi-lock -E -r test/a.lock.pub --digest tree -o test/e1 test/plain
+    libichi_test -E -d -r test/a.lock.pub test/e2 < test/plain
+    libichi_test -D -k test/a.lock.key test/e1 > test/dec
+    cmp test/dec test/plain
+    ichi-lock -D -k test/a.lock.key -j 2 -o test/dec test/e2
+    cmp test/dec test/plain
+
+    run ichi-lock -E -r test/a.lock.pub --digest sha1 test/plain
+    [ "$status" != 0 ]
+}
@@ -60,3 +60,141 @@ setup() {
     run ichi-sign -V test/signed
     [ "$status" != 0 ]
 }
+
+@test 'verify from pipes' {
+    ichi-keygen -S -b test/a
+    head -c 200000 /dev/urandom > test/plain
+
+    ichi-sign -k test/a.sign.key -o test/signed test/plain
+    cat test/signed | ichi-sign -V -x -p test/a.sign.pub -o test/out
+    cmp test/out test/plain
+
+    ichi-sign -k test/a.sign.key -d -o test/sig test/plain
+    cat test/plain | ichi-sign -V -p test/a.sign.pub -s test/sig
+    cat test/plain | ichi-sign -V -x -p test/a.sign.pub -s test/sig -o test/out
+    cmp test/out test/plain
+
+    # nothing is written for a bad signature
+    printf 'x' | dd of=test/signed bs=1 seek=1000 conv=notrunc
+    run ichi-sign -V -x -p test/a.sign.pub -o test/out test/signed
+    [ "$status" != 0 ]
+    [ ! -s test/out ]
+}
+
+@test 'sign from pipes' {
+    ichi-keygen -S -b test/a
+    head -c 200000 /dev/urandom > test/plain
+
+    cat test/plain | ichi-sign -k test/a.sign.key -o test/signed
+    ichi-sign -V -x -p test/a.sign.pub -o test/out test/signed
+    cmp test/out test/plain
+
+    cat test/plain | ichi-sign -k test/a.sign.key -d -o test/sig
+    ichi-sign -V -p test/a.sign.pub -s test/sig test/plain
+
+    # same signature whether the input is seekable or not
+    ichi-sign -k test/a.sign.key -d -o test/sig2 test/plain
+    cmp test/sig test/sig2
+}
+
+@test 'key fingerprint' {
+    dirname=test/keyring
+    mkdir -p "$dirname"
+    for i in 1 2 3 4 5; do
+        ichi-keygen -S -b "$dirname/k$i"
+    done
+
+    ichi-sign -k "$dirname/k4.sign.key" -o test/signed README.md
+    ichi-sign -k "$dirname/k4.sign.key" -d -o test/sig README.md
+    grep -q '^key [0-9a-f]\{16\}$' test/signed
+    grep -q '^key [0-9a-f]\{16\}$' test/sig
+    ICHI_SIGN_KEYRING="$dirname" ichi-sign -V test/signed
+    ICHI_SIGN_KEYRING="$dirname" ichi-sign -V -s test/sig README.md
+
+    # signatures without a fingerprint are checked against every key
+    grep -v '^key ' test/signed > test/legacy
+    ICHI_SIGN_KEYRING="$dirname" ichi-sign -V test/legacy
+    head -c 88 test/sig > test/legacy
+    ICHI_SIGN_KEYRING="$dirname" ichi-sign -V -s test/legacy README.md
+
+    # a key with another fingerprint is not tried
+    run ichi-sign -V -p "$dirname/k1.sign.pub" test/signed
+    [ "$status" != 0 ]
+}
+
+@test 'keyring index' {
+    mkdir -p test/keyring
+    for i in 1 2 3 4 5; do
+        ichi-keygen -S -b "test/keyring/k$i"
+    done
+    ichi-sign -I test/keyring -o test/index
+
+    ichi-sign -k test/keyring/k3.sign.key -o test/signed README.md
+    ichi-sign -k test/keyring/k3.sign.key -d -o test/sig README.md
+    ICHI_SIGN_KEYRING=test/index ichi-sign -V test/signed
+    ICHI_SIGN_KEYRING=test/index ichi-sign -V -s test/sig README.md
+    head -c 88 test/sig > test/legacy
+    ICHI_SIGN_KEYRING=test/index ichi-sign -V -s test/legacy README.md
+
+    ichi-keygen -S -b test/other
+    ichi-sign -k test/other.sign.key -o test/signed README.md
+    run env ICHI_SIGN_KEYRING=test/index ichi-sign -V test/signed
+    [ "$status" != 0 ]
+
+    # truncated index
+    ichi-sign -k test/keyring/k3.sign.key -o test/signed README.md
+    head -c 100 test/index > test/bad
+    run env ICHI_SIGN_KEYRING=test/bad ichi-sign -V test/signed
+    [ "$status" != 0 ]
+}
+
+@test 'manifest' {
+    ichi-keygen -S -b test/a
+    ichi-keygen -S -b test/b
+    mkdir -p test/files
+    for i in 1 2 3 4; do
+        head -c "$((i * 30000))" /dev/urandom > "test/files/f$i"
+    done
+
+    ichi-sign -k test/a.sign.key -m -j 2 -o test/manifest test/files/*
+    ichi-sign -V -m -p test/a.sign.pub -j 2 test/manifest
+    ichi-sign -T test/manifest | grep -q '  test/files/f3$'
+
+    run ichi-sign -V -m -p test/b.sign.pub test/manifest
+    [ "$status" != 0 ]
+
+    echo x >> test/files/f2
+    run ichi-sign -V -m -p test/a.sign.pub test/manifest
+    [ "$status" != 0 ]
+}
+
+@test 'sign many files' {
+    ichi-keygen -S -b test/a
+    mkdir -p test/files
+    for i in 1 2 3; do
+        head -c "$((i * 30000))" /dev/urandom > "test/files/f$i"
+    done
+
+    find test/files -type f | ichi-sign -k test/a.sign.key -d -j 2 -l -
+    for i in 1 2 3; do
+        ichi-sign -V -p test/a.sign.pub -s "test/files/f$i.sig" "test/files/f$i"
+    done
+}
+
+@test 'bulk keygen' {
+    ichi-keygen -S -n 12 -j 3 -b test/dev
+    [ -f test/dev01.sign.key ]
+    [ -f test/dev12.sign.pub ]
+    ichi-sign -k test/dev05.sign.key -o test/signed README.md
+    ichi-sign -V -p test/dev05.sign.pub test/signed
+
+    ichi-keygen -S -n 12 -j 3 -b dev -p test/pks -s test/sks
+    [ "$(wc -l < test/pks)" = 12 ]
+    ichi-sign -I test/pks -o test/index
+    grep '^dev07 ' test/sks | cut -d' ' -f2 > test/dev07.key
+    ichi-sign -k test/dev07.key -o test/signed README.md
+    ICHI_SIGN_KEYRING=test/index ichi-sign -V test/signed
+
+    run ichi-keygen -S -n 3 -p test/pks
+    [ "$status" != 0 ]
+}
@@ -1,8 +1,14 @@
+#define _GNU_SOURCE // copy_file_range
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/random.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <errno.h>
+#include "utils.h"
+#include "stats.h"
 #include "monocypher/monocypher.h"
 
 void _free(void* buf, int bufsize)
@@ -22,15 +28,279 @@ int _fclose(FILE **fp)
 
 int _read(FILE* fp, uint8_t *buf, size_t bufsize)
 {
-    return fread(buf, 1, bufsize, fp) == bufsize ? 0 : -1;
+    struct st_timer t;
+    st_start(ST_IO, &t);
+    size_t n = fread(buf, 1, bufsize, fp);
+    st_stop(ST_IO, &t);
+    st_add(ST_READS, 1);
+    st_add(ST_BYTES_IN, n);
+    return n == bufsize ? 0 : -1;
 }
 
 int _write(FILE* fp, const uint8_t *buf, size_t bufsize)
 {
-    return (fwrite(buf, 1, bufsize, fp) == bufsize && errno == 0) ? 0 : -1;
+    struct st_timer t;
+    st_start(ST_IO, &t);
+    size_t n = fwrite(buf, 1, bufsize, fp);
+    st_stop(ST_IO, &t);
+    st_add(ST_WRITES, 1);
+    st_add(ST_BYTES_OUT, n);
+    return (n == bufsize && errno == 0) ? 0 : -1;
 }
 
+// getrandom() may return less than asked for past 256 bytes
 int _random(uint8_t *buf, size_t bufsize)
 {
-    return getrandom(buf, bufsize, 0) == -1 ? -1 : 0;
+    while (bufsize > 0) {
+        ssize_t n = getrandom(buf, bufsize, 0);
+        if (n < 0 && errno == EINTR) {
+            errno = 0;
+            continue;
+        }
+        if (n <= 0)
+            return -1;
+        buf     += n;
+        bufsize -= (size_t) n;
+    }
+    return 0;
+}
+
+// mapped pages are given back once this much has been read past them,
+// so that the resident size stays flat on big inputs
+#define IN_DROP_SIZE (2 * 1024 * 1024)
+
+static int in_setup(struct input *in, FILE *fp, int mappable)
+{
+    struct stat st;
+    int saved_errno = errno;
+    memset(in, 0, sizeof(*in));
+    in->fp    = fp;
+    in->start = ftello(fp);
+    in->size  = -1;
+
+    // st_size is 0 for some regular files (/proc), read those instead
+    if (mappable && in->start >= 0
+            && fstat(fileno(fp), &st) == 0
+            && S_ISREG(st.st_mode)
+            && st.st_size > in->start
+            && (uint64_t) st.st_size <= SIZE_MAX) {
+        void *map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE,
+                         fileno(fp), 0);
+        if (map != MAP_FAILED) {
+            madvise(map, (size_t) st.st_size, MADV_SEQUENTIAL);
+            in->map      = map;
+            in->map_size = (size_t) st.st_size;
+            in->pos      = (size_t) in->start;
+            in->size     = st.st_size - in->start;
+            return 0;
+        }
+    }
+    // not a mappable file, which is fine
+    errno = saved_errno;
+    if (in->start < 0)
+        in->start = 0;
+
+    in->buf = malloc(IN_BUF_SIZE);
+    if (in->buf == NULL)
+        return -1;
+    st_buffers(IN_BUF_SIZE);
+    return 0;
+}
+
+int in_open(struct input *in, FILE *fp)
+{
+    return in_setup(in, fp, 1);
+}
+
+int in_open_buffered(struct input *in, FILE *fp)
+{
+    return in_setup(in, fp, 0);
+}
+
+int in_next(struct input *in, const uint8_t **data, size_t *size, size_t max)
+{
+    if (in->map != NULL) {
+        size_t n = in->map_size - in->pos;
+        *data = in->map + in->pos;
+        *size = n < max ? n : max;
+        in->pos += *size;
+        st_add(ST_BYTES_IN, *size);
+
+        // never past the data just returned, which may be bigger than
+        // IN_DROP_SIZE
+        long page = sysconf(_SC_PAGESIZE);
+        if (page > 0 && in->pos - in->dropped > 2 * IN_DROP_SIZE) {
+            size_t end = in->pos - IN_DROP_SIZE,
+                   ret = in->pos - *size;
+            end = (end < ret ? end : ret) / page * page;
+            if (end > in->dropped) {
+                madvise(in->map + in->dropped, end - in->dropped, MADV_DONTNEED);
+                in->dropped = end;
+            }
+        }
+        return 0;
+    }
+
+    if (in->pos == in->buf_size) {
+        struct st_timer t;
+        st_start(ST_IO, &t);
+        in->buf_size = fread(in->buf, 1, IN_BUF_SIZE, in->fp);
+        st_stop(ST_IO, &t);
+        st_add(ST_READS, 1);
+        in->pos = 0;
+        if (ferror(in->fp))
+            return -1;
+    }
+    size_t n = in->buf_size - in->pos;
+    *data = in->buf + in->pos;
+    *size = n < max ? n : max;
+    in->pos += *size;
+    st_add(ST_BYTES_IN, *size);
+    return 0;
+}
+
+int in_read(struct input *in, uint8_t *buf, size_t *size, size_t max)
+{
+    const uint8_t *data;
+    size_t n;
+    *size = 0;
+    while (*size < max) {
+        if (in_next(in, &data, &n, max - *size) != 0)
+            return -1;
+        if (n == 0)
+            break;
+        memcpy(buf + *size, data, n);
+        *size += n;
+    }
+    return 0;
+}
+
+int in_rewind(struct input *in)
+{
+    if (in->map != NULL) {
+        in->pos     = (size_t) in->start;
+        in->dropped = 0;
+        return 0;
+    }
+    if (fseeko(in->fp, in->start, SEEK_SET) != 0)
+        return -1;
+    in->pos = in->buf_size = 0;
+    return 0;
+}
+
+void in_close(struct input *in)
+{
+    if (in->map != NULL)
+        munmap(in->map, in->map_size);
+    if (in->buf != NULL)
+        st_buffers(-IN_BUF_SIZE);
+    _free(in->buf, IN_BUF_SIZE);
+    in->map = in->buf = NULL;
+}
+
+int out_open(struct output *out, FILE *fp)
+{
+    out->niov = 0;
+    out->fd   = fileno(fp);
+    return out->fd < 0 || fflush(fp) != 0 ? -1 : 0;
+}
+
+int out_queue(struct output *out, const uint8_t *buf, size_t size)
+{
+    if (size == 0)
+        return 0;
+    if (out->niov == OUT_IOV_MAX && out_flush(out) != 0)
+        return -1;
+    out->iov[out->niov].iov_base = (void *) buf;
+    out->iov[out->niov].iov_len  = size;
+    out->niov++;
+    return 0;
+}
+
+int out_flush(struct output *out)
+{
+    struct iovec *iov = out->iov;
+    int niov = out->niov;
+    out->niov = 0;
+    while (niov > 0) {
+        struct st_timer t;
+        st_start(ST_IO, &t);
+        ssize_t n = writev(out->fd, iov, niov);
+        st_stop(ST_IO, &t);
+        st_add(ST_WRITES, 1);
+        if (n > 0)
+            st_add(ST_BYTES_OUT, (uint64_t) n);
+        if (n < 0 && errno == EINTR) {
+            errno = 0;
+            continue;
+        }
+        if (n <= 0)
+            return -1;
+        // partial write: skip what went through
+        while (niov > 0 && (size_t) n >= iov->iov_len) {
+            n -= iov->iov_len;
+            iov++;
+            niov--;
+        }
+        if (niov > 0) {
+            iov->iov_base = (uint8_t *) iov->iov_base + n;
+            iov->iov_len -= n;
+        }
+    }
+    return 0;
+}
+
+// Anything but these means copy_file_range() failed, rather than that
+// it cannot copy between the two files.
+static int copy_unsupported(int err)
+{
+    return err == EXDEV || err == EINVAL || err == ENOSYS
+        || err == EOPNOTSUPP || err == EBADF;
+}
+
+int _copy(FILE *in, FILE *out)
+{
+    int rv = -1;
+    struct input src = { .map = NULL, .buf = NULL };
+    struct output dst;
+    const uint8_t *data;
+    size_t size;
+    off_t pos = ftello(in);
+
+    if (out_open(&dst, out) != 0)
+        return -1;
+    if (pos >= 0) {
+        ssize_t n;
+        do {
+            struct st_timer t;
+            st_start(ST_IO, &t);
+            n = copy_file_range(fileno(in), &pos, dst.fd, NULL, 1 << 30, 0);
+            st_stop(ST_IO, &t);
+            if (n > 0) {
+                st_add(ST_BYTES_IN,  n);
+                st_add(ST_BYTES_OUT, n);
+            }
+        } while (n > 0);
+        if (n == 0)
+            return 0;
+        if (!copy_unsupported(errno) || fseeko(in, pos, SEEK_SET) != 0)
+            return -1;
+    }
+    errno = 0;
+
+    if (in_open(&src, in) != 0)
+        goto error;
+    while (1) {
+        if (in_next(&src, &data, &size, IN_BUF_SIZE) != 0)
+            goto error;
+        if (size == 0)
+            break;
+        if (out_queue(&dst, data, size) != 0 || out_flush(&dst) != 0)
+            goto error;
+    }
+    rv = 0;
+
+error:
+    in_close(&src);
+    return rv;
 }
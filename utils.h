@@ -5,6 +5,8 @@
 #include <stdint.h>
 #include <unistd.h>
 #include <errno.h>
+#include <sys/types.h>
+#include <sys/uio.h>
 
 #define _err(name, ...) do {\
     fprintf(stderr, "%s: ", name);\
@@ -21,4 +23,55 @@ int _fclose(FILE **fp);
 int _read(FILE* fp, uint8_t *buf, size_t bufsize);
 int _write(FILE* fp, const uint8_t *buf, size_t bufsize);
 int _random(uint8_t *buf, size_t bufsize);
+// Copies the rest of in to out.  Between regular files the kernel does
+// it (copy_file_range, which shares extents on filesystems with
+// reflinks), anything else goes through in_next() and out_queue().
+int _copy(FILE *in, FILE *out);
+
+// Sequential reader over a FILE, from where it stands when opened.
+// Regular files are mapped and handed out in place; anything else is
+// read through a buffer of IN_BUF_SIZE bytes.  Once opened, read the
+// FILE only through these until in_close().
+#define IN_BUF_SIZE (1024 * 1024)
+
+struct input {
+    FILE    *fp;
+    uint8_t *map;      // whole file, NULL if not mapped
+    size_t   map_size;
+    size_t   dropped;  // mapped bytes handed back to the kernel
+    uint8_t *buf;
+    size_t   buf_size; // bytes held in buf
+    size_t   pos;      // next byte in map or buf
+    off_t    start;    // FILE position when opened
+    off_t    size;     // bytes left when opened, -1 if unknown
+};
+
+int  in_open(struct input *in, FILE *fp);
+// Never maps: every byte handed out is a private copy, which does not
+// change if the file is rewritten, and a truncated file reads short
+// instead of raising SIGBUS.
+int  in_open_buffered(struct input *in, FILE *fp);
+// Points *data at the next *size bytes (at most max, 0 at EOF).
+int  in_next(struct input *in, const uint8_t **data, size_t *size, size_t max);
+// Copies the next bytes into buf, *size < max only at EOF.
+int  in_read(struct input *in, uint8_t *buf, size_t *size, size_t max);
+// Back to the position in_open() started from, if the FILE is seekable.
+int  in_rewind(struct input *in);
+void in_close(struct input *in);
+
+// Vectored writer on the file descriptor of a FILE.  Buffers are queued
+// by pointer and must stay valid until the next out_flush().  The FILE
+// is flushed by out_open(), so that what stdio holds comes first.
+#define OUT_IOV_MAX (64)
+
+struct output {
+    int          fd;
+    struct iovec iov[OUT_IOV_MAX];
+    int          niov;
+};
+
+int out_open(struct output *out, FILE *fp);
+// Queues buf, writing out the queue first if it is full.
+int out_queue(struct output *out, const uint8_t *buf, size_t size);
+int out_flush(struct output *out);
 #endif